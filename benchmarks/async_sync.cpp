@@ -0,0 +1,130 @@
+#include <runtime/thread_pool.h>
+#include <runtime/async_sync.h>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
+using Clock = std::chrono::high_resolution_clock;
+
+long long ms_since(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+}
+
+// Short critical sections hammered from every worker
+void benchmark_contended_counter() {
+    std::cout << "=== Contended Critical Section ===\n";
+    std::cout << "N tasks, each a short update of shared state under one lock\n\n";
+
+    std::cout << std::left << std::setw(12) << "Tasks"
+              << std::setw(22) << "std::mutex (ms)"
+              << std::setw(22) << "AsyncMutex (ms)"
+              << "\n";
+    std::cout << std::string(56, '-') << "\n";
+
+    runtime::ThreadPool pool;
+    for (size_t tasks : {10000, 100000, 500000}) {
+        uint64_t state = 1;
+
+        std::mutex mutex;
+        auto start = Clock::now();
+        for (size_t i = 0; i < tasks; ++i) {
+            pool.submit([&]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (int k = 0; k < 50; ++k) state = state * 6364136223846793005ULL + 1;
+            });
+        }
+        pool.wait();
+        auto std_ms = ms_since(start, Clock::now());
+
+        runtime::AsyncMutex async_mutex(pool);
+        start = Clock::now();
+        for (size_t i = 0; i < tasks; ++i) {
+            pool.submit([&]() {
+                async_mutex.run_locked([&]() {
+                    for (int k = 0; k < 50; ++k) state = state * 6364136223846793005ULL + 1;
+                });
+            });
+        }
+        pool.wait();
+        auto async_ms = ms_since(start, Clock::now());
+
+        std::cout << std::setw(12) << tasks
+                  << std::setw(22) << std_ms
+                  << std::setw(22) << async_ms << "\n";
+    }
+    std::cout << "\n";
+}
+
+// A lock held across a slow step (I/O stand-in) mixed with unrelated work:
+// std::mutex parks workers in the kernel, AsyncMutex queues continuations
+void benchmark_slow_holder() {
+    std::cout << "=== Slow Lock Holder + Unrelated Work ===\n";
+    std::cout << "1000 lockers (100 μs inside the lock) + 200k unrelated tasks\n\n";
+
+    std::cout << std::left << std::setw(16) << "Lock"
+              << std::setw(22) << "Unrelated done (ms)"
+              << std::setw(18) << "All done (ms)"
+              << "\n";
+    std::cout << std::string(56, '-') << "\n";
+
+    const size_t lockers = 1000;
+    const size_t unrelated = 200000;
+    runtime::ThreadPool pool;
+
+    auto run = [&](const std::string& name, auto&& submit_locker) {
+        std::atomic<size_t> unrelated_done{0};
+        Clock::time_point unrelated_end;
+        auto start = Clock::now();
+        for (size_t i = 0; i < lockers; ++i) {
+            submit_locker();
+        }
+        for (size_t i = 0; i < unrelated; ++i) {
+            pool.submit([&]() {
+                if (unrelated_done.fetch_add(1) + 1 == unrelated) {
+                    unrelated_end = Clock::now();
+                }
+            });
+        }
+        pool.wait();
+        auto end = Clock::now();
+        std::cout << std::setw(16) << name
+                  << std::setw(22) << ms_since(start, unrelated_end)
+                  << std::setw(18) << ms_since(start, end)
+                  << "\n";
+    };
+
+    std::mutex mutex;
+    run("std::mutex", [&]() {
+        pool.submit([&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        });
+    });
+
+    runtime::AsyncMutex async_mutex(pool);
+    run("AsyncMutex", [&]() {
+        pool.submit([&]() {
+            async_mutex.run_locked([]() {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            });
+        });
+    });
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << "\n╔════════════════════════════════════════════════════════╗\n";
+    std::cout << "║            Async Synchronisation Benchmarks            ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════╝\n\n";
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+
+    benchmark_contended_counter();
+    benchmark_slow_holder();
+
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <runtime/thread_pool.h>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <array>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+
+// Producers outrun the workers: without a cap the backlog (and memory)
+// grows with the surge; with one, producers are parked and it stays bounded
+void benchmark_producer_surge() {
+    std::cout << "=== Producer Surge: 4 producers x 250k tasks ===\n";
+    std::cout << "Each task carries a 64-byte payload (heap-allocated std::function)\n\n";
+
+    std::cout << std::left << std::setw(20) << "max_pending_tasks"
+              << std::setw(18) << "Peak backlog"
+              << std::setw(16) << "Backlog (MB)"
+              << std::setw(16) << "Time (ms)"
+              << std::setw(16) << "Producer waits"
+              << "\n";
+    std::cout << std::string(86, '-') << "\n";
+
+    const size_t producers = 4;
+    const size_t per_producer = 250000;
+
+    for (size_t cap : {size_t(0), size_t(65536), size_t(4096), size_t(256)}) {
+        runtime::config::ThreadPoolOptions options;
+        options.max_pending_tasks = cap;
+        runtime::ThreadPool pool(options);
+        std::atomic<uint64_t> sink{0};
+        std::atomic<bool> done{false};
+
+        // Sample submitted - executed while the surge runs
+        uint64_t peak = 0;
+        std::thread sampler([&]() {
+            while (!done.load(std::memory_order_acquire)) {
+                uint64_t submitted = pool.stats().tasks_submitted.load();
+                uint64_t executed = pool.stats().tasks_executed.load();
+                if (submitted > executed) peak = std::max(peak, submitted - executed);
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        });
+
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> threads;
+        for (size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p]() {
+                for (size_t i = 0; i < per_producer; ++i) {
+                    std::array<uint64_t, 8> payload{};
+                    payload[0] = p * per_producer + i;
+                    pool.submit([&sink, payload]() {
+                        uint64_t x = payload[0];
+                        for (int k = 0; k < 100; ++k) x = x * 6364136223846793005ULL + 1;
+                        sink.fetch_add(x & 1, std::memory_order_relaxed);
+                    });
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+        pool.wait();
+        auto end = std::chrono::high_resolution_clock::now();
+        done = true;
+        sampler.join();
+
+        // std::function + heap-stored lambda + queue slot, roughly
+        double backlog_mb = static_cast<double>(peak) * (sizeof(runtime::Task) + 80) / (1024.0 * 1024.0);
+        std::cout << std::setw(20) << (cap == 0 ? std::string("unbounded") : std::to_string(cap))
+                  << std::setw(18) << peak
+                  << std::setw(16) << std::fixed << std::setprecision(1) << backlog_mb
+                  << std::setw(16) << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+                  << std::setw(16) << pool.stats().producer_waits.load()
+                  << "\n";
+    }
+    std::cout << "\n";
+}
+
+// Cost of admission on the fast path (pool never full)
+void benchmark_submit_overhead() {
+    std::cout << "=== Submit Overhead When Not Full ===\n";
+    std::cout << "1M empty tasks from one producer\n\n";
+
+    std::cout << std::left << std::setw(20) << "Variant"
+              << std::setw(16) << "ns / submit"
+              << "\n";
+    std::cout << std::string(36, '-') << "\n";
+
+    const size_t tasks = 1000000;
+    auto run = [&](const std::string& name, size_t cap, bool use_try) {
+        runtime::config::ThreadPoolOptions options;
+        options.max_pending_tasks = cap;
+        runtime::ThreadPool pool(options);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < tasks; ++i) {
+            if (use_try) {
+                pool.try_submit([]() {});
+            } else {
+                pool.submit([]() {});
+            }
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        pool.wait();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / tasks;
+        std::cout << std::setw(20) << name << std::setw(16) << std::fixed << std::setprecision(1) << ns << "\n";
+    };
+
+    run("submit, no cap", 0, false);
+    run("submit, cap 2M", 2000000, false);
+    run("try_submit, cap 2M", 2000000, true);
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << "\n╔════════════════════════════════════════════════════════╗\n";
+    std::cout << "║             Backpressure Benchmark Suite              ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════╝\n\n";
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+
+    benchmark_producer_surge();
+    benchmark_submit_overhead();
+
+    return 0;
+}
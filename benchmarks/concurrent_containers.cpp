@@ -0,0 +1,194 @@
+#include <runtime/thread_pool.h>
+#include <runtime/parallel_for.h>
+#include <runtime/concurrent_hash_map.h>
+#include <runtime/concurrent_vector.h>
+#include <runtime/parallel_reduce.h>
+#include <runtime/parallel_histogram.h>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <mutex>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// Keys drawn uniformly, or with a heavy power-law skew towards small keys
+std::vector<uint64_t> make_keys(size_t n, uint64_t distinct, bool skewed) {
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<uint64_t> keys(n);
+    for (auto& k : keys) {
+        double u = unit(rng);
+        if (skewed) u = std::pow(u, 6.0);
+        k = std::min<uint64_t>(distinct - 1, static_cast<uint64_t>(u * distinct));
+    }
+    return keys;
+}
+
+long long elapsed_ms(std::chrono::high_resolution_clock::time_point since) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - since).count();
+}
+
+// Group-by sum: mutex-protected std::unordered_map vs ConcurrentHashMap
+void benchmark_group_by() {
+    std::cout << "=== Group-By Aggregation Benchmark ===\n";
+    std::cout << "4M rows, 64K distinct keys, sum per key\n\n";
+
+    const size_t rows = 1 << 22;
+    const uint64_t distinct = 1 << 16;
+
+    for (bool skewed : {false, true}) {
+        std::vector<uint64_t> keys = make_keys(rows, distinct, skewed);
+        std::cout << (skewed ? "Skewed keys\n" : "Uniform keys\n");
+        std::cout << std::left << std::setw(10) << "Threads"
+                  << std::setw(22) << "mutex+unordered (ms)"
+                  << std::setw(22) << "ConcurrentHashMap (ms)"
+                  << "\n";
+        std::cout << std::string(54, '-') << "\n";
+
+        for (size_t threads = 1; threads <= std::max(1u, std::thread::hardware_concurrency()); threads *= 2) {
+            runtime::config::ThreadPoolOptions options;
+            options.threads = threads;
+            runtime::ThreadPool pool(options);
+
+            std::unordered_map<uint64_t, uint64_t> locked_map;
+            std::mutex map_mutex;
+            auto start = std::chrono::high_resolution_clock::now();
+            runtime::parallel_for_chunked(pool, size_t(0), rows, [&](size_t first, size_t last) {
+                for (size_t i = first; i < last; ++i) {
+                    std::lock_guard<std::mutex> lock(map_mutex);
+                    locked_map[keys[i]] += i;
+                }
+            }, 1 << 14);
+            long long locked_ms = elapsed_ms(start);
+
+            runtime::ConcurrentHashMap<uint64_t, uint64_t> map;
+            start = std::chrono::high_resolution_clock::now();
+            runtime::parallel_for_chunked(pool, size_t(0), rows, [&](size_t first, size_t last) {
+                for (size_t i = first; i < last; ++i) {
+                    map.insert_or_update(keys[i], i, [i](uint64_t& sum) { sum += i; });
+                }
+            }, 1 << 14);
+            long long concurrent_ms = elapsed_ms(start);
+
+            std::cout << std::setw(10) << threads
+                      << std::setw(22) << locked_ms
+                      << std::setw(22) << concurrent_ms
+                      << (map.size() == locked_map.size() ? "" : "  SIZE MISMATCH") << "\n";
+        }
+        std::cout << "\n";
+    }
+}
+
+// Tasks appending filtered results: mutex-protected std::vector vs ConcurrentVector
+void benchmark_result_collection() {
+    std::cout << "=== Result Collection Benchmark ===\n";
+    std::cout << "4M candidates, ~50% kept, appended from parallel_for\n\n";
+
+    const size_t n = 1 << 22;
+    std::cout << std::left << std::setw(10) << "Threads"
+              << std::setw(22) << "mutex+vector (ms)"
+              << std::setw(22) << "ConcurrentVector (ms)"
+              << "\n";
+    std::cout << std::string(54, '-') << "\n";
+
+    auto keep = [](size_t i) { return ((i * 2654435761u) >> 7) & 1; };
+
+    for (size_t threads = 1; threads <= std::max(1u, std::thread::hardware_concurrency()); threads *= 2) {
+        runtime::config::ThreadPoolOptions options;
+        options.threads = threads;
+        runtime::ThreadPool pool(options);
+
+        std::vector<size_t> locked;
+        std::mutex locked_mutex;
+        auto start = std::chrono::high_resolution_clock::now();
+        runtime::parallel_for_chunked(pool, size_t(0), n, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                if (keep(i)) {
+                    std::lock_guard<std::mutex> lock(locked_mutex);
+                    locked.push_back(i);
+                }
+            }
+        }, 1 << 14);
+        long long locked_ms = elapsed_ms(start);
+
+        runtime::ConcurrentVector<size_t> collected;
+        start = std::chrono::high_resolution_clock::now();
+        runtime::parallel_for_chunked(pool, size_t(0), n, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                if (keep(i)) collected.push_back(i);
+            }
+        }, 1 << 14);
+        long long concurrent_ms = elapsed_ms(start);
+
+        std::cout << std::setw(10) << threads
+                  << std::setw(22) << locked_ms
+                  << std::setw(22) << concurrent_ms
+                  << (collected.size() == locked.size() ? "" : "  SIZE MISMATCH") << "\n";
+    }
+    std::cout << "\n";
+}
+
+// parallel_reduce with a std::vector accumulator vs privatised histogram bins
+void benchmark_histogram() {
+    std::cout << "=== Histogram Benchmark ===\n";
+    std::cout << "4M keys; vector-valued parallel_reduce vs parallel_histogram\n\n";
+
+    runtime::ThreadPool pool;
+    const size_t n = 1 << 22;
+
+    std::cout << std::left << std::setw(10) << "Bins"
+              << std::setw(22) << "reduce<vector> (ms)"
+              << std::setw(22) << "parallel_histogram (ms)"
+              << "\n";
+    std::cout << std::string(54, '-') << "\n";
+
+    for (size_t bins : {256, 4096, 65536}) {
+        std::vector<uint64_t> keys = make_keys(n, bins, false);
+        const size_t chunk = 1 << 14;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<size_t> reduced = runtime::parallel_reduce_chunked(pool, size_t(0), n,
+            std::vector<size_t>(bins, 0),
+            [&](size_t first, size_t last) {
+                std::vector<size_t> partial(bins, 0);
+                for (size_t i = first; i < last; ++i) partial[keys[i]]++;
+                return partial;
+            },
+            [](std::vector<size_t> acc, const std::vector<size_t>& partial) {
+                for (size_t b = 0; b < acc.size(); ++b) acc[b] += partial[b];
+                return acc;
+            }, chunk);
+        long long reduce_ms = elapsed_ms(start);
+
+        start = std::chrono::high_resolution_clock::now();
+        std::vector<size_t> hist = runtime::parallel_histogram(pool,
+            runtime::blocked_range<size_t>(0, n, chunk), bins,
+            [&](size_t i) { return keys[i]; });
+        long long histogram_ms = elapsed_ms(start);
+
+        std::cout << std::setw(10) << bins
+                  << std::setw(22) << reduce_ms
+                  << std::setw(22) << histogram_ms
+                  << (hist == reduced ? "" : "  MISMATCH") << "\n";
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << "\n╔════════════════════════════════════════════════════════╗\n";
+    std::cout << "║          Concurrent Containers Benchmark Suite        ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════╝\n\n";
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+
+    benchmark_group_by();
+    benchmark_result_collection();
+    benchmark_histogram();
+
+    return 0;
+}
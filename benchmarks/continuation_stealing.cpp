@@ -0,0 +1,278 @@
+#include <runtime/thread_pool.h>
+#include <runtime/fork_join.h>
+#include <runtime/continuation.h>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+
+using Clock = std::chrono::high_resolution_clock;
+
+// Work waiting in queues: entered when a branch is left queued (the forked
+// closure under child stealing, the parent's continuation under
+// continuation stealing), left when it starts running
+struct QueueMeter {
+    std::atomic<long> current{0};
+    std::atomic<long> peak{0};
+
+    void enter() {
+        long now = current.fetch_add(1, std::memory_order_relaxed) + 1;
+        long seen = peak.load(std::memory_order_relaxed);
+        while (now > seen && !peak.compare_exchange_weak(seen, now, std::memory_order_relaxed)) {
+        }
+    }
+    void leave() { current.fetch_sub(1, std::memory_order_relaxed); }
+};
+
+QueueMeter meter;
+
+long long fib_serial(int n) {
+    return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+template<bool Measure>
+long long fib_child_stealing(runtime::ThreadPool& pool, int n) {
+    if (n < 2) return n;
+    long long a = 0, b = 0;
+    if (Measure) meter.enter();
+    runtime::fork_join(pool,
+        [&]() { a = fib_child_stealing<Measure>(pool, n - 1); },
+        [&]() {
+            if (Measure) meter.leave();
+            b = fib_child_stealing<Measure>(pool, n - 2);
+        });
+    return a + b;
+}
+
+template<bool Measure>
+long long fib_continuation_stealing(runtime::ThreadPool& pool, int n) {
+    if (n < 2) return n;
+    long long a = 0, b = 0;
+    if (Measure) meter.enter();
+    runtime::continuation_fork_join(pool,
+        [&]() { a = fib_continuation_stealing<Measure>(pool, n - 1); },
+        [&]() {
+            if (Measure) meter.leave();
+            b = fib_continuation_stealing<Measure>(pool, n - 2);
+        });
+    return a + b;
+}
+
+// Unbalanced Tree Search, binomial tree: the root has root_children
+// children; every other node has m children with probability q, else none.
+// A node's children and work come from a hash of its id, so every run
+// walks the same tree.
+namespace uts {
+
+const int root_children = 2000;
+const int m = 8;
+const double q = 0.124;  // q * m just under 1: deep, very uneven subtrees
+const int work_rounds = 64;
+
+uint64_t mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Per-node work, in place of UTS's SHA-1
+uint64_t visit(uint64_t id) {
+    uint64_t h = id;
+    for (int i = 0; i < work_rounds; ++i) h = mix(h);
+    return h;
+}
+
+int children(uint64_t hash, bool root) {
+    if (root) return root_children;
+    return static_cast<double>(hash >> 11) * 0x1.0p-53 < q ? m : 0;
+}
+
+uint64_t child_id(uint64_t id, int i) {
+    return mix(id * m + static_cast<uint64_t>(i) + 1);
+}
+
+uint64_t count_serial(uint64_t id, bool root) {
+    int n = children(visit(id), root);
+    uint64_t nodes = 1;
+    for (int i = 0; i < n; ++i) nodes += count_serial(child_id(id, i), false);
+    return nodes;
+}
+
+std::atomic<uint64_t> nodes{0};
+
+// Child stealing: every child is a closure on the worker's queue (one
+// allocation each), joined by helping with queued work
+template<bool Measure>
+void walk_child_stealing(runtime::ThreadPool& pool, uint64_t id, bool root) {
+    nodes.fetch_add(1, std::memory_order_relaxed);
+    int n = children(visit(id), root);
+    std::atomic<int> pending{n};
+    for (int i = 0; i < n; ++i) {
+        if (Measure) meter.enter();
+        pool.submit_local([&pool, &pending, child = child_id(id, i)]() {
+            if (Measure) meter.leave();
+            walk_child_stealing<Measure>(pool, child, false);
+            pending.fetch_sub(1, std::memory_order_release);
+        });
+    }
+    while (pending.load(std::memory_order_acquire) != 0) {
+        if (!pool.run_pending_task()) std::this_thread::yield();
+    }
+}
+
+// Continuation stealing: each child runs at once; only the loop itself
+// (the parent's continuation) waits in a queue
+template<bool Measure>
+void walk_continuation_stealing(runtime::ThreadPool& pool, uint64_t id, bool root) {
+    nodes.fetch_add(1, std::memory_order_relaxed);
+    int n = children(visit(id), root);
+    runtime::SpawnScope scope(pool);
+    for (int i = 0; i < n; ++i) {
+        if (Measure) meter.enter();
+        scope.spawn([&pool, child = child_id(id, i)]() {
+            walk_continuation_stealing<Measure>(pool, child, false);
+        });
+        if (Measure) meter.leave();
+    }
+    scope.sync();
+}
+
+} // namespace uts
+
+void print_header() {
+    std::cout << std::left << std::setw(26) << "Variant"
+              << std::setw(12) << "Time (ms)"
+              << std::setw(12) << "ns/spawn"
+              << std::setw(14) << "Peak queued"
+              << std::setw(16) << "Stacks mapped"
+              << std::setw(10) << "Stolen"
+              << "\n";
+    std::cout << std::string(90, '-') << "\n";
+}
+
+struct Row {
+    double ms;
+    uint64_t spawns;
+    long peak;
+    uint64_t stacks;
+    uint64_t stolen;
+    bool correct;
+};
+
+void print_row(const std::string& name, const Row& row) {
+    std::cout << std::setw(26) << name
+              << std::setw(12) << std::fixed << std::setprecision(1) << row.ms
+              << std::setw(12) << row.ms * 1e6 / static_cast<double>(row.spawns)
+              << std::setw(14) << row.peak
+              << std::setw(16) << row.stacks
+              << std::setw(10) << row.stolen
+              << (row.correct ? "" : "  WRONG RESULT") << "\n";
+}
+
+// Time timed(pool) (which checks its result) in a fresh pool, then run the
+// instrumented version for the peak
+template<typename Timed, typename Measured>
+Row run(Timed timed, Measured measured, bool continuation) {
+    Row row{};
+    {
+        runtime::ThreadPool pool;
+        auto start = Clock::now();
+        row.correct = timed(pool);
+        row.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        row.stacks = pool.stats().fiber_stacks_mapped.load();
+        row.stolen = continuation ? pool.stats().continuations_stolen.load()
+                                  : pool.stats().tasks_stolen.load();
+    }
+    {
+        runtime::ThreadPool pool;
+        meter.current = 0;
+        meter.peak = 0;
+        measured(pool);
+        row.peak = meter.peak.load();
+    }
+    return row;
+}
+
+void benchmark_fib() {
+    const int n = 30;
+    std::cout << "=== Recursive Fibonacci: fib(" << n << "), every call forks ===\n\n";
+    print_header();
+
+    long long expected = fib_serial(n);
+    uint64_t spawns = static_cast<uint64_t>(fib_serial(n + 1) - 1);
+    Row child = run(
+        [&](runtime::ThreadPool& pool) {
+            return pool.submit_task([&]() { return fib_child_stealing<false>(pool, n); }).get() == expected;
+        },
+        [&](runtime::ThreadPool& pool) {
+            pool.submit_task([&]() { return fib_child_stealing<true>(pool, n); }).get();
+        },
+        false);
+    child.spawns = spawns;
+    print_row("child stealing", child);
+
+    Row continuation = run(
+        [&](runtime::ThreadPool& pool) {
+            return runtime::spawn_root(pool, [&]() { return fib_continuation_stealing<false>(pool, n); }) == expected;
+        },
+        [&](runtime::ThreadPool& pool) {
+            runtime::spawn_root(pool, [&]() { return fib_continuation_stealing<true>(pool, n); });
+        },
+        true);
+    continuation.spawns = spawns;
+    print_row("continuation stealing", continuation);
+    std::cout << "\n";
+}
+
+void benchmark_uts() {
+    std::cout << "=== UTS: binomial tree, " << uts::root_children << " root children, m = "
+              << uts::m << ", q = " << std::setprecision(3) << uts::q << " ===\n\n";
+    uint64_t expected = uts::count_serial(1, true);
+    std::cout << "Tree nodes: " << expected << "\n\n";
+    print_header();
+
+    Row child = run(
+        [&](runtime::ThreadPool& pool) {
+            uts::nodes = 0;
+            pool.submit_task([&]() { uts::walk_child_stealing<false>(pool, 1, true); }).get();
+            return uts::nodes.load() == expected;
+        },
+        [&](runtime::ThreadPool& pool) {
+            pool.submit_task([&]() { uts::walk_child_stealing<true>(pool, 1, true); }).get();
+        },
+        false);
+    child.spawns = expected - 1;
+    print_row("child stealing", child);
+
+    Row continuation = run(
+        [&](runtime::ThreadPool& pool) {
+            uts::nodes = 0;
+            runtime::spawn_root(pool, [&]() { uts::walk_continuation_stealing<false>(pool, 1, true); });
+            return uts::nodes.load() == expected;
+        },
+        [&](runtime::ThreadPool& pool) {
+            runtime::spawn_root(pool, [&]() { uts::walk_continuation_stealing<true>(pool, 1, true); });
+        },
+        true);
+    continuation.spawns = expected - 1;
+    print_row("continuation stealing", continuation);
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << "\n╔════════════════════════════════════════════════════════╗\n";
+    std::cout << "║       Continuation Stealing Benchmark Suite            ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════╝\n\n";
+    std::cout << "Hardware threads (= workers): " << std::thread::hardware_concurrency() << "\n";
+    std::cout << "Peak queued: most branches waiting in queues at once\n\n";
+
+    benchmark_fib();
+    benchmark_uts();
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <runtime/distributed.h>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <thread>
+#include <future>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using Clock = std::chrono::high_resolution_clock;
+
+enum TaskId : uint32_t {
+    Spin = 1,   // CPU-bound
+    Sleep = 2   // waits on something outside the CPU
+};
+
+void register_tasks(runtime::DistributedRegistry& registry) {
+    registry.add<long long, int>(Spin, [](int micros) {
+        auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(micros);
+        long long spins = 0;
+        while (std::chrono::steady_clock::now() < end) ++spins;
+        return spins;
+    });
+    registry.add<void, int>(Sleep, [](int micros) {
+        std::this_thread::sleep_for(std::chrono::microseconds(micros));
+    });
+}
+
+struct Child {
+    pid_t pid;
+    uint16_t port;
+    int control_fd;
+};
+
+// One single-worker node per process; children serve until their control pipe closes
+Child fork_node() {
+    int report[2];
+    int control[2];
+    if (pipe(report) != 0 || pipe(control) != 0) {
+        throw std::runtime_error("pipe failed");
+    }
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(report[0]);
+        close(control[1]);
+        runtime::DistributedRegistry registry;
+        register_tasks(registry);
+        runtime::config::NodeOptions options;
+        options.pool.threads = 1;
+        runtime::DistributedNode node(registry, options);
+        uint16_t port = node.port();
+        (void)!write(report[1], &port, sizeof(port));
+        char byte;
+        while (read(control[0], &byte, 1) > 0) {
+        }
+        _exit(0);
+    }
+    close(report[1]);
+    close(control[0]);
+    uint16_t port = 0;
+    (void)!read(report[0], &port, sizeof(port));
+    close(report[0]);
+    return Child{pid, port, control[1]};
+}
+
+void benchmark_nodes(const char* title, TaskId id, int tasks, int micros) {
+    std::cout << "=== " << title << ": " << tasks << " tasks x " << micros << "us ===\n\n";
+
+    std::cout << std::left << std::setw(10) << "Nodes"
+              << std::setw(14) << "Time (ms)"
+              << std::setw(12) << "Speedup"
+              << std::setw(16) << "Run remotely"
+              << "\n";
+    std::cout << std::string(52, '-') << "\n";
+
+    double baseline = 0;
+    for (int nodes = 1; nodes <= 4; ++nodes) {
+        // Fork while this process has no threads: the local node is built afterwards
+        std::vector<Child> children;
+        for (int i = 1; i < nodes; ++i) children.push_back(fork_node());
+
+        double ms = 0;
+        uint64_t remote = 0;
+        {
+            runtime::DistributedRegistry registry;
+            register_tasks(registry);
+            runtime::config::NodeOptions options;
+            options.pool.threads = 1;
+            runtime::DistributedNode node(registry, options);
+            for (const auto& child : children) node.connect("127.0.0.1", child.port);
+
+            auto start = Clock::now();
+            for (int i = 0; i < tasks; ++i) {
+                if (id == Spin) {
+                    node.submit<long long>(Spin, micros);
+                } else {
+                    node.submit<void>(Sleep, micros);
+                }
+            }
+            node.wait();
+            ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            remote = node.stats().tasks_given.load() - node.stats().tasks_requeued.load();
+            for (const auto& child : children) close(child.control_fd);
+        }
+        for (const auto& child : children) waitpid(child.pid, nullptr, 0);
+
+        if (nodes == 1) baseline = ms;
+        std::cout << std::setw(10) << nodes
+                  << std::setw(14) << std::fixed << std::setprecision(1) << ms
+                  << std::setw(12) << std::setprecision(2) << baseline / ms
+                  << remote << "\n";
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << "\n╔════════════════════════════════════════════════════════╗\n";
+    std::cout << "║         Distributed Work Stealing Benchmark            ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════╝\n\n";
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << "\n";
+    std::cout << "One single-worker node per process, all on localhost;\n"
+              << "tasks are submitted on node 1 and stolen by the others.\n\n";
+
+    benchmark_nodes("CPU-bound", Spin, 2000, 500);
+    benchmark_nodes("Waiting", Sleep, 2000, 500);
+
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include <runtime/thread_pool.h>
+#include <runtime/executor.h>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+// A little work per task so the numbers are not pure queue overhead
+inline void spin_work(uint64_t& state) {
+    for (int i = 0; i < 200; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+}
+
+double mtasks_per_second(size_t tasks, std::chrono::high_resolution_clock::time_point start) {
+    double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    return static_cast<double>(tasks) / seconds / 1e6;
+}
+
+// Many independent ordered streams (e.g. one per connection) on one pool:
+// strands vs guarding each stream's state with a mutex that workers block on
+void benchmark_strands() {
+    std::cout << "=== Strand Throughput: many SerialExecutors on one pool ===\n";
+    std::cout << "400k tasks spread round-robin over N streams\n\n";
+
+    std::cout << std::left << std::setw(12) << "Streams"
+              << std::setw(24) << "mutex per stream (M/s)"
+              << std::setw(22) << "SerialExecutor (M/s)"
+              << "\n";
+    std::cout << std::string(58, '-') << "\n";
+
+    const size_t tasks = 400000;
+    runtime::ThreadPool pool;
+
+    for (size_t streams : {1, 16, 256, 4096}) {
+        struct Stream {
+            std::mutex mutex;
+            uint64_t state = 1;
+        };
+        std::vector<Stream> locked(streams);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < tasks; ++i) {
+            Stream& s = locked[i % streams];
+            pool.submit([&s]() {
+                std::lock_guard<std::mutex> lock(s.mutex);
+                spin_work(s.state);
+            });
+        }
+        pool.wait();
+        double mutex_rate = mtasks_per_second(tasks, start);
+
+        std::vector<uint64_t> states(streams, 1);
+        std::vector<std::unique_ptr<runtime::SerialExecutor>> strands;
+        strands.reserve(streams);
+        for (size_t s = 0; s < streams; ++s) {
+            strands.push_back(std::make_unique<runtime::SerialExecutor>(pool));
+        }
+
+        start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < tasks; ++i) {
+            size_t s = i % streams;
+            strands[s]->submit([&states, s]() { spin_work(states[s]); });
+        }
+        for (auto& strand : strands) strand->wait();
+        double strand_rate = mtasks_per_second(tasks, start);
+
+        std::cout << std::setw(12) << streams
+                  << std::setw(24) << std::fixed << std::setprecision(2) << mutex_rate
+                  << std::setw(22) << strand_rate << "\n";
+    }
+    std::cout << "\n";
+}
+
+// Counting semaphore of the kind LimitedExecutor replaces
+class BlockingSemaphore {
+    public:
+        explicit BlockingSemaphore(int permits) : permits_(permits) {}
+        void acquire() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return permits_ > 0; });
+            --permits_;
+        }
+        void release() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++permits_;
+            }
+            cv_.notify_one();
+        }
+    private:
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        int permits_;
+};
+
+// A resource that tolerates 2 concurrent operations, mixed with unrelated
+// work: blocked workers delay the unrelated tasks, queued executor work does not
+void benchmark_limited() {
+    std::cout << "=== Concurrency Limit: LimitedExecutor vs blocking semaphore ===\n";
+    std::cout << "2000 limited ops (50 μs each, limit 2) + 200k unrelated tasks\n\n";
+
+    std::cout << std::left << std::setw(22) << "Variant"
+              << std::setw(20) << "Unrelated done (ms)"
+              << std::setw(18) << "All done (ms)"
+              << "\n";
+    std::cout << std::string(60, '-') << "\n";
+
+    const size_t limited_ops = 2000;
+    const size_t unrelated = 200000;
+    runtime::ThreadPool pool;
+
+    auto run = [&](const std::string& name, auto&& submit_limited) {
+        std::atomic<size_t> unrelated_done{0};
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < limited_ops; ++i) {
+            submit_limited([]() { std::this_thread::sleep_for(std::chrono::microseconds(50)); });
+        }
+        std::chrono::high_resolution_clock::time_point unrelated_end;
+        for (size_t i = 0; i < unrelated; ++i) {
+            pool.submit([&]() {
+                if (unrelated_done.fetch_add(1) + 1 == unrelated) {
+                    unrelated_end = std::chrono::high_resolution_clock::now();
+                }
+            });
+        }
+        pool.wait();
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << std::setw(22) << name
+                  << std::setw(20) << std::chrono::duration_cast<std::chrono::milliseconds>(unrelated_end - start).count()
+                  << std::setw(18) << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+                  << "\n";
+    };
+
+    BlockingSemaphore semaphore(2);
+    run("blocking semaphore", [&](auto op) {
+        pool.submit([&semaphore, op]() {
+            semaphore.acquire();
+            op();
+            semaphore.release();
+        });
+    });
+
+    runtime::LimitedExecutor limited(pool, 2);
+    run("LimitedExecutor", [&](auto op) { limited.submit(op); });
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << "\n╔════════════════════════════════════════════════════════╗\n";
+    std::cout << "║          Limited / Serial Executor Benchmarks         ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════╝\n\n";
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+
+    benchmark_strands();
+    benchmark_limited();
+
+    return 0;
+}
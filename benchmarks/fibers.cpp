@@ -0,0 +1,167 @@
+#include <runtime/thread_pool.h>
+#include <runtime/fiber.h>
+#include <runtime/async_sync.h>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <ucontext.h>
+
+using Clock = std::chrono::high_resolution_clock;
+
+double ns_per(Clock::time_point start, size_t ops) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / static_cast<double>(ops);
+}
+
+// Reference: the same ping-pong with glibc's swapcontext (saves the signal
+// mask, so it makes a syscall per switch)
+namespace ucontext_ref {
+ucontext_t main_context;
+ucontext_t fiber_context;
+size_t rounds;
+
+void body() {
+    for (size_t i = 0; i < rounds; ++i) {
+        swapcontext(&fiber_context, &main_context);
+    }
+}
+
+double measure(size_t n) {
+    std::vector<char> stack(64 * 1024);
+    rounds = n;
+    getcontext(&fiber_context);
+    fiber_context.uc_stack.ss_sp = stack.data();
+    fiber_context.uc_stack.ss_size = stack.size();
+    fiber_context.uc_link = &main_context;
+    makecontext(&fiber_context, &body, 0);
+    auto start = Clock::now();
+    for (size_t i = 0; i <= n; ++i) {
+        swapcontext(&main_context, &fiber_context);
+    }
+    return ns_per(start, 2 * (n + 1));
+}
+} // namespace ucontext_ref
+
+// Two OS threads handing a token back and forth through a condition variable
+double thread_handoff_ns(size_t rounds) {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool ping = true;
+    auto start = Clock::now();
+    std::thread other([&]() {
+        for (size_t i = 0; i < rounds; ++i) {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&]() { return !ping; });
+            ping = true;
+            cv.notify_one();
+        }
+    });
+    for (size_t i = 0; i < rounds; ++i) {
+        std::unique_lock<std::mutex> lock(mutex);
+        ping = false;
+        cv.notify_one();
+        cv.wait(lock, [&]() { return ping; });
+    }
+    other.join();
+    return ns_per(start, 2 * rounds);
+}
+
+void benchmark_switch_cost() {
+    std::cout << "=== Context Switch Cost ===\n\n";
+
+    std::cout << std::left << std::setw(44) << "Switch"
+              << std::setw(14) << "ns / switch"
+              << "\n";
+    std::cout << std::string(58, '-') << "\n";
+
+    const size_t rounds = 1000000;
+    std::cout << std::setw(44) << "fiber switch (bare)"
+              << std::fixed << std::setprecision(1) << runtime::detail::measure_switch_ns(rounds) << "\n";
+    std::cout << std::setw(44) << "swapcontext (bare)"
+              << ucontext_ref::measure(rounds) << "\n";
+
+    // Suspend + pinned requeue + resume through the pool
+    {
+        runtime::config::ThreadPoolOptions options;
+        options.threads = 1;
+        runtime::ThreadPool pool(options);
+        const size_t yields = 200000;
+        auto start = Clock::now();
+        runtime::submit_fiber(pool, [&]() {
+            for (size_t i = 0; i < yields; ++i) runtime::this_fiber::yield();
+        });
+        pool.wait();
+        std::cout << std::setw(44) << "this_fiber::yield (via scheduler)"
+                  << ns_per(start, 2 * yields) << "\n";
+    }
+
+    // Blocking handoff between two fibers on one worker vs two threads
+    {
+        runtime::config::ThreadPoolOptions options;
+        options.threads = 1;
+        runtime::ThreadPool pool(options);
+        runtime::AsyncSemaphore ping(pool, 0);
+        runtime::AsyncSemaphore pong(pool, 0);
+        const size_t handoffs = 100000;
+        auto start = Clock::now();
+        runtime::submit_fiber(pool, [&]() {
+            for (size_t i = 0; i < handoffs; ++i) {
+                ping.release();
+                runtime::this_fiber::acquire(pong);
+            }
+        });
+        runtime::submit_fiber(pool, [&]() {
+            for (size_t i = 0; i < handoffs; ++i) {
+                runtime::this_fiber::acquire(ping);
+                pong.release();
+            }
+        });
+        pool.wait();
+        std::cout << std::setw(44) << "blocking handoff, 2 fibers on 1 worker"
+                  << ns_per(start, 2 * handoffs) << "\n";
+    }
+    std::cout << std::setw(44) << "blocking handoff, 2 threads (condvar)"
+              << thread_handoff_ns(100000) << "\n\n";
+}
+
+// Spawning: a fiber costs a stack from the worker cache and one switch in and out
+void benchmark_spawn() {
+    std::cout << "=== Spawn Cost: 200k empty tasks ===\n\n";
+
+    std::cout << std::left << std::setw(20) << "Variant"
+              << std::setw(16) << "ns / task"
+              << std::setw(16) << "Stacks mapped"
+              << "\n";
+    std::cout << std::string(52, '-') << "\n";
+
+    const size_t tasks = 200000;
+    runtime::ThreadPool pool;
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < tasks; ++i) pool.submit([]() {});
+    pool.wait();
+    std::cout << std::setw(20) << "submit" << std::setw(16) << std::fixed << std::setprecision(1)
+              << ns_per(start, tasks) << std::setw(16) << "-" << "\n";
+
+    start = Clock::now();
+    for (size_t i = 0; i < tasks; ++i) runtime::submit_fiber(pool, []() {});
+    pool.wait();
+    std::cout << std::setw(20) << "submit_fiber" << std::setw(16) << ns_per(start, tasks)
+              << std::setw(16) << pool.stats().fiber_stacks_mapped.load() << "\n\n";
+}
+
+int main() {
+    std::cout << "\n╔════════════════════════════════════════════════════════╗\n";
+    std::cout << "║                Fiber Benchmark Suite                  ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════╝\n\n";
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+
+    benchmark_switch_cost();
+    benchmark_spawn();
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include <runtime/thread_pool.h>
+#include <runtime/fork_join.h>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+
+long long fib_serial(int n) {
+    return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+// Every call above the cutoff forks; cutoff 0 measures raw fork/join overhead
+long long fib_fork_join(runtime::ThreadPool& pool, int n, int cutoff) {
+    if (n < 2) return n;
+    if (n <= cutoff) return fib_serial(n);
+    long long a = 0, b = 0;
+    runtime::fork_join(pool,
+        [&]() { a = fib_fork_join(pool, n - 1, cutoff); },
+        [&]() { b = fib_fork_join(pool, n - 2, cutoff); });
+    return a + b;
+}
+
+void quicksort(runtime::ThreadPool& pool, int* first, int* last) {
+    if (last - first <= 4096) {
+        std::sort(first, last);
+        return;
+    }
+    int pivot = *(first + (last - first) / 2);
+    int* mid1 = std::partition(first, last, [pivot](int v) { return v < pivot; });
+    int* mid2 = std::partition(mid1, last, [pivot](int v) { return !(pivot < v); });
+    runtime::fork_join(pool,
+        [&]() { quicksort(pool, first, mid1); },
+        [&]() { quicksort(pool, mid2, last); });
+}
+
+void benchmark_fib() {
+    std::cout << "=== Recursive Fibonacci: fork_join overhead ===\n";
+    std::cout << "fib(30), varying serial cutoff\n\n";
+
+    runtime::ThreadPool pool;
+    const int n = 30;
+
+    std::cout << std::left << std::setw(20) << "Variant"
+              << std::setw(15) << "Time (ms)"
+              << std::setw(18) << "Forks"
+              << std::setw(18) << "ns/fork (excess)"
+              << "\n";
+    std::cout << std::string(71, '-') << "\n";
+
+    auto start = std::chrono::high_resolution_clock::now();
+    long long expected = fib_serial(n);
+    auto end = std::chrono::high_resolution_clock::now();
+    double serial_ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::cout << std::setw(20) << "serial"
+              << std::setw(15) << static_cast<long long>(serial_ns / 1e6)
+              << std::setw(18) << 0 << std::setw(18) << "-" << "\n";
+
+    for (int cutoff : {20, 15, 10, 0}) {
+        uint64_t before = pool.stats().tasks_submitted.load();
+        start = std::chrono::high_resolution_clock::now();
+        // Enter the pool once so every fork is pushed onto a worker's own queue
+        long long value = pool.submit_task([&]() { return fib_fork_join(pool, n, cutoff); }).get();
+        end = std::chrono::high_resolution_clock::now();
+        uint64_t forks = pool.stats().tasks_submitted.load() - before;
+        double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        double per_fork = forks ? (ns - serial_ns) / forks : 0.0;
+
+        std::cout << std::setw(20) << ("cutoff " + std::to_string(cutoff))
+                  << std::setw(15) << static_cast<long long>(ns / 1e6)
+                  << std::setw(18) << forks
+                  << std::setw(18) << std::fixed << std::setprecision(1) << per_fork
+                  << (value == expected ? "" : "  WRONG RESULT") << "\n";
+    }
+    std::cout << "\n";
+}
+
+void benchmark_quicksort() {
+    std::cout << "=== Parallel Quicksort via fork_join ===\n\n";
+
+    runtime::ThreadPool pool;
+    std::mt19937 rng(42);
+
+    std::cout << std::left << std::setw(15) << "Elements"
+              << std::setw(18) << "std::sort (ms)"
+              << std::setw(18) << "fork_join (ms)"
+              << "\n";
+    std::cout << std::string(51, '-') << "\n";
+
+    for (size_t n : {100000, 1000000, 10000000}) {
+        std::vector<int> data(n);
+        for (auto& v : data) v = static_cast<int>(rng());
+        std::vector<int> copy = data;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        std::sort(copy.begin(), copy.end());
+        auto end = std::chrono::high_resolution_clock::now();
+        auto serial_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+        start = std::chrono::high_resolution_clock::now();
+        pool.submit_task([&]() { quicksort(pool, data.data(), data.data() + data.size()); }).get();
+        end = std::chrono::high_resolution_clock::now();
+        auto parallel_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+        std::cout << std::setw(15) << n
+                  << std::setw(18) << serial_ms
+                  << std::setw(18) << parallel_ms
+                  << (data == copy ? "" : "  WRONG RESULT") << "\n";
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << "\n╔════════════════════════════════════════════════════════╗\n";
+    std::cout << "║          Fork-Join Benchmark Suite                    ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════╝\n\n";
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+
+    benchmark_fib();
+    benchmark_quicksort();
+
+    return 0;
+}
@@ -1,10 +1,14 @@
 #include <runtime/thread_pool.h>
+#include <runtime/parallel_for.h>
+#include <runtime/blocked_range.h>
 #include <iostream>
 #include <chrono>
 #include <iomanip>
 #include <vector>
 #include <cmath>
 #include <random>
+#include <algorithm>
+#include <string>
 
 // Heavy CPU-bound computation
 double compute_intensive_task(int iterations) {
@@ -146,6 +150,73 @@ void benchmark_parallel_matrix_multiply() {
     std::cout << "\n";
 }
 
+void benchmark_tiled_matrix_multiply() {
+    std::cout << "=== Tiled Matrix Multiplication Benchmark ===\n";
+    std::cout << "One large multiplication: row-parallel vs 2D tiles\n\n";
+    
+    const size_t n = 512;
+    const std::vector<size_t> tile_sizes = {16, 32, 64, 128};
+    
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    
+    std::vector<double> A(n * n), B(n * n), C(n * n);
+    for (auto& v : A) v = dist(rng);
+    for (auto& v : B) v = dist(rng);
+    
+    runtime::ThreadPool pool;
+    
+    std::cout << std::left << std::setw(20) << "Partitioning" 
+              << std::setw(15) << "Time (ms)"
+              << std::setw(20) << "GFLOP/s"
+              << "\n";
+    std::cout << std::string(55, '-') << "\n";
+    
+    auto report = [n](const std::string& name, long long duration_ms) {
+        double gflops = (2.0 * n * n * n) / (std::max(1LL, duration_ms) * 1e6);
+        std::cout << std::setw(20) << name
+                  << std::setw(15) << duration_ms
+                  << std::setw(20) << std::fixed << std::setprecision(2) << gflops
+                  << "\n";
+    };
+    
+    // Row-parallel: each task owns whole rows of C and streams all of B
+    std::fill(C.begin(), C.end(), 0.0);
+    auto start = std::chrono::high_resolution_clock::now();
+    runtime::parallel_for(pool, size_t(0), n, [&](size_t i) {
+        for (size_t k = 0; k < n; ++k) {
+            double a = A[i * n + k];
+            for (size_t j = 0; j < n; ++j) {
+                C[i * n + j] += a * B[k * n + j];
+            }
+        }
+    }, 8);
+    auto end = std::chrono::high_resolution_clock::now();
+    report("rows", std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+    
+    // 2D tiles: each task owns a tile of C and only touches matching column strips of B
+    for (size_t tile : tile_sizes) {
+        std::fill(C.begin(), C.end(), 0.0);
+        start = std::chrono::high_resolution_clock::now();
+        runtime::parallel_for(pool, runtime::blocked_range2d<size_t>(0, n, tile, 0, n, tile),
+            [&](const runtime::blocked_range2d<size_t>& r) {
+                for (size_t i = r.rows().begin(); i < r.rows().end(); ++i) {
+                    for (size_t k = 0; k < n; ++k) {
+                        double a = A[i * n + k];
+                        for (size_t j = r.cols().begin(); j < r.cols().end(); ++j) {
+                            C[i * n + j] += a * B[k * n + j];
+                        }
+                    }
+                }
+            });
+        end = std::chrono::high_resolution_clock::now();
+        report("tiles " + std::to_string(tile) + "x" + std::to_string(tile),
+               std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+    }
+    
+    std::cout << "\n";
+}
+
 void benchmark_mixed_workload() {
     std::cout << "=== Mixed Heavy Workload Benchmark ===\n";
     std::cout << "Combination of different heavy tasks\n\n";
@@ -204,6 +275,7 @@ int main() {
     
     benchmark_cpu_intensive();
     benchmark_parallel_matrix_multiply();
+    benchmark_tiled_matrix_multiply();
     benchmark_mixed_workload();
     
     return 0;
@@ -0,0 +1,122 @@
+#include <runtime/thread_pool.h>
+#include <runtime/huge_pages.h>
+#include <runtime/perf_counters.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+
+using Clock = std::chrono::high_resolution_clock;
+using runtime::config::HugePages;
+using runtime::PerfEvent;
+
+// Anonymous memory of this process that the kernel backs with huge pages
+// (transparent or not), in KiB
+long anon_huge_kib() {
+    std::ifstream smaps("/proc/self/smaps_rollup");
+    std::string key;
+    long value = 0;
+    while (smaps >> key) {
+        if (key == "AnonHugePages:") {
+            smaps >> value;
+            return value;
+        }
+        smaps.ignore(256, '\n');
+    }
+    return -1;
+}
+
+// Enough workers for a steal sweep to span many queues
+size_t worker_count() {
+    return std::max<size_t>(64, std::thread::hardware_concurrency());
+}
+
+std::string per_kilo_task(const runtime::PerfCounters& counters, PerfEvent event, size_t tasks) {
+    if (!counters.available(event)) return "n/a";
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1)
+        << static_cast<double>(counters.value(event)) * 1000.0 / static_cast<double>(tasks);
+    return out.str();
+}
+
+// Deep queues on every worker, drained by popping and stealing: the
+// queues' blocks are what the sweeps walk over
+void benchmark_steal_sweeps(HugePages mode, const char* label) {
+    const size_t tasks_per_round = 1 << 21;
+    const int rounds = 3;
+
+    // Opened before the pool so its workers are counted
+    runtime::PerfCounters counters({PerfEvent::DtlbLoadMisses, PerfEvent::DtlbStoreMisses,
+                                    PerfEvent::PageFaults});
+    runtime::config::ThreadPoolOptions options;
+    options.threads = worker_count();
+    options.huge_pages = mode;
+    runtime::ThreadPool pool(options);
+
+    std::atomic<uint64_t> sink{0};
+    double ms = 0;
+    counters.start();
+    for (int round = 0; round < rounds; ++round) {
+        std::vector<runtime::Task> batch;
+        batch.reserve(tasks_per_round);
+        for (size_t i = 0; i < tasks_per_round; ++i) {
+            batch.emplace_back([&sink, i]() { sink.fetch_add(i & 1, std::memory_order_relaxed); });
+        }
+        auto start = Clock::now();
+        pool.submit_batch(batch);
+        pool.wait();
+        ms += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+    counters.stop();
+
+    size_t tasks = tasks_per_round * rounds;
+    std::cout << std::setw(14) << label
+              << std::setw(12) << std::fixed << std::setprecision(1) << ms
+              << std::setw(10) << ms * 1e6 / static_cast<double>(tasks)
+              << std::setw(14) << per_kilo_task(counters, PerfEvent::DtlbLoadMisses, tasks)
+              << std::setw(14) << per_kilo_task(counters, PerfEvent::DtlbStoreMisses, tasks)
+              << std::setw(14) << per_kilo_task(counters, PerfEvent::PageFaults, tasks)
+              << std::setw(9) << pool.stats().huge_page_regions.load()
+              << std::setw(10) << pool.stats().huge_page_fallbacks.load()
+              << std::setw(12) << anon_huge_kib() / 1024
+              << "\n";
+}
+
+int main() {
+    std::cout << "\n╔════════════════════════════════════════════════════════╗\n";
+    std::cout << "║              Huge Page Benchmark Suite                 ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════╝\n\n";
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency()
+              << ", workers: " << worker_count() << "\n";
+    runtime::PerfCounters probe({PerfEvent::DtlbLoadMisses});
+    if (!probe.available(PerfEvent::DtlbLoadMisses)) {
+        std::cout << "dTLB counters unavailable here (perf_event_paranoid, or no PMU): shown as n/a\n";
+    }
+    std::cout << "\n";
+
+    std::cout << "=== Steal Sweeps: 3 x 2M tiny tasks spread over every queue ===\n\n";
+    std::cout << std::left << std::setw(14) << "Pages"
+              << std::setw(12) << "Time (ms)"
+              << std::setw(10) << "ns/task"
+              << std::setw(14) << "dTLB-ld/1k"
+              << std::setw(14) << "dTLB-st/1k"
+              << std::setw(14) << "Faults/1k"
+              << std::setw(9) << "Huge"
+              << std::setw(10) << "Normal"
+              << std::setw(12) << "THP (MiB)"
+              << "\n";
+    std::cout << std::string(109, '-') << "\n";
+    benchmark_steal_sweeps(HugePages::Off, "4 KiB");
+    benchmark_steal_sweeps(HugePages::Transparent, "Transparent");
+    benchmark_steal_sweeps(HugePages::Explicit, "Explicit");
+    std::cout << "\nHuge / Normal: runtime regions on huge pages / left on 4 KiB pages\n";
+    std::cout << "THP: process memory backed by huge pages while the pool is alive\n\n";
+
+    return 0;
+}
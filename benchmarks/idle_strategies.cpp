@@ -0,0 +1,120 @@
+#include <runtime/thread_pool.h>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <algorithm>
+#include <thread>
+#include <ctime>
+
+using Clock = std::chrono::steady_clock;
+
+struct Strategy {
+    runtime::config::IdleStrategy strategy;
+    bool adaptive;
+    const char* name;
+};
+
+const Strategy strategies[] = {
+    {runtime::config::IdleStrategy::BusySpin, false, "BusySpin"},
+    {runtime::config::IdleStrategy::SpinThenYield, false, "SpinThenYield"},
+    {runtime::config::IdleStrategy::SpinThenYield, true, "SpinThenYield (adaptive)"},
+    {runtime::config::IdleStrategy::SpinThenPark, false, "SpinThenPark"},
+    {runtime::config::IdleStrategy::SpinThenPark, true, "SpinThenPark (adaptive)"},
+    {runtime::config::IdleStrategy::ParkImmediately, false, "ParkImmediately"},
+};
+
+runtime::config::ThreadPoolOptions options_for(const Strategy& s) {
+    runtime::config::ThreadPoolOptions options;
+    options.idle_strategy = s.strategy;
+    options.adaptive_spin = s.adaptive;
+    return options;
+}
+
+double process_cpu_seconds() {
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Submit one task to a pool whose workers have gone idle and time how long
+// it takes to start running
+void benchmark_wake_latency() {
+    std::cout << "=== Wake Latency: 1 task after a 200us gap ===\n\n";
+
+    std::cout << std::left << std::setw(28) << "Strategy"
+              << std::setw(14) << "Median (us)"
+              << std::setw(14) << "p99 (us)"
+              << std::setw(12) << "Spin hits"
+              << "\n";
+    std::cout << std::string(68, '-') << "\n";
+
+    const int samples = 500;
+    for (const auto& s : strategies) {
+        runtime::ThreadPool pool(options_for(s));
+        std::vector<double> latencies;
+        latencies.reserve(samples);
+        for (int i = 0; i < samples; ++i) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            std::atomic<int64_t> started{0};
+            auto submitted = Clock::now();
+            pool.submit([&started]() {
+                started = Clock::now().time_since_epoch().count();
+            });
+            pool.wait();
+            auto delay = Clock::time_point(Clock::duration(started.load())) - submitted;
+            latencies.push_back(std::chrono::duration<double, std::micro>(delay).count());
+        }
+        std::sort(latencies.begin(), latencies.end());
+        std::cout << std::setw(28) << s.name
+                  << std::setw(14) << std::fixed << std::setprecision(1) << latencies[samples / 2]
+                  << std::setw(14) << latencies[samples * 99 / 100]
+                  << std::setw(12) << pool.stats().spin_hits.load()
+                  << "\n";
+    }
+    std::cout << "\n";
+}
+
+// CPU the pool burns while it has nothing to do
+void benchmark_idle_cpu() {
+    std::cout << "=== Idle CPU: pool with no work for 300 ms ===\n\n";
+
+    std::cout << std::left << std::setw(28) << "Strategy"
+              << std::setw(20) << "CPU (% of a core)"
+              << std::setw(12) << "Parks"
+              << "\n";
+    std::cout << std::string(60, '-') << "\n";
+
+    for (const auto& s : strategies) {
+        runtime::ThreadPool pool(options_for(s));
+        pool.submit([]() {});
+        pool.wait();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));  // let the spin phase run out
+
+        double cpu_before = process_cpu_seconds();
+        auto wall_before = Clock::now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        double cpu = process_cpu_seconds() - cpu_before;
+        double wall = std::chrono::duration<double>(Clock::now() - wall_before).count();
+
+        std::cout << std::setw(28) << s.name
+                  << std::setw(20) << std::fixed << std::setprecision(1) << 100.0 * cpu / wall
+                  << std::setw(12) << pool.stats().worker_parks.load()
+                  << "\n";
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << "\n╔════════════════════════════════════════════════════════╗\n";
+    std::cout << "║            Idle Strategy Benchmark Suite               ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════╝\n\n";
+    std::cout << "Hardware threads (= workers per pool): " << std::thread::hardware_concurrency() << "\n\n";
+
+    benchmark_wake_latency();
+    benchmark_idle_cpu();
+
+    return 0;
+}
@@ -184,7 +184,7 @@ void benchmark_work_stealing_latency() {
     std::cout << "  Tasks stolen: " << stats.tasks_stolen << "\n";
     std::cout << "  Steal attempts: " << stats.steal_attempts << "\n";
     std::cout << "  Success rate: " << std::fixed << std::setprecision(1)
-              << (100.0 * stats.tasks_stolen / std::max(1ULL, stats.steal_attempts.load())) << "%\n\n";
+              << (100.0 * stats.tasks_stolen / std::max<uint64_t>(1, stats.steal_attempts.load())) << "%\n\n";
 }
 
 int main() {
@@ -0,0 +1,443 @@
+#include <runtime/thread_pool.h>
+#include <runtime/parallel_for.h>
+#include <runtime/parallel_reduce.h>
+#include <runtime/partitioner.h>
+#include <runtime/parallel_for_each.h>
+#include <runtime/execution.h>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <vector>
+#include <list>
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <cstdint>
+
+// Run fn `reps` times and return the best wall time in microseconds
+template<typename Fn>
+long long best_of(int reps, Fn&& fn) {
+    long long best = -1;
+    for (int r = 0; r < reps; ++r) {
+        auto start = std::chrono::high_resolution_clock::now();
+        fn();
+        auto end = std::chrono::high_resolution_clock::now();
+        long long us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        if (best < 0 || us < best) best = us;
+    }
+    return best;
+}
+
+void print_header(const std::string& first_column) {
+    std::cout << std::left << std::setw(28) << first_column
+              << std::setw(15) << "Time (μs)"
+              << std::setw(15) << "Speedup"
+              << "\n";
+    std::cout << std::string(58, '-') << "\n";
+}
+
+void print_row(const std::string& name, long long us, long long baseline_us) {
+    std::cout << std::setw(28) << name
+              << std::setw(15) << us
+              << std::setw(15) << std::fixed << std::setprecision(2)
+              << static_cast<double>(baseline_us) / std::max(1LL, us)
+              << "\n";
+}
+
+// Per-index parallel_for vs chunk bodies the compiler can vectorise
+void benchmark_chunked_vs_per_index() {
+    std::cout << "=== Chunked vs Per-Index parallel_for ===\n";
+    std::cout << "saxpy and dot product over 4M floats (best of 5)\n\n";
+
+    runtime::ThreadPool pool;
+    const size_t n = 1 << 22;
+    const size_t chunk = 1 << 14;
+    std::vector<float> x(n, 1.5f), y(n, 0.5f);
+
+    print_header("Kernel");
+
+    long long per_index = best_of(5, [&]() {
+        runtime::parallel_for(pool, size_t(0), n, [&](size_t i) {
+            y[i] = 2.0f * x[i] + y[i];
+        }, chunk);
+    });
+    print_row("saxpy per-index", per_index, per_index);
+
+    long long chunked = best_of(5, [&]() {
+        runtime::parallel_for_chunked(pool, size_t(0), n, [&](size_t first, size_t last) {
+            float* __restrict yp = y.data();
+            const float* __restrict xp = x.data();
+            for (size_t i = first; i < last; ++i) {
+                yp[i] = 2.0f * xp[i] + yp[i];
+            }
+        }, chunk, runtime::align_chunks_to(y.data()));
+    });
+    print_row("saxpy chunked (aligned)", chunked, per_index);
+
+    volatile double sink = 0.0;
+    per_index = best_of(5, [&]() {
+        sink = runtime::parallel_reduce(pool, size_t(0), n, 0.0,
+            [&](size_t i) { return static_cast<double>(x[i] * y[i]); },
+            std::plus<double>(), chunk);
+    });
+    print_row("dot per-index", per_index, per_index);
+
+    chunked = best_of(5, [&]() {
+        sink = runtime::parallel_reduce_chunked(pool, size_t(0), n, 0.0,
+            [&](size_t first, size_t last) {
+                float acc[8] = {};
+                size_t i = first;
+                for (; i + 8 <= last; i += 8) {
+                    for (size_t lane = 0; lane < 8; ++lane) {
+                        acc[lane] += x[i + lane] * y[i + lane];
+                    }
+                }
+                double sum = 0.0;
+                for (float a : acc) sum += a;
+                for (; i < last; ++i) sum += x[i] * y[i];
+                return sum;
+            },
+            std::plus<double>(), chunk, runtime::align_chunks_to(x.data()));
+    });
+    print_row("dot chunked (aligned)", chunked, per_index);
+    (void)sink;
+
+    std::cout << "\n";
+}
+
+// Jacobi sweeps over the same arrays: plain chunk scattering vs replayed affinity
+void benchmark_jacobi_affinity() {
+    std::cout << "=== Iterative Jacobi: Affinity Partitioner ===\n";
+    std::cout << "1D Jacobi, 1M doubles, 100 sweeps\n\n";
+
+    runtime::ThreadPool pool;
+    const size_t n = 1 << 20;
+    const int sweeps = 100;
+    const size_t chunk = std::max<size_t>(1024, n / (pool.thread_count() * 8));
+
+    std::vector<double> u(n), v(n);
+    auto reset = [&]() {
+        for (size_t i = 0; i < n; ++i) u[i] = (i % 97) * 0.01;
+        u.front() = 1.0;
+        u.back() = 0.0;
+        v = u;
+    };
+
+    auto sweep = [&](std::vector<double>& from, std::vector<double>& to) {
+        return [&from, &to, n](size_t first, size_t last) {
+            for (size_t i = std::max<size_t>(first, 1); i < std::min(last, n - 1); ++i) {
+                to[i] = 0.5 * (from[i - 1] + from[i + 1]);
+            }
+        };
+    };
+
+    print_header("Partitioning");
+
+    reset();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int s = 0; s < sweeps; ++s) {
+        if (s % 2 == 0) runtime::parallel_for_chunked(pool, size_t(0), n, sweep(u, v), chunk);
+        else runtime::parallel_for_chunked(pool, size_t(0), n, sweep(v, u), chunk);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    long long plain = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    print_row("random placement", plain, plain);
+
+    reset();
+    runtime::affinity_partitioner ap;
+    size_t hits = 0, chunks = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (int s = 0; s < sweeps; ++s) {
+        if (s % 2 == 0) runtime::parallel_for_chunked(pool, size_t(0), n, sweep(u, v), ap, chunk);
+        else runtime::parallel_for_chunked(pool, size_t(0), n, sweep(v, u), ap, chunk);
+        if (s > 0) {
+            hits += ap.last_hits();
+            chunks += ap.chunk_count();
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    long long affine = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    print_row("affinity_partitioner", affine, plain);
+
+    std::cout << "\nChunks replayed on the same worker: " << std::fixed << std::setprecision(1)
+              << 100.0 * hits / std::max<size_t>(1, chunks) << "%\n\n";
+}
+
+// Uniform and decreasing-cost loops under each Schedule
+void benchmark_schedules() {
+    std::cout << "=== Loop Schedules ===\n";
+    std::cout << "Uniform loop and triangular (decreasing cost) loop, 20000 iterations\n\n";
+
+    runtime::ThreadPool pool;
+    const int n = 20000;
+    std::vector<double> out(n);
+
+    auto uniform = [&](int i) {
+        double acc = 0.0;
+        for (int k = 0; k < 200; ++k) acc += std::sqrt(i + k);
+        out[i] = acc;
+    };
+    auto triangular = [&](int i) {
+        double acc = 0.0;
+        for (int k = i; k < n; k += 16) acc += std::sqrt(k);
+        out[i] = acc;
+    };
+
+    struct Mode {
+        std::string name;
+        runtime::Schedule schedule;
+    };
+    const std::vector<Mode> modes = {
+        {"static", runtime::Schedule::Static()},
+        {"dynamic(256)", runtime::Schedule::Dynamic(256)},
+        {"guided", runtime::Schedule::Guided(16)},
+        {"auto", runtime::Schedule::Auto()},
+    };
+
+    std::cout << std::left << std::setw(20) << "Schedule"
+              << std::setw(18) << "Uniform (μs)"
+              << std::setw(18) << "Triangular (μs)"
+              << std::setw(15) << "Steals"
+              << "\n";
+    std::cout << std::string(71, '-') << "\n";
+
+    auto row = [&](const std::string& name, auto&& run_uniform, auto&& run_triangular) {
+        uint64_t steals_before = pool.stats().tasks_stolen.load();
+        long long u = best_of(3, run_uniform);
+        long long t = best_of(3, run_triangular);
+        uint64_t steals = pool.stats().tasks_stolen.load() - steals_before;
+        std::cout << std::setw(20) << name
+                  << std::setw(18) << u
+                  << std::setw(18) << t
+                  << std::setw(15) << steals
+                  << "\n";
+    };
+
+    row("chunked (default)",
+        [&]() { runtime::parallel_for(pool, 0, n, uniform, 256); },
+        [&]() { runtime::parallel_for(pool, 0, n, triangular, 256); });
+    for (const auto& mode : modes) {
+        row(mode.name,
+            [&]() { runtime::parallel_for(pool, 0, n, uniform, mode.schedule); },
+            [&]() { runtime::parallel_for(pool, 0, n, triangular, mode.schedule); });
+    }
+
+    std::cout << "\n";
+}
+
+// Fixed 1024-iteration chunks vs auto_chunk for cheap and expensive bodies
+void benchmark_adaptive_grain() {
+    std::cout << "=== Adaptive Grain Size ===\n";
+    std::cout << "Fixed chunk_size=1024 vs config::parallel_alg::auto_chunk\n\n";
+
+    runtime::ThreadPool pool;
+    const int cheap_n = 1 << 22;
+    const int heavy_n = 2000;
+    std::vector<float> out(cheap_n);
+    std::vector<double> heavy_out(heavy_n);
+
+    auto cheap = [&](int i) { out[i] = out[i] * 0.5f + 1.0f; };
+    auto heavy = [&](int i) {
+        double acc = 0.0;
+        for (int k = 1; k < 20000; ++k) acc += std::sqrt(static_cast<double>(k) * i);
+        heavy_out[i] = acc;
+    };
+
+    std::cout << std::left << std::setw(28) << "Body"
+              << std::setw(18) << "Fixed (μs)"
+              << std::setw(18) << "Auto (μs)"
+              << "\n";
+    std::cout << std::string(64, '-') << "\n";
+
+    long long fixed = best_of(3, [&]() { runtime::parallel_for(pool, 0, cheap_n, cheap); });
+    long long adaptive = best_of(3, [&]() {
+        runtime::parallel_for(pool, 0, cheap_n, cheap, runtime::config::parallel_alg::auto_chunk);
+    });
+    std::cout << std::setw(28) << "cheap (~1 ns x 4M)" << std::setw(18) << fixed
+              << std::setw(18) << adaptive << "\n";
+
+    fixed = best_of(3, [&]() { runtime::parallel_for(pool, 0, heavy_n, heavy); });
+    adaptive = best_of(3, [&]() {
+        runtime::parallel_for(pool, 0, heavy_n, heavy, runtime::config::parallel_alg::auto_chunk);
+    });
+    std::cout << std::setw(28) << "heavy (~50 μs x 2000)" << std::setw(18) << fixed
+              << std::setw(18) << adaptive << "\n";
+
+    volatile double sink = 0.0;
+    fixed = best_of(3, [&]() {
+        sink = runtime::parallel_reduce(pool, 0, cheap_n, 0.0,
+            [&](int i) { return static_cast<double>(out[i]); }, std::plus<double>());
+    });
+    adaptive = best_of(3, [&]() {
+        sink = runtime::parallel_reduce(pool, 0, cheap_n, 0.0,
+            [&](int i) { return static_cast<double>(out[i]); }, std::plus<double>(),
+            runtime::config::parallel_alg::auto_chunk);
+    });
+    (void)sink;
+    std::cout << std::setw(28) << "reduce (~1 ns x 4M)" << std::setw(18) << fixed
+              << std::setw(18) << adaptive << "\n\n";
+}
+
+// Fixed-tree reduction vs the regular chunked reduction
+void benchmark_deterministic_reduce() {
+    std::cout << "=== Deterministic parallel_reduce ===\n";
+    std::cout << "Sum of 4M doubles with mixed magnitudes (best of 5)\n\n";
+
+    const size_t n = 1 << 22;
+    std::vector<double> values(n);
+    for (size_t i = 0; i < n; ++i) {
+        values[i] = std::sin(i * 0.37) * std::pow(10.0, static_cast<double>(i % 13) - 6.0);
+    }
+    auto value_at = [&](size_t i) { return values[i]; };
+
+    std::cout << std::left << std::setw(10) << "Threads"
+              << std::setw(18) << "Regular (μs)"
+              << std::setw(20) << "Deterministic (μs)"
+              << std::setw(12) << "Overhead"
+              << "Deterministic result"
+              << "\n";
+    std::cout << std::string(82, '-') << "\n";
+
+    double reference = 0.0;
+    bool all_identical = true;
+    for (size_t threads = 1; threads <= std::max(2u, std::thread::hardware_concurrency()); threads *= 2) {
+        runtime::config::ThreadPoolOptions options;
+        options.threads = threads;
+        runtime::ThreadPool pool(options);
+
+        double regular = 0.0, deterministic = 0.0;
+        long long regular_us = best_of(5, [&]() {
+            regular = runtime::parallel_reduce(pool, size_t(0), n, 0.0, value_at, std::plus<double>());
+        });
+        long long deterministic_us = best_of(5, [&]() {
+            deterministic = runtime::parallel_deterministic_reduce(pool, size_t(0), n, 0.0, value_at,
+                                                                   std::plus<double>());
+        });
+        if (threads == 1) reference = deterministic;
+        all_identical = all_identical && deterministic == reference;
+        (void)regular;
+
+        std::cout << std::setw(10) << threads
+                  << std::setw(18) << regular_us
+                  << std::setw(20) << deterministic_us
+                  << std::setw(12) << std::fixed << std::setprecision(2)
+                  << static_cast<double>(deterministic_us) / std::max(1LL, regular_us)
+                  << std::setprecision(17) << deterministic << "\n";
+    }
+    std::cout << "\nDeterministic results bitwise identical across pool sizes: "
+              << (all_identical ? "yes" : "NO") << "\n\n";
+}
+
+// parallel_for_each / parallel_transform against the index loop they replace,
+// and on a std::list where no index loop exists
+void benchmark_iterator_algorithms() {
+    std::cout << "=== Iterator Algorithms vs Index Loops ===\n";
+    std::cout << "4M-element vector and 1M-element list (best of 5)\n\n";
+
+    struct Record {
+        double price;
+        double quantity;
+        double total;
+    };
+
+    runtime::ThreadPool pool;
+    const size_t n = 1 << 22;
+    std::vector<Record> records(n, Record{1.25, 3.0, 0.0});
+    std::vector<double> totals(n);
+
+    print_header("Variant");
+
+    long long index_loop = best_of(5, [&]() {
+        runtime::parallel_for(pool, size_t(0), n, [&](size_t i) {
+            records[i].total = records[i].price * records[i].quantity;
+        });
+    });
+    print_row("parallel_for (index)", index_loop, index_loop);
+
+    long long for_each = best_of(5, [&]() {
+        runtime::parallel_for_each(pool, records.begin(), records.end(), [](Record& r) {
+            r.total = r.price * r.quantity;
+        });
+    });
+    print_row("parallel_for_each", for_each, index_loop);
+
+    long long transform = best_of(5, [&]() {
+        runtime::parallel_transform(pool, records.begin(), records.end(), totals.begin(),
+                                    [](const Record& r) { return r.price * r.quantity; });
+    });
+    print_row("parallel_transform", transform, index_loop);
+
+    std::list<Record> list(n / 4, Record{1.25, 3.0, 0.0});
+    long long serial_list = best_of(5, [&]() {
+        std::for_each(list.begin(), list.end(), [](Record& r) {
+            r.total = r.price * r.quantity;
+        });
+    });
+    print_row("std::for_each (list)", serial_list, serial_list);
+
+    long long parallel_list = best_of(5, [&]() {
+        runtime::parallel_for_each(pool, list.begin(), list.end(), [](Record& r) {
+            r.total = r.price * r.quantity;
+        });
+    });
+    print_row("parallel_for_each (list)", parallel_list, serial_list);
+    std::cout << "\n";
+}
+
+// Policy overloads against the serial std:: algorithms they replace
+void benchmark_execution_policy() {
+    std::cout << "=== par_pool Policy vs Serial std:: Algorithms ===\n";
+    std::cout << "4M doubles (best of 5)\n\n";
+
+    runtime::ThreadPool pool;
+    auto par = runtime::execution::par_pool(pool);
+    const size_t n = 1 << 22;
+    std::vector<double> data(n);
+    for (size_t i = 0; i < n; ++i) data[i] = static_cast<double>((i * 2654435761u) % 1000);
+    std::vector<double> out(n);
+    volatile double sink = 0.0;
+
+    print_header("Algorithm");
+
+    long long serial = best_of(5, [&]() { sink = std::reduce(data.begin(), data.end(), 0.0); });
+    print_row("std::reduce", serial, serial);
+    long long parallel = best_of(5, [&]() { sink = runtime::reduce(par, data.begin(), data.end(), 0.0); });
+    print_row("runtime::reduce", parallel, serial);
+
+    serial = best_of(5, [&]() { std::inclusive_scan(data.begin(), data.end(), out.begin()); });
+    print_row("std::inclusive_scan", serial, serial);
+    parallel = best_of(5, [&]() { runtime::inclusive_scan(par, data.begin(), data.end(), out.begin()); });
+    print_row("runtime::inclusive_scan", parallel, serial);
+
+    serial = best_of(1, [&]() {
+        std::vector<double> copy = data;
+        std::sort(copy.begin(), copy.end());
+    });
+    print_row("std::sort (incl. copy)", serial, serial);
+    parallel = best_of(1, [&]() {
+        std::vector<double> copy = data;
+        runtime::sort(par, copy.begin(), copy.end());
+    });
+    print_row("runtime::sort (incl. copy)", parallel, serial);
+    (void)sink;
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << "\n╔════════════════════════════════════════════════════════╗\n";
+    std::cout << "║          Parallel Algorithms Benchmark Suite          ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════╝\n\n";
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+
+    benchmark_chunked_vs_per_index();
+    benchmark_jacobi_affinity();
+    benchmark_schedules();
+    benchmark_adaptive_grain();
+    benchmark_deterministic_reduce();
+    benchmark_iterator_algorithms();
+    benchmark_execution_policy();
+
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include <runtime/thread_pool.h>
+#include <runtime/parallel_sort.h>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+// Sizes run by default; pass larger ones on the command line, e.g.
+//   ./parallel_sort 1000000 10000000 100000000 1000000000
+// (1B 64-bit keys needs ~24 GB: input, reference copy and scratch buffer)
+std::vector<size_t> sizes_from_args(int argc, char* argv[]) {
+    std::vector<size_t> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(static_cast<size_t>(std::strtoull(argv[i], nullptr, 10)));
+    }
+    if (sizes.empty()) sizes = {1000000, 10000000};
+    return sizes;
+}
+
+template<typename F>
+long long time_ms(F&& f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+}
+
+void print_header(const char* serial_name) {
+    std::cout << std::left << std::setw(15) << "Elements"
+              << std::setw(22) << serial_name
+              << std::setw(18) << "parallel (ms)"
+              << std::setw(10) << "Speedup"
+              << "\n";
+    std::cout << std::string(65, '-') << "\n";
+}
+
+void print_row(size_t n, long long serial_ms, long long parallel_ms, bool ok) {
+    double speedup = parallel_ms > 0 ? static_cast<double>(serial_ms) / parallel_ms : 0.0;
+    std::cout << std::setw(15) << n
+              << std::setw(22) << serial_ms
+              << std::setw(18) << parallel_ms
+              << std::fixed << std::setprecision(2) << speedup << "x"
+              << (ok ? "" : "  WRONG RESULT") << "\n";
+}
+
+std::vector<uint64_t> random_keys(size_t n, uint64_t seed, uint64_t range) {
+    std::vector<uint64_t> keys(n);
+    std::mt19937_64 rng(seed);
+    for (auto& k : keys) k = rng() % range;
+    return keys;
+}
+
+void benchmark_stable_sort(runtime::ThreadPool& pool, const std::vector<size_t>& sizes) {
+    std::cout << "=== parallel_stable_sort vs std::stable_sort (uint64 keys) ===\n\n";
+    print_header("std::stable_sort (ms)");
+
+    for (size_t n : sizes) {
+        std::vector<uint64_t> data = random_keys(n, 61, UINT64_MAX);
+        std::vector<uint64_t> reference = data;
+
+        long long serial_ms = time_ms([&]() { std::stable_sort(reference.begin(), reference.end()); });
+        long long parallel_ms = time_ms([&]() {
+            runtime::parallel_stable_sort(pool, data.begin(), data.end());
+        });
+        print_row(n, serial_ms, parallel_ms, data == reference);
+    }
+    std::cout << "\n";
+}
+
+void benchmark_merge(runtime::ThreadPool& pool, const std::vector<size_t>& sizes) {
+    std::cout << "=== parallel_merge vs std::merge (two sorted halves) ===\n\n";
+    print_header("std::merge (ms)");
+
+    for (size_t n : sizes) {
+        std::vector<uint64_t> a = random_keys(n / 2, 62, UINT64_MAX);
+        std::vector<uint64_t> b = random_keys(n - n / 2, 63, UINT64_MAX);
+        std::sort(a.begin(), a.end());
+        std::sort(b.begin(), b.end());
+        std::vector<uint64_t> reference(n), merged(n);
+
+        long long serial_ms = time_ms([&]() {
+            std::merge(a.begin(), a.end(), b.begin(), b.end(), reference.begin());
+        });
+        long long parallel_ms = time_ms([&]() {
+            runtime::parallel_merge(pool, a.begin(), a.end(), b.begin(), b.end(), merged.begin());
+        });
+        print_row(n, serial_ms, parallel_ms, merged == reference);
+    }
+    std::cout << "\n";
+}
+
+void benchmark_partition(runtime::ThreadPool& pool, const std::vector<size_t>& sizes) {
+    std::cout << "=== parallel_partition vs std::stable_partition (keep < 50%) ===\n\n";
+    print_header("std::stable_part (ms)");
+
+    auto below_half = [](uint64_t k) { return k < UINT64_MAX / 2; };
+    for (size_t n : sizes) {
+        std::vector<uint64_t> data = random_keys(n, 64, UINT64_MAX);
+        std::vector<uint64_t> reference = data;
+
+        long long serial_ms = time_ms([&]() {
+            std::stable_partition(reference.begin(), reference.end(), below_half);
+        });
+        long long parallel_ms = time_ms([&]() {
+            runtime::parallel_partition(pool, data.begin(), data.end(), below_half);
+        });
+        print_row(n, serial_ms, parallel_ms, data == reference);
+    }
+    std::cout << "\n";
+}
+
+void benchmark_unique(runtime::ThreadPool& pool, const std::vector<size_t>& sizes) {
+    std::cout << "=== parallel_unique vs std::unique (sorted, ~4 copies per key) ===\n\n";
+    print_header("std::unique (ms)");
+
+    for (size_t n : sizes) {
+        std::vector<uint64_t> data = random_keys(n, 65, std::max<size_t>(1, n / 4));
+        std::sort(data.begin(), data.end());
+        std::vector<uint64_t> reference = data;
+
+        size_t serial_kept = 0, parallel_kept = 0;
+        long long serial_ms = time_ms([&]() {
+            serial_kept = std::unique(reference.begin(), reference.end()) - reference.begin();
+        });
+        long long parallel_ms = time_ms([&]() {
+            parallel_kept = runtime::parallel_unique(pool, data.begin(), data.end()) - data.begin();
+        });
+        bool ok = serial_kept == parallel_kept &&
+                  std::equal(data.begin(), data.begin() + parallel_kept, reference.begin());
+        print_row(n, serial_ms, parallel_ms, ok);
+    }
+    std::cout << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "\n╔════════════════════════════════════════════════════════╗\n";
+    std::cout << "║       Parallel Sort / Merge Benchmark Suite           ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════╝\n\n";
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+
+    std::vector<size_t> sizes = sizes_from_args(argc, argv);
+    runtime::ThreadPool pool;
+
+    benchmark_stable_sort(pool, sizes);
+    benchmark_merge(pool, sizes);
+    benchmark_partition(pool, sizes);
+    benchmark_unique(pool, sizes);
+
+    return 0;
+}
@@ -0,0 +1,151 @@
+#include <runtime/thread_pool.h>
+#include <runtime/shared_queue.h>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <algorithm>
+#include <thread>
+#include <new>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using Clock = std::chrono::high_resolution_clock;
+
+std::string queue_name(const char* what) {
+    return "/runtime_shared_queue_bench_" + std::string(what) + "_" + std::to_string(getpid());
+}
+
+void spin_for(std::chrono::microseconds duration) {
+    auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+// Raw ring cost, no contention: one push and one pop per operation
+void benchmark_ring() {
+    std::cout << "=== Ring Cost (single process) ===\n\n";
+
+    std::cout << std::left << std::setw(36) << "Operation"
+              << std::setw(14) << "ns / op"
+              << "\n";
+    std::cout << std::string(50, '-') << "\n";
+
+    const size_t ops = 1000000;
+    runtime::SharedTaskQueue queue(queue_name("ring"), runtime::SharedTaskQueue::Mode::Create, 1024);
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < ops; ++i) {
+        queue.try_push(1, i);
+        queue.try_pop_with([](uint32_t, const void*, size_t) {});
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / ops;
+    std::cout << std::setw(36) << "try_push + try_pop_with"
+              << std::fixed << std::setprecision(1) << ns << "\n";
+
+    runtime::SharedTaskRegistry registry;
+    size_t sum = 0;
+    registry.add<size_t>(1, [&sum](size_t value) { sum += value; });
+    start = Clock::now();
+    for (size_t i = 0; i < ops; ++i) {
+        queue.try_push(1, i);
+        runtime::Task task;
+        queue.try_pop(registry, task);
+        task();
+    }
+    ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / ops;
+    std::cout << std::setw(36) << "try_push + try_pop(registry) + run"
+              << ns << "\n\n";
+}
+
+// One producer process fills the queue; N worker processes, each with its own
+// single-thread pool attached, drain it
+void benchmark_processes() {
+    std::cout << "=== Load Sharing: 20000 tasks x 20us ===\n\n";
+
+    std::cout << std::left << std::setw(12) << "Processes"
+              << std::setw(14) << "Time (ms)"
+              << std::setw(16) << "Tasks/sec"
+              << std::setw(20) << "Per process min/max"
+              << "\n";
+    std::cout << std::string(62, '-') << "\n";
+
+    const int tasks = 20000;
+    for (int processes : {1, 2, 4}) {
+        runtime::SharedTaskQueue queue(queue_name("share"), runtime::SharedTaskQueue::Mode::Create);
+        void* memory = mmap(nullptr, sizeof(std::atomic<int>) * (processes + 1), PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        auto* counters = static_cast<std::atomic<int>*>(memory);
+        for (int p = 0; p <= processes; ++p) new (&counters[p]) std::atomic<int>(0);
+        std::atomic<int>& done = counters[processes];
+
+        std::vector<pid_t> pids;
+        for (int p = 0; p < processes; ++p) {
+            pid_t child = fork();
+            if (child == 0) {
+                runtime::SharedTaskQueue mine(queue.name(), runtime::SharedTaskQueue::Mode::Open);
+                runtime::SharedTaskRegistry registry;
+                registry.add<int>(1, [&](int) {
+                    spin_for(std::chrono::microseconds(20));
+                    counters[p]++;
+                });
+                runtime::config::ThreadPoolOptions options;
+                options.threads = 1;
+                runtime::ThreadPool pool(options);
+                runtime::attach_shared_queue(pool, mine, registry);
+                while (done.load() == 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                pool.wait();
+                _exit(0);
+            }
+            pids.push_back(child);
+        }
+
+        auto start = Clock::now();
+        for (int i = 0; i < tasks; ++i) {
+            while (!queue.try_push(1, i)) {
+                std::this_thread::yield();
+            }
+        }
+        auto finished = [&]() {
+            int sum = 0;
+            for (int p = 0; p < processes; ++p) sum += counters[p].load();
+            return sum;
+        };
+        while (finished() < tasks) {
+            std::this_thread::yield();
+        }
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        done.store(1);
+        for (pid_t pid : pids) waitpid(pid, nullptr, 0);
+
+        int low = tasks;
+        int high = 0;
+        for (int p = 0; p < processes; ++p) {
+            low = std::min(low, counters[p].load());
+            high = std::max(high, counters[p].load());
+        }
+        std::cout << std::setw(12) << processes
+                  << std::setw(14) << std::fixed << std::setprecision(1) << ms
+                  << std::setw(16) << std::setprecision(0) << tasks / (ms / 1000.0)
+                  << low << " / " << high << "\n";
+        munmap(memory, sizeof(std::atomic<int>) * (processes + 1));
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << "\n╔════════════════════════════════════════════════════════╗\n";
+    std::cout << "║             Shared Queue Benchmark Suite               ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════╝\n\n";
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+
+    benchmark_processes();  // forks: run before this process starts any threads
+    benchmark_ring();
+
+    return 0;
+}
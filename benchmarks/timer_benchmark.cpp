@@ -0,0 +1,105 @@
+#include <runtime/thread_pool.h>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+using Clock = std::chrono::steady_clock;
+
+double ns_per_op(Clock::time_point start, Clock::time_point end, size_t ops) {
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(ops);
+}
+
+// Insert and cancel cost should stay flat as the number of pending timers grows
+void benchmark_insert_cancel() {
+    std::cout << "=== Timer Insert / Cancel Cost ===\n";
+    std::cout << "Deadlines spread over 1 s - 1 h, so every wheel level is populated\n\n";
+
+    std::cout << std::left << std::setw(18) << "Pending timers"
+              << std::setw(20) << "Insert (ns/op)"
+              << std::setw(20) << "Cancel (ns/op)"
+              << "\n";
+    std::cout << std::string(58, '-') << "\n";
+
+    for (size_t n : {10000, 100000, 1000000}) {
+        runtime::ThreadPool pool;
+        std::mt19937_64 rng(64);
+        std::vector<std::chrono::milliseconds> delays(n);
+        for (auto& d : delays) d = std::chrono::milliseconds(1000 + rng() % 3600000);
+
+        std::vector<runtime::TimerHandle> handles;
+        handles.reserve(n);
+        auto start = Clock::now();
+        for (size_t i = 0; i < n; ++i) {
+            handles.push_back(pool.schedule_after(delays[i], []() {}));
+        }
+        auto end = Clock::now();
+        double insert_ns = ns_per_op(start, end, n);
+
+        std::shuffle(handles.begin(), handles.end(), rng);
+        start = Clock::now();
+        for (const auto& handle : handles) {
+            pool.cancel_timer(handle);
+        }
+        end = Clock::now();
+        double cancel_ns = ns_per_op(start, end, n);
+
+        std::cout << std::setw(18) << n
+                  << std::setw(20) << std::fixed << std::setprecision(1) << insert_ns
+                  << std::setw(20) << cancel_ns
+                  << (pool.pending_timers() == 0 ? "" : "  TIMERS LEFT") << "\n";
+    }
+    std::cout << "\n";
+}
+
+// How late timers run relative to their deadline (tick is 1 ms)
+void benchmark_firing_lateness() {
+    std::cout << "=== Firing Lateness ===\n";
+    std::cout << "200k one-shot timers due within 1 s\n\n";
+
+    runtime::ThreadPool pool;
+    const size_t n = 200000;
+    std::vector<int64_t> lateness_us(n);
+    std::atomic<size_t> done{0};
+    std::mt19937 rng(7);
+
+    auto base = Clock::now() + std::chrono::milliseconds(50);
+    for (size_t i = 0; i < n; ++i) {
+        auto deadline = base + std::chrono::microseconds(rng() % 1000000);
+        pool.schedule_at(deadline, [&lateness_us, &done, deadline, i]() {
+            lateness_us[i] = std::chrono::duration_cast<std::chrono::microseconds>(
+                Clock::now() - deadline).count();
+            done.fetch_add(1, std::memory_order_release);
+        });
+    }
+    while (done.load(std::memory_order_acquire) < n) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::sort(lateness_us.begin(), lateness_us.end());
+    std::cout << std::left << std::setw(12) << "min (μs)" << std::setw(12) << "p50 (μs)"
+              << std::setw(12) << "p99 (μs)" << std::setw(12) << "max (μs)" << "\n";
+    std::cout << std::string(48, '-') << "\n";
+    std::cout << std::setw(12) << lateness_us.front()
+              << std::setw(12) << lateness_us[n / 2]
+              << std::setw(12) << lateness_us[n * 99 / 100]
+              << std::setw(12) << lateness_us.back() << "\n";
+    std::cout << "Timers fired: " << pool.stats().timers_fired.load() << "\n\n";
+}
+
+int main() {
+    std::cout << "\n╔════════════════════════════════════════════════════════╗\n";
+    std::cout << "║             Timer Wheel Benchmark Suite               ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════╝\n\n";
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+
+    benchmark_insert_cancel();
+    benchmark_firing_lateness();
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include <runtime/thread_pool.h>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <sys/resource.h>
+
+using Clock = std::chrono::high_resolution_clock;
+
+// Voluntary context switches of the whole process: each one is a worker or
+// producer blocking in futex_wait (or sleeping)
+long context_switches() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_nvcsw;
+}
+
+// At least four workers, so there is always someone to wake
+size_t worker_count() {
+    return std::max<size_t>(4, std::thread::hardware_concurrency());
+}
+
+void busy_work(int iterations) {
+    volatile int sink = 0;
+    for (int i = 0; i < iterations; ++i) sink = sink + i;
+}
+
+void print_header() {
+    std::cout << std::left << std::setw(22) << "Workload"
+              << std::setw(14) << "Time (ms)"
+              << std::setw(16) << "ns / task"
+              << std::setw(18) << "Ctx switches"
+              << std::setw(14) << "Wakeups"
+              << "\n";
+    std::cout << std::string(84, '-') << "\n";
+}
+
+void print_row(const std::string& name, double ms, size_t tasks, long switches, uint64_t wakeups) {
+    std::cout << std::setw(22) << name
+              << std::setw(14) << std::fixed << std::setprecision(1) << ms
+              << std::setw(16) << ms * 1e6 / static_cast<double>(tasks)
+              << std::setw(18) << switches
+              << std::setw(14) << wakeups
+              << "\n";
+}
+
+// One producer keeps the pool busy with small tasks
+void benchmark_steady(runtime::config::IdleStrategy strategy, const char* label) {
+    const size_t tasks = 200000;
+    runtime::config::ThreadPoolOptions options;
+    options.threads = worker_count();
+    options.idle_strategy = strategy;
+    runtime::ThreadPool pool(options);
+
+    long before = context_switches();
+    auto start = Clock::now();
+    for (size_t i = 0; i < tasks; ++i) {
+        pool.submit([]() { busy_work(200); });
+    }
+    pool.wait();
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    print_row(label, ms, tasks, context_switches() - before, pool.stats().worker_wakeups.load());
+}
+
+// Bursts of work arriving at an idle pool: every worker should join in
+void benchmark_bursts(bool batch, const char* label) {
+    const size_t bursts = 200;
+    const size_t burst_size = 64;
+    runtime::config::ThreadPoolOptions options;
+    options.threads = worker_count();
+    runtime::ThreadPool pool(options);
+
+    long before = context_switches();
+    auto start = Clock::now();
+    for (size_t b = 0; b < bursts; ++b) {
+        if (batch) {
+            std::vector<runtime::Task> group;
+            for (size_t i = 0; i < burst_size; ++i) group.emplace_back([]() { busy_work(20000); });
+            pool.submit_batch(group);
+        } else {
+            for (size_t i = 0; i < burst_size; ++i) pool.submit([]() { busy_work(20000); });
+        }
+        pool.wait();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));  // workers park
+    }
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count() - bursts * 2.0;
+    print_row(label, ms, bursts * burst_size, context_switches() - before, pool.stats().worker_wakeups.load());
+}
+
+int main() {
+    std::cout << "\n╔════════════════════════════════════════════════════════╗\n";
+    std::cout << "║               Wakeup Benchmark Suite                   ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════╝\n\n";
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency()
+              << ", workers: " << worker_count() << "\n\n";
+
+    std::cout << "=== Steady Load: 200k small tasks from one producer ===\n\n";
+    print_header();
+    benchmark_steady(runtime::config::IdleStrategy::ParkImmediately, "park immediately");
+    benchmark_steady(runtime::config::IdleStrategy::SpinThenPark, "spin then park");
+    std::cout << "\n";
+
+    std::cout << "=== Bursts: 200 x 64 tasks into an idle pool ===\n\n";
+    print_header();
+    benchmark_bursts(false, "submit x 64");
+    benchmark_bursts(true, "submit_batch (64)");
+    std::cout << "\n";
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+#ifndef ADAPTIVE_GRAIN_H
+#define ADAPTIVE_GRAIN_H
+
+#include <runtime/config.h>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstddef>
+
+namespace runtime {
+namespace detail {
+
+// Cost history for one loop body type: an EWMA of nanoseconds per
+// iteration. Every lambda expression has its own type, so this is
+// effectively one estimate per call site; 0 means "not measured yet".
+template<typename Body>
+std::atomic<double>& grain_cost_estimate() {
+    static std::atomic<double> ns_per_iteration{0.0};
+    return ns_per_iteration;
+}
+
+// Fold a new sample into the average. Concurrent updates may drop a
+// sample, which only slows convergence.
+inline void record_grain_cost(std::atomic<double>& estimate, double ns_per_iteration) {
+    if (ns_per_iteration <= 0.0) ns_per_iteration = 0.1;
+    double old = estimate.load(std::memory_order_relaxed);
+    double updated = old == 0.0
+        ? ns_per_iteration
+        : old + config::parallel_alg::grain_ewma_alpha * (ns_per_iteration - old);
+    estimate.store(updated, std::memory_order_relaxed);
+}
+
+inline double elapsed_ns(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - since).count();
+}
+
+// Run the first iterations serially in doubling batches until about a
+// quarter of the target duration has elapsed, and record the measured cost.
+// run(first_offset, last_offset) executes a batch. Returns iterations done.
+template<typename RunFn>
+size_t probe_grain_cost(size_t range, RunFn&& run, std::atomic<double>& estimate, double target_ns) {
+    auto begin = std::chrono::steady_clock::now();
+    size_t done = 0;
+    size_t batch = 1;
+    double elapsed = 0.0;
+
+    while (done < range) {
+        size_t n = std::min(batch, range - done);
+        run(done, done + n);
+        done += n;
+        elapsed = elapsed_ns(begin);
+        if (elapsed >= target_ns / 4) break;
+        batch *= 2;
+    }
+
+    record_grain_cost(estimate, elapsed / static_cast<double>(done));
+    return done;
+}
+
+// Chunk size that makes one chunk take about target_ns, but never so large
+// that fewer chunks than workers remain
+inline size_t adaptive_chunk_size(double ns_per_iteration, size_t remaining, size_t workers,
+                                  double target_ns) {
+    size_t chunk = static_cast<size_t>(target_ns / std::max(ns_per_iteration, 0.1));
+    size_t per_worker = (remaining + workers - 1) / workers;
+    return std::max<size_t>(1, std::min(chunk, per_worker));
+}
+
+} // namespace detail
+} // namespace runtime
+
+#endif // ADAPTIVE_GRAIN_H
@@ -0,0 +1,139 @@
+#ifndef ASYNC_SYNC_H
+#define ASYNC_SYNC_H
+
+#include <runtime/thread_pool.h>
+#include <runtime/task.h>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <utility>
+
+namespace runtime {
+
+// Synchronisation primitives for pool tasks that never block a worker.
+// Instead of waiting, a task hands over a continuation: the rest of its
+// work, to run once the mutex / permit / latch / barrier phase is available.
+// Waiting continuations are queued inside the primitive. The thread that
+// releases it pushes them onto its own deque with submit_local, so they
+// tend to run next on the releaser's warm cache, and idle workers steal them.
+//
+// A continuation that can proceed at once runs inline on the caller.
+// The pool must outlive the primitive.
+
+// Mutual exclusion: the continuation passed to lock() runs holding the
+// mutex and must call unlock() (or use run_locked, which does). Ownership
+// passes to waiters in FIFO order, so a stream of lockers cannot starve one.
+class AsyncMutex {
+    public:
+        explicit AsyncMutex(ThreadPool& pool) : pool_(pool) {}
+
+        AsyncMutex(const AsyncMutex&) = delete;
+        AsyncMutex& operator=(const AsyncMutex&) = delete;
+
+        void lock(Task on_locked);
+        bool try_lock();
+        void unlock();
+
+        // Run f holding the mutex, unlocking afterwards (also if f throws)
+        template<typename F>
+        void run_locked(F&& f);
+
+    private:
+        ThreadPool& pool_;
+        std::mutex mutex_;  // guards the fields below; held only briefly
+        bool locked_ = false;
+        std::deque<Task> waiters_;
+};
+
+// Counting semaphore: the continuation passed to acquire() runs holding
+// one permit and must give it back with release().
+class AsyncSemaphore {
+    public:
+        AsyncSemaphore(ThreadPool& pool, size_t permits) : pool_(pool), permits_(permits) {}
+
+        AsyncSemaphore(const AsyncSemaphore&) = delete;
+        AsyncSemaphore& operator=(const AsyncSemaphore&) = delete;
+
+        void acquire(Task on_acquired);
+        bool try_acquire();
+        void release(size_t n = 1);
+        size_t available() const;
+
+    private:
+        ThreadPool& pool_;
+        mutable std::mutex mutex_;
+        size_t permits_;
+        std::deque<Task> waiters_;
+};
+
+// Single-use countdown: continuations registered with async_wait run once
+// the count reaches zero (immediately if it already has).
+class Latch {
+    public:
+        Latch(ThreadPool& pool, size_t count) : pool_(pool), count_(count) {}
+
+        Latch(const Latch&) = delete;
+        Latch& operator=(const Latch&) = delete;
+
+        void count_down(size_t n = 1);
+        void async_wait(Task continuation);
+        bool try_wait() const { return count_.load(std::memory_order_acquire) == 0; }
+        // Block until the count reaches zero. Safe to call from a pool task:
+        // the caller runs other pool work while it waits (a fiber suspends).
+        void wait();
+
+    private:
+        ThreadPool& pool_;
+        std::mutex mutex_;
+        std::atomic<size_t> count_;
+        std::vector<Task> waiters_;
+};
+
+// Reusable barrier for `expected` participants. Each arrives with its
+// continuation; when the last one of a phase arrives, on_phase_completion
+// (if any) runs on that thread and then every continuation of the phase
+// is scheduled. If on_phase_completion throws, the continuations are still
+// scheduled and the exception propagates from that last arrive(). It runs
+// outside the barrier's lock: participants that arrive again without
+// waiting for their continuation can reach the next phase meanwhile.
+class Barrier {
+    public:
+        Barrier(ThreadPool& pool, size_t expected, Task on_phase_completion = {});
+
+        Barrier(const Barrier&) = delete;
+        Barrier& operator=(const Barrier&) = delete;
+
+        void arrive(Task continuation);
+        // Leave the barrier: this and every later phase expect one participant fewer
+        void arrive_and_drop();
+        // Number of completed phases
+        size_t phase() const;
+
+    private:
+        void complete_phase(std::unique_lock<std::mutex>& lock);
+
+        ThreadPool& pool_;
+        mutable std::mutex mutex_;
+        size_t expected_;
+        size_t phase_ = 0;
+        std::vector<Task> arrived_;
+        Task on_phase_completion_;
+};
+
+template<typename F>
+void AsyncMutex::run_locked(F&& f) {
+    lock([this, f = std::forward<F>(f)]() mutable {
+        try {
+            f();
+        } catch (...) {
+            unlock();
+            throw;
+        }
+        unlock();
+    });
+}
+
+} // namespace runtime
+
+#endif // ASYNC_SYNC_H
@@ -0,0 +1,148 @@
+#ifndef BLOCKED_RANGE_H
+#define BLOCKED_RANGE_H
+
+#include <cstddef>
+
+namespace runtime {
+
+// One-dimensional half-open range [begin, end) that may be split in two
+// while it holds more than grainsize elements.
+template<typename Value>
+class blocked_range {
+    public:
+        using value_type = Value;
+
+        blocked_range(Value begin, Value end, size_t grainsize = 1)
+            : begin_(begin), end_(end), grainsize_(grainsize == 0 ? 1 : grainsize) {}
+
+        Value begin() const { return begin_; }
+        Value end() const { return end_; }
+        size_t grainsize() const { return grainsize_; }
+
+        size_t size() const {
+            return end_ > begin_ ? static_cast<size_t>(end_ - begin_) : 0;
+        }
+        bool empty() const { return !(begin_ < end_); }
+        bool is_divisible() const { return size() > grainsize_; }
+
+        // Keep the lower half in *this and return the upper half
+        blocked_range split() {
+            Value mid = begin_ + static_cast<Value>(size() / 2);
+            blocked_range upper(mid, end_, grainsize_);
+            end_ = mid;
+            return upper;
+        }
+
+    private:
+        Value begin_;
+        Value end_;
+        size_t grainsize_;
+};
+
+// Two-dimensional tile: rows x cols, each with its own grain size.
+// Splits along whichever dimension is largest relative to its grain so
+// tiles stay roughly square in units of grain.
+template<typename RowValue, typename ColValue = RowValue>
+class blocked_range2d {
+    public:
+        using row_range_type = blocked_range<RowValue>;
+        using col_range_type = blocked_range<ColValue>;
+
+        blocked_range2d(RowValue row_begin, RowValue row_end, size_t row_grainsize,
+                        ColValue col_begin, ColValue col_end, size_t col_grainsize)
+            : rows_(row_begin, row_end, row_grainsize),
+              cols_(col_begin, col_end, col_grainsize) {}
+
+        blocked_range2d(RowValue row_begin, RowValue row_end,
+                        ColValue col_begin, ColValue col_end)
+            : rows_(row_begin, row_end), cols_(col_begin, col_end) {}
+
+        const row_range_type& rows() const { return rows_; }
+        const col_range_type& cols() const { return cols_; }
+
+        bool empty() const { return rows_.empty() || cols_.empty(); }
+        bool is_divisible() const { return rows_.is_divisible() || cols_.is_divisible(); }
+
+        blocked_range2d split() {
+            blocked_range2d upper(*this);
+            if (split_rows()) {
+                upper.rows_ = rows_.split();
+            } else {
+                upper.cols_ = cols_.split();
+            }
+            return upper;
+        }
+
+    private:
+        bool split_rows() const {
+            if (!cols_.is_divisible()) return true;
+            if (!rows_.is_divisible()) return false;
+            // rows.size / rows.grain >= cols.size / cols.grain, without division
+            return rows_.size() * cols_.grainsize() >= cols_.size() * rows_.grainsize();
+        }
+
+        row_range_type rows_;
+        col_range_type cols_;
+};
+
+// Three-dimensional tile: pages x rows x cols, split along the dimension
+// that is largest relative to its grain.
+template<typename PageValue, typename RowValue = PageValue, typename ColValue = RowValue>
+class blocked_range3d {
+    public:
+        using page_range_type = blocked_range<PageValue>;
+        using row_range_type = blocked_range<RowValue>;
+        using col_range_type = blocked_range<ColValue>;
+
+        blocked_range3d(PageValue page_begin, PageValue page_end, size_t page_grainsize,
+                        RowValue row_begin, RowValue row_end, size_t row_grainsize,
+                        ColValue col_begin, ColValue col_end, size_t col_grainsize)
+            : pages_(page_begin, page_end, page_grainsize),
+              rows_(row_begin, row_end, row_grainsize),
+              cols_(col_begin, col_end, col_grainsize) {}
+
+        blocked_range3d(PageValue page_begin, PageValue page_end,
+                        RowValue row_begin, RowValue row_end,
+                        ColValue col_begin, ColValue col_end)
+            : pages_(page_begin, page_end), rows_(row_begin, row_end), cols_(col_begin, col_end) {}
+
+        const page_range_type& pages() const { return pages_; }
+        const row_range_type& rows() const { return rows_; }
+        const col_range_type& cols() const { return cols_; }
+
+        bool empty() const { return pages_.empty() || rows_.empty() || cols_.empty(); }
+        bool is_divisible() const {
+            return pages_.is_divisible() || rows_.is_divisible() || cols_.is_divisible();
+        }
+
+        blocked_range3d split() {
+            blocked_range3d upper(*this);
+            // Compare size/grain ratios by cross-multiplying; dimensions that
+            // can no longer be split never win.
+            auto weight = [](const auto& r, size_t other_grain) -> size_t {
+                return r.is_divisible() ? r.size() * other_grain : 0;
+            };
+            size_t pg = pages_.grainsize(), rg = rows_.grainsize(), cg = cols_.grainsize();
+            size_t p = weight(pages_, rg * cg);
+            size_t r = weight(rows_, pg * cg);
+            size_t c = weight(cols_, pg * rg);
+
+            if (p >= r && p >= c) {
+                upper.pages_ = pages_.split();
+            } else if (r >= c) {
+                upper.rows_ = rows_.split();
+            } else {
+                upper.cols_ = cols_.split();
+            }
+            return upper;
+        }
+
+    private:
+        page_range_type pages_;
+        row_range_type rows_;
+        col_range_type cols_;
+};
+
+} // namespace runtime
+
+#endif // BLOCKED_RANGE_H
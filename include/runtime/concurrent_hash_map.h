@@ -0,0 +1,247 @@
+#ifndef CONCURRENT_HASH_MAP_H
+#define CONCURRENT_HASH_MAP_H
+
+#include <runtime/thread_pool.h>
+#include <runtime/parallel_for.h>
+#include <runtime/config.h>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <utility>
+#include <cstdint>
+#include <algorithm>
+
+namespace runtime {
+
+// Hash map for concurrent use from tasks (e.g. building group-by tables
+// inside parallel_for). Keys are spread over independently locked segments
+// by the high bits of their hash; each segment is an open-addressing table
+// with linear probing that grows on its own. Writers to different segments
+// never contend, and a segment's critical section is a short probe.
+//
+// K and V must be default constructible and copy/move assignable.
+// There is no erase; clear() is not safe concurrently with other calls.
+template<typename K, typename V,
+         typename Hash = std::hash<K>,
+         typename KeyEqual = std::equal_to<K>>
+class ConcurrentHashMap {
+    public:
+        explicit ConcurrentHashMap(size_t segments = config::containers::hash_map_segments,
+                                   size_t initial_capacity = 0)
+            : segment_count_(round_up_pow2(segments == 0 ? 1 : segments)),
+              segment_shift_(64 - log2(segment_count_)),
+              segments_(new Segment[segment_count_]) {
+            size_t per_segment = initial_capacity / segment_count_;
+            for (size_t i = 0; i < segment_count_; ++i) {
+                segments_[i].reset(round_up_pow2(std::max<size_t>(min_segment_capacity,
+                                                                  per_segment * 4 / 3 + 1)));
+            }
+        }
+
+        ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+        ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+        // Insert value if key is absent, otherwise call update(existing_value).
+        // update runs under the segment lock and must not touch this map.
+        // Returns true if the key was inserted.
+        template<typename Update>
+        bool insert_or_update(const K& key, V value, Update&& update) {
+            uint64_t h = hash_of(key);
+            Segment& seg = segment_for(h);
+            std::lock_guard<std::mutex> lock(seg.mutex);
+
+            size_t slot = seg.probe(h, key, equal_);
+            if (seg.used[slot]) {
+                update(seg.entries[slot].second);
+                return false;
+            }
+            seg.place(slot, h, key, std::move(value));
+            if (seg.needs_growth()) seg.grow();
+            return true;
+        }
+
+        // Insert, or overwrite the existing value. Returns true if inserted.
+        bool insert_or_assign(const K& key, V value) {
+            return insert_or_update(key, value, [&value](V& existing) { existing = std::move(value); });
+        }
+
+        // Insert only if absent. Returns true if inserted.
+        bool insert(const K& key, V value) {
+            return insert_or_update(key, std::move(value), [](V&) {});
+        }
+
+        // Copy the value for key into out; returns false if absent
+        bool find(const K& key, V& out) const {
+            uint64_t h = hash_of(key);
+            const Segment& seg = segment_for(h);
+            std::lock_guard<std::mutex> lock(seg.mutex);
+
+            size_t slot = seg.probe(h, key, equal_);
+            if (!seg.used[slot]) return false;
+            out = seg.entries[slot].second;
+            return true;
+        }
+
+        bool contains(const K& key) const {
+            V ignored;
+            return find(key, ignored);
+        }
+
+        size_t size() const {
+            size_t total = 0;
+            for (size_t i = 0; i < segment_count_; ++i) {
+                total += segments_[i].count.load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+
+        bool empty() const { return size() == 0; }
+        size_t segment_count() const { return segment_count_; }
+
+        void clear() {
+            for (size_t i = 0; i < segment_count_; ++i) {
+                std::lock_guard<std::mutex> lock(segments_[i].mutex);
+                segments_[i].reset(min_segment_capacity);
+            }
+        }
+
+        // Visit every entry as func(const K&, V&), one segment at a time
+        template<typename Func>
+        void for_each(Func&& func) {
+            for (size_t i = 0; i < segment_count_; ++i) {
+                visit_segment(i, func);
+            }
+        }
+
+        // Visit every entry in parallel; each task owns a run of whole
+        // segments, so func may modify values without extra locking
+        template<typename Func>
+        void parallel_for_each(ThreadPool& pool, Func&& func) {
+            runtime::parallel_for_chunked(pool, size_t(0), segment_count_,
+                [this, &func](size_t first, size_t last) {
+                    for (size_t i = first; i < last; ++i) {
+                        visit_segment(i, func);
+                    }
+                }, std::max<size_t>(1, segment_count_ / (pool.thread_count() * 4)));
+        }
+
+    private:
+        static constexpr size_t min_segment_capacity = 16;
+
+        struct alignas(64) Segment {
+            mutable std::mutex mutex;
+            std::vector<std::pair<K, V>> entries;
+            std::vector<uint64_t> hashes;
+            std::vector<uint8_t> used;
+            std::atomic<size_t> count{0};
+            size_t mask = 0;
+
+            void reset(size_t capacity) {
+                entries.assign(capacity, std::pair<K, V>());
+                hashes.assign(capacity, 0);
+                used.assign(capacity, 0);
+                count.store(0, std::memory_order_relaxed);
+                mask = capacity - 1;
+            }
+
+            // Slot holding key, or the empty slot where it would go
+            size_t probe(uint64_t h, const K& key, const KeyEqual& equal) const {
+                size_t slot = static_cast<size_t>(h) & mask;
+                while (used[slot] && !(hashes[slot] == h && equal(entries[slot].first, key))) {
+                    slot = (slot + 1) & mask;
+                }
+                return slot;
+            }
+
+            void place(size_t slot, uint64_t h, const K& key, V value) {
+                entries[slot].first = key;
+                entries[slot].second = std::move(value);
+                hashes[slot] = h;
+                used[slot] = 1;
+                count.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            // Keep load factor <= 3/4
+            bool needs_growth() const {
+                return count.load(std::memory_order_relaxed) * 4 > (mask + 1) * 3;
+            }
+
+            void grow() {
+                std::vector<std::pair<K, V>> old_entries;
+                std::vector<uint64_t> old_hashes;
+                std::vector<uint8_t> old_used;
+                old_entries.swap(entries);
+                old_hashes.swap(hashes);
+                old_used.swap(used);
+
+                size_t capacity = old_used.size() * 2;
+                entries.resize(capacity);
+                hashes.assign(capacity, 0);
+                used.assign(capacity, 0);
+                mask = capacity - 1;
+
+                for (size_t i = 0; i < old_used.size(); ++i) {
+                    if (!old_used[i]) continue;
+                    size_t slot = static_cast<size_t>(old_hashes[i]) & mask;
+                    while (used[slot]) slot = (slot + 1) & mask;
+                    entries[slot] = std::move(old_entries[i]);
+                    hashes[slot] = old_hashes[i];
+                    used[slot] = 1;
+                }
+            }
+        };
+
+        template<typename Func>
+        void visit_segment(size_t index, Func& func) {
+            Segment& seg = segments_[index];
+            std::lock_guard<std::mutex> lock(seg.mutex);
+            for (size_t slot = 0; slot < seg.used.size(); ++slot) {
+                if (seg.used[slot]) {
+                    func(static_cast<const K&>(seg.entries[slot].first), seg.entries[slot].second);
+                }
+            }
+        }
+
+        // std::hash is often the identity for integers; mix so both the
+        // segment bits (high) and slot bits (low) are well distributed
+        uint64_t hash_of(const K& key) const {
+            uint64_t h = static_cast<uint64_t>(hasher_(key));
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return h;
+        }
+
+        Segment& segment_for(uint64_t h) {
+            return segments_[segment_count_ == 1 ? 0 : static_cast<size_t>(h >> segment_shift_)];
+        }
+        const Segment& segment_for(uint64_t h) const {
+            return segments_[segment_count_ == 1 ? 0 : static_cast<size_t>(h >> segment_shift_)];
+        }
+
+        static size_t round_up_pow2(size_t n) {
+            size_t p = 1;
+            while (p < n) p <<= 1;
+            return p;
+        }
+
+        static unsigned log2(size_t pow2) {
+            unsigned bits = 0;
+            while ((size_t(1) << bits) < pow2) ++bits;
+            return bits;
+        }
+
+        size_t segment_count_;
+        unsigned segment_shift_;
+        std::unique_ptr<Segment[]> segments_;
+        Hash hasher_;
+        KeyEqual equal_;
+};
+
+} // namespace runtime
+
+#endif // CONCURRENT_HASH_MAP_H
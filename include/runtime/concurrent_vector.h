@@ -0,0 +1,206 @@
+#ifndef CONCURRENT_VECTOR_H
+#define CONCURRENT_VECTOR_H
+
+#include <runtime/thread_pool.h>
+#include <runtime/parallel_for.h>
+#include <runtime/blocked_range.h>
+#include <runtime/config.h>
+#include <atomic>
+#include <new>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+
+namespace runtime {
+
+// Growable vector that many tasks can append to at once.
+// Storage is a list of segments whose sizes double (first_segment_size,
+// first_segment_size, 2x, 4x, ...), so growing never moves existing
+// elements: indices and references stay valid for the vector's lifetime.
+// push_back/grow_by allocate any missing segment with one compare-exchange,
+// then claim indices with another; nothing takes a lock. Segments exist
+// before their indices are claimed, so a failed allocation (std::bad_alloc)
+// leaves the vector unchanged.
+//
+// An element may be read once the push_back that created it has returned
+// (in the pushing task, or in any task ordered after it, e.g. after the
+// parallel_for that appended it). Element construction must not throw.
+template<typename T>
+class ConcurrentVector {
+    public:
+        explicit ConcurrentVector(size_t first_segment_size = config::containers::vector_first_segment)
+            : first_segment_(round_up_pow2(first_segment_size == 0 ? 1 : first_segment_size)),
+              first_shift_(log2(first_segment_)) {
+            for (auto& segment : segments_) {
+                segment.store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        ~ConcurrentVector() {
+            clear();
+        }
+
+        ConcurrentVector(const ConcurrentVector&) = delete;
+        ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+        // Append and return the new element's index
+        size_t push_back(const T& value) { return emplace_back(value); }
+        size_t push_back(T&& value) { return emplace_back(std::move(value)); }
+
+        template<typename... Args>
+        size_t emplace_back(Args&&... args) {
+            size_t index = claim(1);
+            construct(index, std::forward<Args>(args)...);
+            return index;
+        }
+
+        // Append n copies of value and return the index of the first one
+        size_t grow_by(size_t n, const T& value = T()) {
+            size_t first = claim(n);
+            for (size_t i = first; i < first + n; ++i) {
+                construct(i, value);
+            }
+            return first;
+        }
+
+        T& operator[](size_t index) { return *slot(index); }
+        const T& operator[](size_t index) const { return *slot(index); }
+
+        // Number of claimed indices (elements still being constructed included)
+        size_t size() const { return size_.load(std::memory_order_acquire); }
+        bool empty() const { return size() == 0; }
+
+        // Range over the current indices for parallel_for(pool, range, body)
+        blocked_range<size_t> range(size_t grainsize = config::parallel_alg::chunk_size) const {
+            return blocked_range<size_t>(0, size(), grainsize);
+        }
+
+        // Call func(element) for indices [first, last), walking each segment
+        // as a contiguous array
+        template<typename Func>
+        void for_each_in(size_t first, size_t last, Func&& func) {
+            while (first < last) {
+                size_t seg = segment_of(first);
+                size_t seg_begin = segment_begin(seg);
+                size_t seg_end = std::min(last, seg_begin + segment_capacity(seg));
+                T* base = segments_[seg].load(std::memory_order_acquire);
+                for (size_t i = first; i < seg_end; ++i) {
+                    func(base[i - seg_begin]);
+                }
+                first = seg_end;
+            }
+        }
+
+        // Call func(element) for every element in parallel
+        template<typename Func>
+        void parallel_for_each(ThreadPool& pool, Func&& func,
+                               size_t chunk_size = config::parallel_alg::chunk_size) {
+            runtime::parallel_for_chunked(pool, size_t(0), size(), [this, &func](size_t first, size_t last) {
+                for_each_in(first, last, func);
+            }, chunk_size);
+        }
+
+        // Destroy all elements and release storage. Not safe concurrently with other calls.
+        void clear() {
+            size_t count = size_.exchange(0, std::memory_order_acq_rel);
+            for (size_t seg = 0; seg < max_segments; ++seg) {
+                T* base = segments_[seg].exchange(nullptr, std::memory_order_acq_rel);
+                if (!base) continue;
+                size_t begin = segment_begin(seg);
+                size_t end = std::min(count, begin + segment_capacity(seg));
+                for (size_t i = begin; i < end; ++i) {
+                    base[i - begin].~T();
+                }
+                deallocate_segment(base);
+            }
+        }
+
+    private:
+        static constexpr size_t max_segments = 48;
+
+        // Claim indices [first, first + n) once the segments holding them
+        // exist. Allocation happens here, where it may throw, and never
+        // after an index is taken.
+        size_t claim(size_t n) {
+            size_t first = size_.load(std::memory_order_relaxed);
+            while (true) {
+                for (size_t i = first; i < first + n; i = segment_begin(segment_of(i) + 1)) {
+                    ensure_segment(segment_of(i));
+                }
+                if (size_.compare_exchange_weak(first, first + n, std::memory_order_relaxed)) {
+                    return first;
+                }
+            }
+        }
+
+        // The segment exists: claim() allocated it
+        template<typename... Args>
+        void construct(size_t index, Args&&... args) noexcept {
+            new (slot(index)) T(std::forward<Args>(args)...);
+        }
+
+        // Allocate segment seg if nobody has yet; losers of the race free theirs
+        void ensure_segment(size_t seg) {
+            T* base = segments_[seg].load(std::memory_order_acquire);
+            if (base) return;
+
+            T* fresh = static_cast<T*>(::operator new(segment_capacity(seg) * sizeof(T),
+                                                      std::align_val_t(alignof(T))));
+            if (!segments_[seg].compare_exchange_strong(base, fresh, std::memory_order_acq_rel)) {
+                deallocate_segment(fresh);
+            }
+        }
+
+        static void deallocate_segment(T* base) {
+            ::operator delete(static_cast<void*>(base), std::align_val_t(alignof(T)));
+        }
+
+        T* slot(size_t index) const {
+            size_t seg = segment_of(index);
+            return segments_[seg].load(std::memory_order_acquire) + (index - segment_begin(seg));
+        }
+
+        // Segment 0 holds [0, F), segment k >= 1 holds [F << (k-1), F << k)
+        size_t segment_of(size_t index) const {
+            size_t scaled = index >> first_shift_;
+            return scaled == 0 ? 0 : highest_bit(scaled) + 1;
+        }
+        size_t segment_begin(size_t seg) const {
+            return seg == 0 ? 0 : first_segment_ << (seg - 1);
+        }
+        size_t segment_capacity(size_t seg) const {
+            return seg == 0 ? first_segment_ : first_segment_ << (seg - 1);
+        }
+
+        static size_t highest_bit(size_t n) {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<size_t>(63 - __builtin_clzll(static_cast<unsigned long long>(n)));
+#else
+            size_t bit = 0;
+            while (n >>= 1) ++bit;
+            return bit;
+#endif
+        }
+
+        static size_t round_up_pow2(size_t n) {
+            size_t p = 1;
+            while (p < n) p <<= 1;
+            return p;
+        }
+
+        static unsigned log2(size_t pow2) {
+            unsigned bits = 0;
+            while ((size_t(1) << bits) < pow2) ++bits;
+            return bits;
+        }
+
+        const size_t first_segment_;
+        const unsigned first_shift_;
+        std::atomic<size_t> size_{0};
+        std::atomic<T*> segments_[max_segments];
+};
+
+} // namespace runtime
+
+#endif // CONCURRENT_VECTOR_H
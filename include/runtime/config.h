@@ -1,8 +1,12 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
+#include <runtime/task.h>
 #include <thread>
 #include <chrono>
+#include <functional>
+#include <string>
+#include <cstdint>
 
 namespace runtime {
 namespace config {
@@ -21,9 +25,23 @@ inline size_t default_threads() {
 // Maximum number of victims to try stealing from before sleeping
 inline constexpr int steal_attempts = 4;
 
-// Idle sleep duration when no tasks are available
+// Idle sleep duration when no tasks are available; also the longest park
+// under IdleStrategy::SpinThenPark
 inline constexpr std::chrono::milliseconds idle_sleep{1};
 
+// Failed sweeps an idle worker spins through (pausing between them) before
+// it yields or parks; the upper bound when spinning adapts
+inline constexpr size_t idle_spins = 64;
+
+// CPU pause instructions between two spinning sweeps
+inline constexpr unsigned spin_pauses = 32;
+
+// Sweeps with a sched_yield between them after spinning, before parking
+inline constexpr size_t idle_yields = 8;
+
+// First park timeout under SpinThenPark; doubles per park up to idle_sleep
+inline constexpr std::chrono::microseconds park_backoff_min{50};
+
 } // namespace worker
 
 // ==============================
@@ -34,8 +52,34 @@ namespace queue {
 // Maximum number of tasks per thread queue to prevent memory blow-up
 inline constexpr size_t max_tasks = 1 << 16;
 
+// Most deque blocks a queue fetches from its upstream resource at once when
+// its storage comes from huge pages. This only bounds how far one refill
+// overshoots; nothing is unmapped when a queue drains (see huge_pages.h).
+inline constexpr size_t upstream_chunk_blocks = 128;
+
 } // namespace queue
 
+// ==============================
+// Backpressure Configuration
+// ==============================
+namespace backpressure {
+
+// Cap on unfinished tasks (queued + running) before producers outside the
+// pool are held back; 0 means unbounded
+inline constexpr size_t max_pending_tasks = 0;
+
+// Timeout value meaning "wait until there is room, however long it takes"
+inline constexpr std::chrono::milliseconds wait_forever = std::chrono::milliseconds::max();
+
+// How long submit() parks a producer on a full pool before rejecting the task
+inline constexpr std::chrono::milliseconds submit_timeout = wait_forever;
+
+} // namespace backpressure
+
+// Called on the producer's thread with a task submit() could not enqueue
+// in time; it may run the task itself, drop it, log it or throw
+using RejectionHandler = std::function<void(Task)>;
+
 // ==============================
 // Parallel Algorithm Configuration
 // ==============================
@@ -44,8 +88,142 @@ namespace parallel_alg {
 // Number of tasks per chunk for parallel_for or parallel_reduce
 inline constexpr int chunk_size = 1024;
 
+// Boundary (in bytes) that chunked loops align their chunks to
+inline constexpr size_t cache_line_size = 64;
+
+// Pass as chunk_size to let parallel_for / parallel_reduce pick the chunk
+// size from measured per-iteration cost
+inline constexpr size_t auto_chunk = 0;
+
+// Wall time an adaptively sized chunk aims for
+inline constexpr std::chrono::microseconds target_chunk_duration{30};
+
+// Weight of the newest sample in the per-call-site cost average
+inline constexpr double grain_ewma_alpha = 0.25;
+
+// Ranges at or below this size are sorted / merged serially
+inline constexpr size_t sort_grain = 4096;
+
+// Tasks per worker a range-based parallel_for splits into; each task walks
+// its part's grain-sized tiles itself
+inline constexpr size_t range_tasks_per_thread = 8;
+
 } // namespace parallel_alg
 
+// ==============================
+// Concurrent Container Configuration
+// ==============================
+namespace containers {
+
+// Independently locked segments in a ConcurrentHashMap (rounded up to a power of two)
+inline constexpr size_t hash_map_segments = 64;
+
+// Elements in a ConcurrentVector's first segment; later segments double
+inline constexpr size_t vector_first_segment = 1024;
+
+} // namespace containers
+
+// ==============================
+// Executor Configuration
+// ==============================
+
+namespace executor {
+
+// Tasks a LimitedExecutor / SerialExecutor runner executes before it
+// requeues itself on the pool, so one busy executor cannot hog a worker
+inline constexpr size_t runner_batch = 64;
+
+} // namespace executor
+
+// ==============================
+// Timer Configuration
+// ==============================
+
+namespace timer {
+
+// Resolution of the timing wheel; timers fire on the first tick at or after their deadline
+inline constexpr std::chrono::milliseconds tick{1};
+
+// Wheel geometry: levels x 2^slot_bits slots. Level k spans 2^(slot_bits * (k + 1))
+// ticks, so 4 levels of 256 slots reach 2^32 ms (~49 days) before clamping.
+inline constexpr unsigned slot_bits = 8;
+inline constexpr unsigned levels = 4;
+
+} // namespace timer
+
+// ==============================
+// Fiber Configuration
+// ==============================
+
+namespace fiber {
+
+// Usable stack per fiber; a PROT_NONE guard page below it turns an
+// overflow into a fault instead of silent corruption
+inline constexpr size_t stack_size = 256 * 1024;
+
+// Stacks each worker keeps for reuse instead of unmapping them
+inline constexpr size_t stack_cache = 16;
+
+// Spawn fibers (continuation.h) each worker keeps for reuse with their stacks.
+// A spawn recursion needs one per level, so this is sized for the depth of
+// typical recursive workloads rather than for suspended fibers
+inline constexpr size_t spawn_fiber_cache = 128;
+
+} // namespace fiber
+
+// ==============================
+// Task Arena Configuration
+// ==============================
+
+namespace arena {
+
+// Bytes of bump-allocated scratch memory per worker (see task_arena.h);
+// 0 sends every task_arena() allocation to the heap
+inline constexpr size_t capacity = 256 * 1024;
+
+} // namespace arena
+
+// ==============================
+// Huge Page Configuration
+// ==============================
+
+namespace huge_pages {
+
+// Size of one huge page, and of each region the runtime carves its
+// internal allocations out of when huge pages are on (see huge_pages.h)
+inline constexpr size_t page_size = 2 * 1024 * 1024;
+
+} // namespace huge_pages
+
+// ==============================
+// Shared-Memory Queue Configuration
+// ==============================
+
+namespace shared_queue {
+
+// Slots in a SharedTaskQueue ring (rounded up to a power of two)
+inline constexpr size_t capacity = 4096;
+
+// Bytes of POD payload one shared task descriptor carries (256-byte slots)
+inline constexpr size_t payload_size = 240;
+
+} // namespace shared_queue
+
+// ==============================
+// Distributed Node Configuration
+// ==============================
+
+namespace distributed {
+
+// Most tasks one steal request takes from a peer (it takes half the peer's
+// queue, up to this)
+inline constexpr size_t max_steal_batch = 32;
+
+// Pause before asking again once every peer has answered "nothing to steal"
+inline constexpr std::chrono::milliseconds steal_backoff{2};
+
+} // namespace distributed
+
 // ==============================
 // Enum for Steal Policy
 // ==============================
@@ -57,6 +235,32 @@ enum class StealPolicy {
 // Default stealing policy
 inline constexpr StealPolicy default_steal_policy = StealPolicy::Random;
 
+// ==============================
+// Enum for Idle Strategy
+// ==============================
+// What a worker does after a sweep of every queue finds nothing
+enum class IdleStrategy {
+    BusySpin,         // pause and sweep again, forever: lowest latency, one core per worker
+    SpinThenYield,    // spin, then sched_yield between sweeps; never sleeps
+    SpinThenPark,     // spin, yield a few times, then park with growing timeouts
+    ParkImmediately   // park on the condition variable straight away: no idle CPU
+};
+
+inline constexpr IdleStrategy default_idle_strategy = IdleStrategy::ParkImmediately;
+
+// ==============================
+// Enum for Huge Pages
+// ==============================
+// What backs runtime-internal memory (worker queue storage, task arenas).
+// Without huge pages available the runtime quietly uses normal pages.
+enum class HugePages {
+    Off,          // heap and plain mmap, as before
+    Transparent,  // 2 MiB-aligned regions advised with MADV_HUGEPAGE (THP)
+    Explicit      // MAP_HUGETLB from the reserved pool, else as Transparent
+};
+
+inline constexpr HugePages default_huge_pages = HugePages::Off;
+
 // ==============================
 // Runtime Override Struct
 // ==============================
@@ -64,8 +268,27 @@ struct ThreadPoolOptions {
     size_t threads = worker::default_threads();
     int steal_attempts = worker::steal_attempts;
     std::chrono::milliseconds idle_sleep = worker::idle_sleep;
+    IdleStrategy idle_strategy = default_idle_strategy;
+    size_t idle_spins = worker::idle_spins;
+    size_t idle_yields = worker::idle_yields;
+    bool adaptive_spin = true;   // shrink the spin phase while spinning rarely finds work
     size_t max_queue_tasks = queue::max_tasks;
     StealPolicy steal_policy = default_steal_policy;
+    std::chrono::microseconds target_chunk_duration = parallel_alg::target_chunk_duration;
+    size_t max_pending_tasks = backpressure::max_pending_tasks;
+    std::chrono::milliseconds submit_timeout = backpressure::submit_timeout;
+    RejectionHandler rejection_handler;  // empty: submit() throws TaskRejectedError
+    size_t fiber_stack_size = fiber::stack_size;
+    size_t task_arena_size = arena::capacity;
+    HugePages huge_pages = default_huge_pages;
+};
+
+struct NodeOptions {
+    ThreadPoolOptions pool;                     // the node's own workers
+    std::string bind_address = "127.0.0.1";
+    uint16_t port = 0;                          // 0: any free port, see DistributedNode::port()
+    size_t max_steal_batch = distributed::max_steal_batch;
+    std::chrono::milliseconds steal_backoff = distributed::steal_backoff;
 };
 
 } // namespace config
@@ -0,0 +1,161 @@
+#ifndef CONTINUATION_H
+#define CONTINUATION_H
+
+#include <runtime/thread_pool.h>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace runtime {
+
+// Continuation-stealing fork-join (Cilk-style), built on the fiber stacks
+// and context switches of fiber.h.
+//
+// fork_join (fork_join.h) steals children: the forked closure waits in the
+// worker's queue while the parent goes on. Here the child runs at once and
+// the rest of the parent - its continuation - is what sits in the queue for
+// thieves. The code runs on spawn fibers: fibers that may move between
+// workers. A spawn starts the child on a fresh spawn fiber (stacks recycled
+// per worker) and queues the parent's; when the child returns it pops the
+// parent straight back, so an unstolen spawn costs two switches and a
+// push/pop pair, without allocating. A thief that takes the parent resumes it on its
+// own worker; sync then suspends the parent until its last child finishes,
+// and that child's worker continues it.
+//
+// Space stays bounded by recursion depth rather than spawn breadth: each
+// worker's queue holds at most one continuation per level of nesting (a
+// loop spawning n children never has more than one queued), and a worker
+// needs at most one stack per level.
+//
+// A spawn fiber may finish on another worker than it started on: do not
+// rely on thread_locals (or current_worker()) across spawn and sync, and do
+// not spawn or sync inside a catch block. Exceptions from children are rethrown
+// by sync (the first one; the rest are dropped).
+
+namespace detail {
+
+// Join state of one SpawnScope, in the spawning fiber's frame
+struct SpawnFrame {
+    ThreadPool* pool = nullptr;
+    void* parent = nullptr;         // the fiber spawning into it
+    std::atomic<size_t> join{1};    // unfinished children, plus one for the parent
+    std::mutex error_mutex;
+    std::exception_ptr error;
+};
+
+using SpawnEntry = void (*)(void*);
+
+// Pool of the spawn fiber running on the calling thread, or null
+ThreadPool* current_spawn_pool();
+void spawn_child(SpawnFrame& frame, SpawnEntry entry, void* arg);
+// Queue the spawning fiber; called by a new child once it no longer needs
+// anything from the parent's frame
+void publish_continuation();
+void sync_children(SpawnFrame& frame);
+// Run entry(arg) on a new spawn fiber and return once it has finished
+void run_spawn_root(ThreadPool& pool, SpawnEntry entry, void* arg);
+
+template<typename F>
+void spawned_entry(void* arg) {
+    // Take the closure off the parent's frame before the parent can move on
+    F func(std::move(*static_cast<F*>(arg)));
+    publish_continuation();
+    func();
+}
+
+template<typename F>
+void root_entry(void* arg) {
+    (*static_cast<F*>(arg))();
+}
+
+} // namespace detail
+
+// spawn / sync on the calling spawn fiber. The destructor syncs too (dropping
+// child exceptions), so children never outlive the locals they reference.
+class SpawnScope {
+    public:
+        explicit SpawnScope(ThreadPool& pool) {
+            if (detail::current_spawn_pool() != &pool) {
+                throw std::logic_error("SpawnScope used outside a spawn fiber of this pool");
+            }
+            frame_.pool = &pool;
+        }
+        ~SpawnScope() {
+            detail::sync_children(frame_);
+        }
+
+        SpawnScope(const SpawnScope&) = delete;
+        SpawnScope& operator=(const SpawnScope&) = delete;
+
+        // Run f now on a child fiber; the caller continues when f returns
+        // or when a thief takes the caller over, whichever comes first
+        template<typename F>
+        void spawn(F&& f) {
+            std::decay_t<F> func(std::forward<F>(f));
+            detail::spawn_child(frame_, &detail::spawned_entry<std::decay_t<F>>, &func);
+        }
+
+        // Wait for every child spawned so far
+        void sync() {
+            detail::sync_children(frame_);
+            if (frame_.error) {
+                std::rethrow_exception(std::exchange(frame_.error, nullptr));
+            }
+        }
+
+    private:
+        detail::SpawnFrame frame_;
+};
+
+// Run f as the root of a spawn tree on pool and return its result. Blocks
+// the caller: from outside the pool f is submitted; a worker runs it itself
+// and helps with queued work if f ends up finishing on another worker. On a
+// spawn fiber of pool already, f is just called.
+template<typename F>
+auto spawn_root(ThreadPool& pool, F&& f) -> decltype(f()) {
+    using R = decltype(f());
+    if (detail::current_spawn_pool() == &pool) {
+        return f();
+    }
+    if (pool.current_worker() == ThreadPool::npos) {
+        return pool.submit_task([&pool, &f]() -> R { return spawn_root(pool, f); }).get();
+    }
+    if constexpr (std::is_void_v<R>) {
+        auto body = [&f]() { f(); };
+        detail::run_spawn_root(pool, &detail::root_entry<decltype(body)>, &body);
+    } else {
+        std::optional<R> result;
+        auto body = [&f, &result]() { result.emplace(f()); };
+        detail::run_spawn_root(pool, &detail::root_entry<decltype(body)>, &body);
+        return std::move(*result);
+    }
+}
+
+// fork_join with continuation stealing: left runs on a child spawn fiber, right
+// is the continuation. Exceptions are rethrown after both have finished
+// (left's, if both threw).
+template<typename Left, typename Right>
+void continuation_fork_join(ThreadPool& pool, Left&& left, Right&& right) {
+    if (detail::current_spawn_pool() != &pool) {
+        spawn_root(pool, [&]() { continuation_fork_join(pool, left, right); });
+        return;
+    }
+    SpawnScope scope(pool);
+    scope.spawn([&left]() { left(); });
+    std::exception_ptr right_error;
+    try {
+        right();
+    } catch (...) {
+        right_error = std::current_exception();
+    }
+    scope.sync();
+    if (right_error) std::rethrow_exception(right_error);
+}
+
+} // namespace runtime
+
+#endif // CONTINUATION_H
@@ -0,0 +1,209 @@
+#ifndef DISTRIBUTED_H
+#define DISTRIBUTED_H
+
+#include <runtime/thread_pool.h>
+#include <runtime/config.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace runtime {
+
+// A task failed on whichever node ran it; what() carries the original message
+class RemoteTaskError : public std::runtime_error {
+    public:
+        using std::runtime_error::runtime_error;
+};
+
+// Task types a node can run for its peers: a function id mapped to a handler
+// from payload bytes to result bytes. Every node registers the same ids for
+// the same functions, before it connects. Nodes exchange raw bytes, so typed
+// payloads and results must have the same layout on every node.
+class DistributedRegistry {
+    public:
+        using Handler = std::function<std::string(const std::string& payload)>;
+
+        void add(uint32_t function_id, Handler handler);
+
+        // Typed form: Arg and R (or void) trivially copyable
+        template<typename R, typename Arg, typename F>
+        void add(uint32_t function_id, F f);
+
+        const Handler* find(uint32_t function_id) const;
+
+    private:
+        std::unordered_map<uint32_t, Handler> handlers_;
+};
+
+struct DistributedStats {
+    std::atomic<uint64_t> tasks_submitted{0};
+    std::atomic<uint64_t> tasks_run{0};          // on this node, local or stolen
+    std::atomic<uint64_t> tasks_given{0};        // stolen from us by peers
+    std::atomic<uint64_t> tasks_taken{0};        // stolen by us from peers
+    std::atomic<uint64_t> steal_requests{0};
+    std::atomic<uint64_t> empty_steals{0};       // peer had nothing to give
+    std::atomic<uint64_t> tasks_requeued{0};     // given to a peer that disconnected
+};
+
+// One process's share of a distributed pool: a ThreadPool plus a TCP
+// endpoint. Tasks submitted here queue on the node; its own idle workers
+// take them oldest first, and peers with idle workers steal batches from the
+// other end. A thief runs the task and sends the result back, which
+// completes the submitter's future.
+//
+// Idle workers ask one peer at a time for work, round robin; once every peer
+// has come back empty they back off for steal_backoff. Tasks given to a peer
+// that disconnects before answering are queued again here, so a task may run
+// twice if its thief dies after running it (at-least-once).
+//
+// All socket I/O happens on one thread per node. Nodes are assumed to run
+// the same build on the same architecture.
+class DistributedNode {
+    public:
+        explicit DistributedNode(const DistributedRegistry& registry,
+                                 const config::NodeOptions& options = config::NodeOptions());
+        ~DistributedNode();
+
+        DistributedNode(const DistributedNode&) = delete;
+        DistributedNode& operator=(const DistributedNode&) = delete;
+
+        // Port this node accepts peers on
+        uint16_t port() const { return port_; }
+
+        // Connect to another node; the link is symmetric, either side steals
+        void connect(const std::string& host, uint16_t port);
+        size_t peers() const;
+
+        std::future<std::string> submit_bytes(uint32_t function_id, std::string payload);
+
+        template<typename R, typename Arg>
+        std::future<R> submit(uint32_t function_id, const Arg& arg);
+
+        // Block until every task submitted on this node has completed
+        void wait();
+
+        ThreadPool& pool() { return pool_; }
+        const DistributedStats& stats() const { return stats_; }
+
+    private:
+        struct Peer;
+        struct Entry {
+            uint64_t uid;
+            uint32_t function_id;
+            std::string payload;
+        };
+        using Completion = std::function<void(bool ok, const std::string& result)>;
+
+        void enqueue(uint32_t function_id, std::string payload, Completion done);
+        bool take_task(Task& task);
+        void run_entry(Entry& entry, uint64_t origin_peer);
+        void complete(uint64_t uid, bool ok, const std::string& result);
+
+        void request_steal();
+        void send(uint64_t peer_id, const std::string& frame);
+        void add_peer(int fd);
+        void io_loop();
+        void on_frame(const std::shared_ptr<Peer>& peer, const std::string& frame);
+        void on_disconnect(const std::shared_ptr<Peer>& peer);
+        void wake_io();
+
+        const DistributedRegistry& registry_;
+        size_t max_steal_batch_;
+        std::chrono::milliseconds steal_backoff_;
+        DistributedStats stats_;
+
+        // Tasks submitted here and not yet taken by a worker or a thief
+        std::mutex queue_mutex_;
+        std::deque<Entry> queue_;
+        std::unordered_map<uint64_t, Completion> completions_;
+        std::unordered_map<uint64_t, std::unordered_map<uint64_t, Entry>> given_;  // per thief, by uid
+        size_t completing_ = 0;
+        uint64_t next_uid_ = 1;
+        std::condition_variable cv_done_;
+
+        // Steal requests: at most one in flight, to steal_target_
+        std::atomic<bool> steal_in_flight_{false};
+        std::atomic<int64_t> next_steal_ns_{0};
+        uint64_t steal_target_ = 0;
+        size_t steal_cursor_ = 0;
+        size_t empty_answers_ = 0;
+
+        mutable std::mutex peers_mutex_;
+        std::unordered_map<uint64_t, std::shared_ptr<Peer>> peers_;
+        uint64_t next_peer_id_ = 1;
+
+        int listen_fd_ = -1;
+        int wake_fds_[2] = {-1, -1};
+        uint16_t port_ = 0;
+        std::atomic<bool> closing_{false};  // no new steal requests
+        std::atomic<bool> stop_{false};
+        std::thread io_thread_;
+
+        ThreadPool pool_;
+};
+
+template<typename R, typename Arg, typename F>
+void DistributedRegistry::add(uint32_t function_id, F f) {
+    static_assert(std::is_trivially_copyable<Arg>::value, "Distributed task arguments must be trivially copyable");
+    static_assert(std::is_void<R>::value || std::is_trivially_copyable<R>::value,
+                  "Distributed task results must be trivially copyable");
+    add(function_id, [f](const std::string& payload) -> std::string {
+        Arg arg;
+        if (payload.size() != sizeof(Arg)) {
+            throw std::invalid_argument("Distributed task payload has the wrong size");
+        }
+        std::memcpy(&arg, payload.data(), sizeof(Arg));
+        if constexpr (std::is_void<R>::value) {
+            f(arg);
+            return std::string();
+        } else {
+            R result = f(arg);
+            return std::string(reinterpret_cast<const char*>(&result), sizeof(R));
+        }
+    });
+}
+
+template<typename R, typename Arg>
+std::future<R> DistributedNode::submit(uint32_t function_id, const Arg& arg) {
+    static_assert(std::is_trivially_copyable<Arg>::value, "Distributed task arguments must be trivially copyable");
+    static_assert(std::is_void<R>::value || std::is_trivially_copyable<R>::value,
+                  "Distributed task results must be trivially copyable");
+    auto promise = std::make_shared<std::promise<R>>();
+    std::future<R> future = promise->get_future();
+    enqueue(function_id, std::string(reinterpret_cast<const char*>(&arg), sizeof(Arg)),
+            [promise](bool ok, const std::string& result) {
+        if (!ok) {
+            promise->set_exception(std::make_exception_ptr(RemoteTaskError(result)));
+            return;
+        }
+        if constexpr (std::is_void<R>::value) {
+            promise->set_value();
+        } else {
+            if (result.size() != sizeof(R)) {
+                promise->set_exception(std::make_exception_ptr(
+                    RemoteTaskError("Distributed task result has the wrong size")));
+                return;
+            }
+            R value;
+            std::memcpy(&value, result.data(), sizeof(R));
+            promise->set_value(value);
+        }
+    });
+    return future;
+}
+
+} // namespace runtime
+
+#endif // DISTRIBUTED_H
@@ -0,0 +1,299 @@
+#ifndef EXECUTION_H
+#define EXECUTION_H
+
+#include <runtime/thread_pool.h>
+#include <runtime/parallel_for.h>
+#include <runtime/parallel_reduce.h>
+#include <runtime/parallel_for_each.h>
+#include <runtime/parallel_sort.h>
+#include <runtime/fork_join.h>
+#include <runtime/config.h>
+#include <vector>
+#include <mutex>
+#include <optional>
+#include <iterator>
+#include <functional>
+#include <numeric>
+#include <algorithm>
+#include <utility>
+
+// Drop-in replacements for the C++17 parallel algorithms, backed by a
+// ThreadPool instead of the standard library's backend (TBB on libstdc++).
+// Migrating is a search-and-replace:
+//
+//   std::for_each(std::execution::par, first, last, f);
+//   runtime::for_each(runtime::execution::par_pool(pool), first, last, f);
+//
+// Semantics follow the std:: overloads: reduce / transform_reduce may
+// combine in any order (the operation must be associative and commutative),
+// inclusive_scan needs an associative operation, and sort is stable.
+
+namespace runtime {
+
+namespace execution {
+
+// Execution policy naming the pool to run on and the chunk size to use
+class pool_policy {
+    public:
+        explicit pool_policy(ThreadPool& pool, size_t chunk_size = config::parallel_alg::chunk_size)
+            : pool_(&pool), chunk_size_(chunk_size) {}
+
+        ThreadPool& pool() const { return *pool_; }
+        size_t chunk_size() const { return chunk_size_; }
+
+        // Same pool, different chunk size
+        pool_policy with_chunk_size(size_t chunk_size) const { return pool_policy(*pool_, chunk_size); }
+
+    private:
+        ThreadPool* pool_;
+        size_t chunk_size_;
+};
+
+inline pool_policy par_pool(ThreadPool& pool, size_t chunk_size = config::parallel_alg::chunk_size) {
+    return pool_policy(pool, chunk_size);
+}
+
+} // namespace execution
+
+namespace detail {
+
+// Reduce map(*it) over [first, last) with op. Random-access ranges go
+// through parallel_reduce_chunked; forward ranges through the walking
+// splitter, with per-chunk partials combined as they complete.
+template<typename Iterator, typename T, typename ReduceOp, typename Map>
+T policy_reduce(const execution::pool_policy& policy, Iterator first, Iterator last,
+                T init, ReduceOp& op, Map& map) {
+    const size_t chunk_size = iterator_chunk_size(policy.chunk_size());
+    auto reduce_chunk = [&op, &map](Iterator it, size_t count) -> T {
+        T partial = map(*it);
+        for (++it; --count > 0; ++it) {
+            partial = op(std::move(partial), map(*it));
+        }
+        return partial;
+    };
+
+    if constexpr (is_random_access_v<Iterator>) {
+        using Diff = typename std::iterator_traits<Iterator>::difference_type;
+        return parallel_reduce_chunked(policy.pool(), size_t(0), static_cast<size_t>(last - first),
+            std::move(init),
+            [first, &reduce_chunk](size_t lo, size_t hi) {
+                return reduce_chunk(first + static_cast<Diff>(lo), hi - lo);
+            },
+            op, chunk_size);
+    } else {
+        std::mutex mutex;
+        T result = std::move(init);
+        auto run = [&](Iterator it, size_t count) {
+            T partial = reduce_chunk(it, count);
+            std::lock_guard<std::mutex> lock(mutex);
+            result = op(std::move(result), std::move(partial));
+        };
+        run_forward_chunks(policy.pool(), first, last, chunk_size, run);
+        return result;
+    }
+}
+
+// Iterator over pairs of positions in two ranges, so binary transforms can
+// reuse the single-range machinery. Dereferences to the pair of iterators.
+template<typename It1, typename It2>
+struct ZipIterator {
+    using iterator_category = std::conditional_t<
+        is_random_access_v<It1> && is_random_access_v<It2>,
+        std::random_access_iterator_tag, std::forward_iterator_tag>;
+    using value_type = std::pair<It1, It2>;
+    using difference_type = typename std::iterator_traits<It1>::difference_type;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    value_type pos;
+
+    reference operator*() const { return pos; }
+    ZipIterator& operator++() {
+        ++pos.first;
+        ++pos.second;
+        return *this;
+    }
+    ZipIterator operator+(difference_type n) const {
+        return ZipIterator{{pos.first + n, pos.second + n}};
+    }
+    value_type operator[](difference_type n) const { return (*this + n).pos; }
+    difference_type operator-(const ZipIterator& other) const { return pos.first - other.pos.first; }
+    bool operator==(const ZipIterator& other) const { return pos.first == other.pos.first; }
+    bool operator!=(const ZipIterator& other) const { return pos.first != other.pos.first; }
+};
+
+template<typename It1, typename It2>
+ZipIterator<It1, It2> zip(It1 a, It2 b) {
+    return ZipIterator<It1, It2>{{a, b}};
+}
+
+} // namespace detail
+
+template<typename Iterator, typename Func>
+void for_each(const execution::pool_policy& policy, Iterator first, Iterator last, Func f) {
+    parallel_for_each(policy.pool(), first, last, f, policy.chunk_size());
+}
+
+template<typename InputIt, typename OutputIt, typename UnaryOp>
+OutputIt transform(const execution::pool_policy& policy, InputIt first, InputIt last,
+                   OutputIt out, UnaryOp op) {
+    return parallel_transform(policy.pool(), first, last, out, op, policy.chunk_size());
+}
+
+template<typename InputIt1, typename InputIt2, typename OutputIt, typename BinaryOp>
+OutputIt transform(const execution::pool_policy& policy, InputIt1 first1, InputIt1 last1,
+                   InputIt2 first2, OutputIt out, BinaryOp op) {
+    auto zipped_end = parallel_transform(policy.pool(),
+        detail::zip(first1, first2), detail::zip(last1, first2), out,
+        [&op](const std::pair<InputIt1, InputIt2>& pos) { return op(*pos.first, *pos.second); },
+        policy.chunk_size());
+    return zipped_end;
+}
+
+template<typename Iterator, typename T, typename BinaryOp>
+T reduce(const execution::pool_policy& policy, Iterator first, Iterator last, T init, BinaryOp op) {
+    if (first == last) return init;
+    auto identity = [](const auto& value) { return value; };
+    return detail::policy_reduce(policy, first, last, std::move(init), op, identity);
+}
+
+template<typename Iterator, typename T>
+T reduce(const execution::pool_policy& policy, Iterator first, Iterator last, T init) {
+    return runtime::reduce(policy, first, last, std::move(init), std::plus<>());
+}
+
+template<typename Iterator>
+typename std::iterator_traits<Iterator>::value_type
+reduce(const execution::pool_policy& policy, Iterator first, Iterator last) {
+    using T = typename std::iterator_traits<Iterator>::value_type;
+    return runtime::reduce(policy, first, last, T{}, std::plus<>());
+}
+
+// reduce(transform(*it) for it in [first, last))
+template<typename Iterator, typename T, typename ReduceOp, typename TransformOp>
+T transform_reduce(const execution::pool_policy& policy, Iterator first, Iterator last, T init,
+                   ReduceOp reduce_op, TransformOp transform_op) {
+    if (first == last) return init;
+    return detail::policy_reduce(policy, first, last, std::move(init), reduce_op, transform_op);
+}
+
+// reduce(transform(*it1, *it2) for the paired positions of two ranges)
+template<typename Iterator1, typename Iterator2, typename T, typename ReduceOp, typename TransformOp>
+T transform_reduce(const execution::pool_policy& policy, Iterator1 first1, Iterator1 last1,
+                   Iterator2 first2, T init, ReduceOp reduce_op, TransformOp transform_op) {
+    if (first1 == last1) return init;
+    auto pair_op = [&transform_op](const std::pair<Iterator1, Iterator2>& pos) {
+        return transform_op(*pos.first, *pos.second);
+    };
+    return detail::policy_reduce(policy, detail::zip(first1, first2), detail::zip(last1, first2),
+                                 std::move(init), reduce_op, pair_op);
+}
+
+// Inner product: sum of (*it1) * (*it2)
+template<typename Iterator1, typename Iterator2, typename T>
+T transform_reduce(const execution::pool_policy& policy, Iterator1 first1, Iterator1 last1,
+                   Iterator2 first2, T init) {
+    return runtime::transform_reduce(policy, first1, last1, first2, std::move(init),
+                                     std::plus<>(), std::multiplies<>());
+}
+
+// Stable (merge) sort; see parallel_stable_sort
+template<typename RandomIt, typename Compare = std::less<>>
+void sort(const execution::pool_policy& policy, RandomIt first, RandomIt last, Compare comp = Compare()) {
+    parallel_stable_sort(policy.pool(), first, last, comp);
+}
+
+namespace detail {
+
+// Two-pass blocked scan. Pass 1 reduces every block; a serial scan over
+// the block totals gives each block its carry-in; pass 2 rescans every
+// block starting from its carry-in. out may equal first.
+template<typename RandomIt, typename OutputIt, typename BinaryOp, typename T>
+OutputIt policy_inclusive_scan(const execution::pool_policy& policy, RandomIt first, RandomIt last,
+                               OutputIt out, BinaryOp& op, std::optional<T> init) {
+    using Diff = typename std::iterator_traits<RandomIt>::difference_type;
+    using OutDiff = typename std::iterator_traits<OutputIt>::difference_type;
+    ThreadPool& pool = policy.pool();
+    const size_t n = static_cast<size_t>(last - first);
+    const size_t blocks = std::max<size_t>(1, std::min(n / iterator_chunk_size(policy.chunk_size()),
+                                                       pool.thread_count() * 8));
+
+    auto scan_block = [&](size_t b, std::optional<T> carry) {
+        size_t i0 = block_begin(b, blocks, n);
+        size_t i1 = block_begin(b + 1, blocks, n);
+        for (size_t i = i0; i < i1; ++i) {
+            carry = carry ? T(op(std::move(*carry), first[static_cast<Diff>(i)]))
+                          : T(first[static_cast<Diff>(i)]);
+            out[static_cast<OutDiff>(i)] = *carry;
+        }
+    };
+
+    if (blocks == 1) {
+        scan_block(0, std::move(init));
+        return out + static_cast<OutDiff>(n);
+    }
+
+    std::vector<std::optional<T>> carry(blocks);
+    run_in_pool(pool, [&]() {
+        fork_join_for(pool, size_t(0), blocks - 1, 1, [&](size_t b0, size_t b1) {
+            for (size_t b = b0; b < b1; ++b) {
+                size_t i0 = block_begin(b, blocks, n);
+                size_t i1 = block_begin(b + 1, blocks, n);
+                T total = first[static_cast<Diff>(i0)];
+                for (size_t i = i0 + 1; i < i1; ++i) {
+                    total = op(std::move(total), first[static_cast<Diff>(i)]);
+                }
+                carry[b + 1] = std::move(total);
+            }
+        });
+
+        // carry[b] becomes the combined total of init and blocks [0, b)
+        carry[0] = std::move(init);
+        for (size_t b = 1; b < blocks; ++b) {
+            if (carry[b - 1]) carry[b] = T(op(*carry[b - 1], std::move(*carry[b])));
+        }
+
+        fork_join_for(pool, size_t(0), blocks, 1, [&](size_t b0, size_t b1) {
+            for (size_t b = b0; b < b1; ++b) {
+                scan_block(b, carry[b]);
+            }
+        });
+    });
+    return out + static_cast<OutDiff>(n);
+}
+
+} // namespace detail
+
+// out[k] = first[0] op first[1] op ... op first[k]. Random-access ranges
+// use a two-pass blocked scan; other ranges are scanned serially.
+template<typename InputIt, typename OutputIt, typename BinaryOp = std::plus<>>
+OutputIt inclusive_scan(const execution::pool_policy& policy, InputIt first, InputIt last,
+                        OutputIt out, BinaryOp op = BinaryOp()) {
+    using T = typename std::iterator_traits<InputIt>::value_type;
+    if constexpr (detail::is_random_access_v<InputIt> && detail::is_random_access_v<OutputIt>) {
+        return detail::policy_inclusive_scan<InputIt, OutputIt, BinaryOp, T>(
+            policy, first, last, out, op, std::nullopt);
+    } else {
+        return std::partial_sum(first, last, out, op);
+    }
+}
+
+// As above, with init combined in front of the first element
+template<typename InputIt, typename OutputIt, typename BinaryOp, typename T>
+OutputIt inclusive_scan(const execution::pool_policy& policy, InputIt first, InputIt last,
+                        OutputIt out, BinaryOp op, T init) {
+    if constexpr (detail::is_random_access_v<InputIt> && detail::is_random_access_v<OutputIt>) {
+        return detail::policy_inclusive_scan<InputIt, OutputIt, BinaryOp, T>(
+            policy, first, last, out, op, std::optional<T>(std::move(init)));
+    } else {
+        for (; first != last; ++first, ++out) {
+            init = op(std::move(init), *first);
+            *out = init;
+        }
+        return out;
+    }
+}
+
+} // namespace runtime
+
+#endif // EXECUTION_H
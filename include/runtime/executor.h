@@ -0,0 +1,113 @@
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include <runtime/thread_pool.h>
+#include <runtime/task.h>
+#include <runtime/config.h>
+#include <atomic>
+#include <memory>
+#include <future>
+#include <functional>
+#include <type_traits>
+
+namespace runtime {
+
+namespace detail {
+
+// Unbounded multi-producer / single-consumer task queue (Vyukov's
+// intrusive MPSC design). push is one exchange and one store and never
+// blocks; try_pop may transiently see the queue as empty while a push is
+// halfway done.
+class MpscTaskQueue {
+    public:
+        MpscTaskQueue();
+        ~MpscTaskQueue();
+
+        MpscTaskQueue(const MpscTaskQueue&) = delete;
+        MpscTaskQueue& operator=(const MpscTaskQueue&) = delete;
+
+        void push(Task task);
+        bool try_pop(Task& task);  // consumer only
+
+    private:
+        struct Node {
+            std::atomic<Node*> next{nullptr};
+            Task task;
+        };
+
+        std::atomic<Node*> head_;  // most recently pushed
+        Node* tail_;               // consumer side; always a consumed stub
+};
+
+} // namespace detail
+
+// Runs tasks on a ThreadPool with at most max_concurrency of them in
+// flight at once. Tasks are queued inside the executor and only handed to
+// the pool while a slot is free, so no worker ever blocks waiting for one.
+//
+// One atomic counts queued + running tasks; the number of runner tasks on
+// the pool is kept at min(count, max_concurrency). Submitting is lock-free.
+// A runner executes queued tasks until the count drops to the limit
+// (up to config::executor::runner_batch at a time, then it requeues itself).
+//
+// Exceptions thrown by tasks are swallowed, as in ThreadPool; use
+// submit_task for a future. If the pool is shutting down, runners that
+// can no longer be submitted run on the calling thread instead, so no
+// task is lost. The destructor waits for all submitted tasks.
+class LimitedExecutor {
+    public:
+        LimitedExecutor(ThreadPool& pool, size_t max_concurrency);
+        ~LimitedExecutor();
+
+        LimitedExecutor(const LimitedExecutor&) = delete;
+        LimitedExecutor& operator=(const LimitedExecutor&) = delete;
+
+        void submit(Task task);
+
+        template<typename F, typename... Args>
+        auto submit_task(F&& f, Args&&... args)
+            -> std::future<typename std::invoke_result<F, Args...>::type>;
+
+        // Block until every submitted task has finished. Safe to call from a
+        // pool task: the caller runs other pool work while it waits.
+        void wait();
+
+        size_t max_concurrency() const { return max_concurrency_; }
+        // Tasks submitted but not yet finished (queued + running)
+        size_t pending() const { return count_.load(std::memory_order_acquire); }
+
+    private:
+        void run_batch();
+        Task next_task();
+
+        ThreadPool& pool_;
+        const size_t max_concurrency_;
+        detail::MpscTaskQueue queue_;
+        std::atomic<bool> popping_{false};  // runners take turns at the single consumer end
+        std::atomic<size_t> count_{0};
+};
+
+// Strand: tasks run one at a time, in submission order, on whichever
+// worker is free. Tasks submitted to different strands run in parallel.
+class SerialExecutor : public LimitedExecutor {
+    public:
+        explicit SerialExecutor(ThreadPool& pool) : LimitedExecutor(pool, 1) {}
+};
+
+template<typename F, typename... Args>
+auto LimitedExecutor::submit_task(F&& f, Args&&... args)
+    -> std::future<typename std::invoke_result<F, Args...>::type>
+{
+    using return_type = typename std::invoke_result<F, Args...>::type;
+
+    auto task = std::make_shared<std::packaged_task<return_type()>>(
+        std::bind(std::forward<F>(f), std::forward<Args>(args)...)
+    );
+    std::future<return_type> result = task->get_future();
+    submit([task]() { (*task)(); });
+    return result;
+}
+
+} // namespace runtime
+
+#endif // EXECUTOR_H
@@ -0,0 +1,85 @@
+#ifndef FIBER_H
+#define FIBER_H
+
+#include <runtime/thread_pool.h>
+#include <runtime/async_sync.h>
+#include <runtime/task.h>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+namespace runtime {
+
+// Fibers: pool tasks with a stack of their own, for code that has to block
+// deep inside a call stack. Blocking through this_fiber (below) suspends
+// the fiber and switches the worker back to its other tasks; the fiber
+// resumes where it left off once the awaited event happens.
+//
+// Each fiber runs on an mmap'ed stack of pool.fiber_stack_size() bytes with
+// a guard page underneath, taken from a per-worker cache of recycled stacks
+// (config::fiber::stack_cache). Context switches are a few instructions of
+// hand-written assembly on x86-64 and AArch64 Linux, and ucontext
+// elsewhere (or when built with RUNTIME_FIBER_UCONTEXT).
+//
+// A fiber stays on the worker that started it: it is resumed through
+// submit_pinned, so thread_locals read inside it never change underneath.
+// Suspended fibers count as unfinished work for wait() and shutdown().
+// Exceptions escaping a fiber are swallowed, as in ThreadPool::submit; use
+// submit_fiber_task for a future.
+
+void submit_fiber(ThreadPool& pool, Task task);
+
+template<typename F, typename... Args>
+auto submit_fiber_task(ThreadPool& pool, F&& f, Args&&... args)
+    -> std::future<typename std::invoke_result<F, Args...>::type>;
+
+namespace this_fiber {
+
+// True when the caller is running on a fiber
+bool active();
+
+// Suspend the calling fiber. register_resume is called once the fiber is
+// off its stack, with a callable that makes the fiber runnable again; call
+// it from any thread (later calls are ignored). Outside a fiber this
+// blocks the calling thread until resume is called.
+void suspend(const std::function<void(Task resume)>& register_resume);
+
+// Let the worker run its other work, then continue
+void yield();
+void sleep_for(std::chrono::steady_clock::duration duration);
+
+// Blocking forms of the async_sync.h primitives
+void lock(AsyncMutex& mutex);
+void acquire(AsyncSemaphore& semaphore);
+void wait(Latch& latch);
+void arrive_and_wait(Barrier& barrier);
+
+} // namespace this_fiber
+
+namespace detail {
+
+// Average cost of one bare fiber switch (there and back is two), without
+// the scheduler; for benchmarks
+double measure_switch_ns(size_t round_trips);
+
+} // namespace detail
+
+template<typename F, typename... Args>
+auto submit_fiber_task(ThreadPool& pool, F&& f, Args&&... args)
+    -> std::future<typename std::invoke_result<F, Args...>::type>
+{
+    using return_type = typename std::invoke_result<F, Args...>::type;
+
+    auto task = std::make_shared<std::packaged_task<return_type()>>(
+        std::bind(std::forward<F>(f), std::forward<Args>(args)...)
+    );
+    std::future<return_type> result = task->get_future();
+    submit_fiber(pool, [task]() { (*task)(); });
+    return result;
+}
+
+} // namespace runtime
+
+#endif // FIBER_H
@@ -0,0 +1,138 @@
+#ifndef FORK_JOIN_H
+#define FORK_JOIN_H
+
+#include <runtime/thread_pool.h>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace runtime {
+
+namespace detail {
+
+// The stealable half of a fork_join. It lives on the forking task's stack;
+// the queued task only holds a pointer to it, which is small enough for
+// std::function to store without allocating. fork_join does not return
+// until the queued task has run, so the pointer never dangles.
+template<typename Func>
+struct ForkSlot {
+    Func& func;
+    std::exception_ptr error;
+    std::atomic<bool> done{false};
+
+    explicit ForkSlot(Func& f) : func(f) {}
+
+    void run() noexcept {
+        try {
+            func();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        // Last access to *this by the runner
+        done.store(true, std::memory_order_release);
+    }
+};
+
+// Keep running queued work until the slot has been executed - by us, if it
+// is still in our queue (the common case), or by whoever stole it
+template<typename Func>
+void join_slot(ThreadPool& pool, ForkSlot<Func>& slot) {
+    while (!slot.done.load(std::memory_order_acquire)) {
+        if (!pool.run_pending_task()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+} // namespace detail
+
+// Run left and right in parallel and return when both are done.
+// Work-first: right is pushed onto the calling worker's own queue and left
+// runs inline. When left returns, the worker pops its queue; unless a thief
+// took right in the meantime, that pop is right itself, so an unstolen fork
+// costs one push/pop pair and no allocation or blocking. If right was
+// stolen the caller runs other queued tasks until the thief finishes.
+// Called from a thread that is not a worker, both branches run inline:
+// right would have to go through submit(), where backpressure or a
+// rejection handler may drop it. Wrap the call in a task to fork there.
+// Exceptions from either branch are rethrown after both have finished.
+template<typename Left, typename Right>
+void fork_join(ThreadPool& pool, Left&& left, Right&& right) {
+    detail::ForkSlot<std::remove_reference_t<Right>> slot(right);
+    const bool forked = pool.current_worker() != ThreadPool::npos;
+    if (forked) {
+        // A worker's own queue always admits the task
+        pool.submit_local([slot_ptr = &slot]() { slot_ptr->run(); });
+    }
+
+    std::exception_ptr left_error;
+    try {
+        left();
+    } catch (...) {
+        left_error = std::current_exception();
+    }
+
+    if (forked) {
+        detail::join_slot(pool, slot);
+    } else {
+        slot.run();
+    }
+
+    if (left_error) std::rethrow_exception(left_error);
+    if (slot.error) std::rethrow_exception(slot.error);
+}
+
+// Run all functions in parallel and return when every one has finished.
+// The calling thread runs the first function itself.
+template<typename F>
+void parallel_invoke(ThreadPool& /*pool*/, F&& f) {
+    f();
+}
+
+template<typename F1, typename F2, typename... Rest>
+void parallel_invoke(ThreadPool& pool, F1&& f1, F2&& f2, Rest&&... rest) {
+    if constexpr (sizeof...(Rest) == 0) {
+        fork_join(pool, f1, f2);
+    } else {
+        fork_join(pool, f1, [&]() {
+            parallel_invoke(pool, f2, rest...);
+        });
+    }
+}
+
+// Call body(first, last) over [first, last) split recursively with
+// fork_join until pieces are at most grain long. Unlike parallel_for it
+// never blocks on a future, so it is safe to call from inside a task.
+template<typename IndexType, typename Body>
+void fork_join_for(ThreadPool& pool, IndexType first, IndexType last, size_t grain, Body&& body) {
+    if (first >= last) return;
+    if (grain == 0) grain = 1;
+    if (static_cast<size_t>(last - first) <= grain) {
+        body(first, last);
+        return;
+    }
+    IndexType mid = first + static_cast<IndexType>(static_cast<size_t>(last - first) / 2);
+    fork_join(pool,
+        [&]() { fork_join_for(pool, first, mid, grain, body); },
+        [&]() { fork_join_for(pool, mid, last, grain, body); });
+}
+
+namespace detail {
+
+// Run f on a worker of pool: directly if already on one, otherwise as a
+// single submitted task, so forks inside f go to worker queues
+template<typename F>
+auto run_in_pool(ThreadPool& pool, F&& f) -> decltype(f()) {
+    if (pool.current_worker() != ThreadPool::npos) {
+        return f();
+    }
+    return pool.submit_task(std::forward<F>(f)).get();
+}
+
+} // namespace detail
+
+} // namespace runtime
+
+#endif // FORK_JOIN_H
@@ -0,0 +1,85 @@
+#ifndef HUGE_PAGES_H
+#define HUGE_PAGES_H
+
+#include <runtime/config.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace runtime {
+
+// Huge-page backing for the runtime's own memory (config::HugePages).
+//
+// A pool's queues keep their storage, and its workers their task arenas,
+// in a few 2 MiB regions instead of scattered 4 KiB heap pages, so a steal
+// sweep over every queue touches a handful of TLB entries. Regions come
+// from the reserved hugetlbfs pool (MAP_HUGETLB) under HugePages::Explicit,
+// or are 2 MiB-aligned anonymous mappings advised with MADV_HUGEPAGE for
+// transparent huge pages; when neither is available they stay on normal
+// pages and nothing else changes.
+//
+// Storage is kept for the pool's lifetime, at its peak: a queue's blocks go
+// back to the queue's own pool, never to the regions, and region space
+// handed out is only reclaimed when the pool is destroyed. Size
+// max_queue_tasks with that in mind.
+
+// One mmap'ed region
+struct PageRegion {
+    void* base = nullptr;
+    size_t size = 0;
+    bool huge = false;   // MAP_HUGETLB, or MADV_HUGEPAGE accepted
+};
+
+// Map at least `bytes` (rounded up to config::huge_pages::page_size unless
+// mode is Off). Throws std::bad_alloc only if no mapping can be made at all.
+PageRegion map_pages(size_t bytes, config::HugePages mode);
+void unmap_pages(const PageRegion& region);
+
+// Memory resource handing out pieces of huge-page regions: small requests
+// are bump-allocated from shared regions and only come back when the
+// resource is destroyed, so deallocating them does nothing. Put a pool
+// resource in front for reuse, as WorkStealingQueue does; what that pool
+// passes straight through (e.g. a deep deque's growing block map) takes
+// fresh space every time. Requests above a region get regions of their
+// own, unmapped on deallocation. Thread-safe.
+class HugePageResource : public std::pmr::memory_resource {
+    public:
+        // Stats, if set, count regions mapped on huge pages and those that
+        // fell back to normal pages
+        explicit HugePageResource(config::HugePages mode,
+                                  std::atomic<uint64_t>* huge_stat = nullptr,
+                                  std::atomic<uint64_t>* fallback_stat = nullptr);
+        ~HugePageResource() override;
+
+        HugePageResource(const HugePageResource&) = delete;
+        HugePageResource& operator=(const HugePageResource&) = delete;
+
+        config::HugePages mode() const { return mode_; }
+        size_t mapped_bytes() const;
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+    private:
+        PageRegion map(size_t bytes);
+
+        config::HugePages mode_;
+        std::atomic<uint64_t>* huge_stat_;
+        std::atomic<uint64_t>* fallback_stat_;
+        mutable std::mutex mutex_;
+        std::vector<PageRegion> regions_;   // shared regions, newest last
+        size_t top_ = 0;                    // offset into regions_.back()
+        std::unordered_map<void*, PageRegion> large_;
+};
+
+} // namespace runtime
+
+#endif // HUGE_PAGES_H
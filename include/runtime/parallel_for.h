@@ -3,16 +3,112 @@
 
 #include <runtime/thread_pool.h>
 #include <runtime/config.h>
+#include <runtime/blocked_range.h>
+#include <runtime/partitioner.h>
+#include <runtime/adaptive_grain.h>
 #include <vector>
 #include <future>
+#include <utility>
+#include <cstdint>
+#include <algorithm>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <type_traits>
 
 namespace runtime {
 
-// Parallel for loop - splits range [start, end) into chunks and processes in parallel
+namespace detail {
+
+// Block until every task behind futures has finished. Called before
+// collecting results: get() rethrows the first failure, and unwinding then
+// would leave tasks running that still reference the caller's frame.
+template<typename T>
+void wait_all(std::vector<std::future<T>>& futures) {
+    for (auto& future : futures) {
+        future.wait();
+    }
+}
+
+// Fan-outs queue their chunks with submit_batch / submit_batch_to, which
+// backpressure never holds back: every chunk references the caller's
+// frame, so a caller refused halfway could neither return nor run the
+// chunks it was refused. Wraps f for the batch and returns its future.
+template<typename F>
+auto add_chunk(std::vector<Task>& batch, F&& f) -> std::future<std::invoke_result_t<std::decay_t<F>&>> {
+    using R = std::invoke_result_t<std::decay_t<F>&>;
+    auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+    std::future<R> result = task->get_future();
+    batch.push_back([task]() { (*task)(); });
+    return result;
+}
+
+// auto_chunk mode: probe the body's cost once per call site, then size
+// chunks to pool.target_chunk_duration() and keep refining the estimate
+// from the timed chunks
+template<typename IndexType, typename Func>
+void adaptive_parallel_for(ThreadPool& pool, IndexType start, IndexType end, Func& func) {
+    auto& estimate = grain_cost_estimate<std::decay_t<Func>>();
+    const double target_ns = std::chrono::duration<double, std::nano>(pool.target_chunk_duration()).count();
+    const size_t range = static_cast<size_t>(end - start);
+
+    auto run = [&func, start](size_t first, size_t last) {
+        for (IndexType i = start + static_cast<IndexType>(first);
+             i < start + static_cast<IndexType>(last); ++i) {
+            func(i);
+        }
+    };
+
+    size_t done = 0;
+    if (estimate.load(std::memory_order_relaxed) == 0.0) {
+        done = probe_grain_cost(range, run, estimate, target_ns);
+    }
+
+    size_t remaining = range - done;
+    if (remaining == 0) return;
+
+    double ns = estimate.load(std::memory_order_relaxed);
+    if (ns * static_cast<double>(remaining) <= target_ns) {
+        // Less than one chunk of work left
+        run(done, range);
+        return;
+    }
+
+    size_t chunk = adaptive_chunk_size(ns, remaining, pool.thread_count(), target_ns);
+    std::vector<std::future<void>> futures;
+    std::vector<Task> batch;
+    futures.reserve((remaining + chunk - 1) / chunk);
+    batch.reserve(futures.capacity());
+
+    for (size_t first = done; first < range; first += chunk) {
+        size_t last = std::min(range, first + chunk);
+        futures.push_back(add_chunk(batch, [first, last, &run, &estimate]() {
+            auto begin = std::chrono::steady_clock::now();
+            run(first, last);
+            record_grain_cost(estimate, elapsed_ns(begin) / static_cast<double>(last - first));
+        }));
+    }
+
+    pool.submit_batch(batch);
+    wait_all(futures);
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
+} // namespace detail
+
+// Parallel for loop - splits range [start, end) into chunks and processes in parallel.
+// Pass config::parallel_alg::auto_chunk as chunk_size to size chunks from measured cost.
 template<typename IndexType, typename Func>
 void parallel_for(ThreadPool& pool, IndexType start, IndexType end, Func&& func, size_t chunk_size = config::parallel_alg::chunk_size) {
     if (start >= end) return;
     
+    if (chunk_size == config::parallel_alg::auto_chunk) {
+        detail::adaptive_parallel_for(pool, start, end, func);
+        return;
+    }
+    
     IndexType range = end - start;
     if (range <= static_cast<IndexType>(chunk_size)) {
         // Range too small, just execute sequentially
@@ -25,21 +121,341 @@ void parallel_for(ThreadPool& pool, IndexType start, IndexType end, Func&& func,
     // Calculate number of chunks
     size_t num_chunks = (range + chunk_size - 1) / chunk_size;
     std::vector<std::future<void>> futures;
+    std::vector<Task> batch;
     futures.reserve(num_chunks);
+    batch.reserve(num_chunks);
     
     // Submit chunks
     for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
         IndexType chunk_start = start + chunk * chunk_size;
         IndexType chunk_end = std::min(chunk_start + static_cast<IndexType>(chunk_size), end);
         
-        futures.push_back(pool.submit_task([chunk_start, chunk_end, &func]() {
+        futures.push_back(detail::add_chunk(batch, [chunk_start, chunk_end, &func]() {
             for (IndexType i = chunk_start; i < chunk_end; ++i) {
                 func(i);
             }
         }));
     }
+    pool.submit_batch(batch);
     
     // Wait for all chunks to complete
+    detail::wait_all(futures);
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
+namespace detail {
+
+// Split a range in halves `depth` times (or until it is no longer divisible),
+// keeping the pieces in order
+template<typename Range>
+void split_range(Range range, size_t depth, std::vector<Range>& pieces) {
+    if (depth == 0 || !range.is_divisible()) {
+        pieces.push_back(range);
+        return;
+    }
+    Range upper = range.split();
+    split_range(range, depth - 1, pieces);
+    split_range(upper, depth - 1, pieces);
+}
+
+// Call body on each grain-sized tile of range, in order
+template<typename Range, typename Body>
+void for_each_tile(Range range, Body& body) {
+    while (range.is_divisible()) {
+        Range upper = range.split();
+        for_each_tile(range, body);
+        range = upper;
+    }
+    body(range);
+}
+
+} // namespace detail
+
+// Range-based parallel for - splits a blocked_range / blocked_range2d /
+// blocked_range3d down to its grain sizes and calls body(subrange) once per
+// tile, so the body can iterate a whole cache-sized block itself. Only the
+// top of the split tree becomes tasks (about range_tasks_per_thread per
+// worker); each task splits its part down to tiles on its own.
+template<typename Range, typename Body>
+void parallel_for(ThreadPool& pool, const Range& range, Body&& body) {
+    if (range.empty()) return;
+
+    size_t depth = 0;
+    while ((size_t{1} << depth) < pool.thread_count() * config::parallel_alg::range_tasks_per_thread) {
+        ++depth;
+    }
+    std::vector<Range> pieces;
+    detail::split_range(range, depth, pieces);
+
+    if (pieces.size() == 1) {
+        detail::for_each_tile(pieces.front(), body);
+        return;
+    }
+
+    std::vector<std::future<void>> futures;
+    std::vector<Task> batch;
+    futures.reserve(pieces.size());
+    batch.reserve(pieces.size());
+
+    for (const Range& piece : pieces) {
+        futures.push_back(detail::add_chunk(batch, [piece, &body]() {
+            detail::for_each_tile(piece, body);
+        }));
+    }
+    pool.submit_batch(batch);
+
+    detail::wait_all(futures);
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
+// Describes the array a chunked loop walks so chunk boundaries can land on
+// cache-line boundaries of that array. element_size == 0 disables alignment.
+struct ChunkAlignment {
+    std::uintptr_t base = 0;
+    size_t element_size = 0;
+    size_t bytes = config::parallel_alg::cache_line_size;
+};
+
+// Align chunks to `bytes` boundaries of data[] (data[i] is index i)
+template<typename T>
+ChunkAlignment align_chunks_to(const T* data, size_t bytes = config::parallel_alg::cache_line_size) {
+    return ChunkAlignment{reinterpret_cast<std::uintptr_t>(data), sizeof(T), bytes};
+}
+
+namespace detail {
+
+// Split [begin, end) into contiguous chunks of about chunk_size. With a usable
+// alignment every chunk except the first starts on an aligned element and
+// chunk_size is rounded up to whole lines.
+template<typename IndexType>
+std::vector<std::pair<IndexType, IndexType>> chunk_ranges(IndexType begin, IndexType end,
+                                                          size_t chunk_size,
+                                                          const ChunkAlignment& align) {
+    std::vector<std::pair<IndexType, IndexType>> chunks;
+    if (begin >= end) return chunks;
+    if (chunk_size == 0) chunk_size = 1;
+
+    size_t lead = 0;
+    size_t es = align.element_size;
+    if (es != 0 && align.bytes % es == 0 && align.base % es == 0) {
+        size_t per_line = align.bytes / es;
+        chunk_size = (chunk_size + per_line - 1) / per_line * per_line;
+        std::uintptr_t first = align.base + static_cast<std::uintptr_t>(begin) * es;
+        size_t misalign = first % align.bytes;
+        lead = misalign == 0 ? 0 : (align.bytes - misalign) / es;
+    }
+
+    size_t range = static_cast<size_t>(end - begin);
+    chunks.reserve(range / chunk_size + 2);
+    size_t offset = 0;
+    size_t next = std::min(range, lead + chunk_size);
+    while (offset < range) {
+        chunks.emplace_back(begin + static_cast<IndexType>(offset),
+                            begin + static_cast<IndexType>(next));
+        offset = next;
+        next = std::min(range, next + chunk_size);
+    }
+    return chunks;
+}
+
+// Run body(first, last) for every chunk, sending chunk i to the worker the
+// partitioner recorded for it and recording who actually ran it
+template<typename IndexType, typename Body>
+void run_chunks_with_affinity(ThreadPool& pool,
+                              const std::vector<std::pair<IndexType, IndexType>>& chunks,
+                              affinity_partitioner& partitioner, Body& body) {
+    partitioner.prepare(chunks.size(), pool.thread_count());
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(chunks.size());
+    // One batch per worker; only shutdown can refuse one partway through
+    std::vector<std::vector<Task>> batches(pool.thread_count());
+
+    for (size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+        IndexType first = chunks[chunk].first;
+        IndexType last = chunks[chunk].second;
+        futures.push_back(add_chunk(batches[partitioner.preferred_worker(chunk)],
+            [chunk, first, last, &pool, &partitioner, &body]() {
+                partitioner.record(chunk, pool.current_worker());
+                body(first, last);
+            }));
+    }
+    try {
+        for (size_t w = 0; w < batches.size(); ++w) {
+            pool.submit_batch_to(w, batches[w]);
+        }
+    } catch (...) {
+        batches.clear();  // breaks the futures of chunks never queued
+        wait_all(futures);
+        throw;
+    }
+
+    wait_all(futures);
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
+} // namespace detail
+
+// Chunked parallel for - calls body(first, last) on contiguous subranges of
+// [begin, end) instead of once per index, so the body can run a tight
+// vectorisable loop. Pass align_chunks_to(array) to start chunks on cache
+// lines of that array and avoid split lines between workers.
+template<typename IndexType, typename Body>
+void parallel_for_chunked(ThreadPool& pool, IndexType begin, IndexType end, Body&& body,
+                          size_t chunk_size = config::parallel_alg::chunk_size,
+                          const ChunkAlignment& align = {}) {
+    auto chunks = detail::chunk_ranges(begin, end, chunk_size, align);
+    if (chunks.empty()) return;
+
+    if (chunks.size() == 1) {
+        body(chunks.front().first, chunks.front().second);
+        return;
+    }
+
+    std::vector<std::future<void>> futures;
+    std::vector<Task> batch;
+    futures.reserve(chunks.size());
+    batch.reserve(chunks.size());
+
+    for (const auto& chunk : chunks) {
+        IndexType first = chunk.first;
+        IndexType last = chunk.second;
+        futures.push_back(detail::add_chunk(batch, [first, last, &body]() {
+            body(first, last);
+        }));
+    }
+    pool.submit_batch(batch);
+
+    detail::wait_all(futures);
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
+// Parallel for that replays the chunk-to-worker mapping recorded in
+// `partitioner` by the previous call, for loops run repeatedly over the
+// same data (iterative solvers, time stepping)
+template<typename IndexType, typename Func>
+void parallel_for(ThreadPool& pool, IndexType start, IndexType end, Func&& func,
+                  affinity_partitioner& partitioner,
+                  size_t chunk_size = config::parallel_alg::chunk_size) {
+    auto chunks = detail::chunk_ranges(start, end, chunk_size, ChunkAlignment{});
+    if (chunks.empty()) return;
+
+    auto body = [&func](IndexType first, IndexType last) {
+        for (IndexType i = first; i < last; ++i) {
+            func(i);
+        }
+    };
+    detail::run_chunks_with_affinity(pool, chunks, partitioner, body);
+}
+
+// Chunked parallel for with affinity replay
+template<typename IndexType, typename Body>
+void parallel_for_chunked(ThreadPool& pool, IndexType begin, IndexType end, Body&& body,
+                          affinity_partitioner& partitioner,
+                          size_t chunk_size = config::parallel_alg::chunk_size,
+                          const ChunkAlignment& align = {}) {
+    auto chunks = detail::chunk_ranges(begin, end, chunk_size, align);
+    if (chunks.empty()) return;
+
+    detail::run_chunks_with_affinity(pool, chunks, partitioner, body);
+}
+
+// Parallel for with an explicit loop schedule (see Schedule in partitioner.h)
+template<typename IndexType, typename Func>
+void parallel_for(ThreadPool& pool, IndexType start, IndexType end, Func&& func, Schedule schedule) {
+    if (start >= end) return;
+
+    const size_t range = static_cast<size_t>(end - start);
+    const size_t workers = pool.thread_count();
+
+    auto run = [&func, start](size_t first, size_t last) {
+        for (IndexType i = start + static_cast<IndexType>(first);
+             i < start + static_cast<IndexType>(last); ++i) {
+            func(i);
+        }
+    };
+
+    if (schedule.kind == Schedule::Kind::Auto) {
+        schedule = Schedule::Guided();
+    }
+
+    // Dynamic / Guided: runners claim [first, last) slices from a shared
+    // cursor until it passes the end. Declared out here so they outlive
+    // the runners, which are waited for below.
+    std::atomic<size_t> cursor{0};
+    const bool guided = schedule.kind == Schedule::Kind::Guided;
+    const size_t min_chunk = schedule.chunk;
+
+    auto claim = [&cursor, range, workers, guided, min_chunk](size_t& first, size_t& last) {
+        size_t current = cursor.load(std::memory_order_relaxed);
+        while (current < range) {
+            size_t remaining = range - current;
+            size_t size = guided ? std::max(min_chunk, remaining / (2 * workers)) : min_chunk;
+            size = std::min(size, remaining);
+            if (!guided) {
+                current = cursor.fetch_add(size, std::memory_order_relaxed);
+                if (current >= range) return false;
+                first = current;
+                last = std::min(range, current + size);
+                return true;
+            }
+            if (cursor.compare_exchange_weak(current, current + size,
+                                             std::memory_order_relaxed)) {
+                first = current;
+                last = current + size;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(workers);
+
+    if (schedule.kind == Schedule::Kind::Static) {
+        // One block per worker, placed in that worker's own queue
+        size_t blocks = std::min(workers, range);
+        std::vector<std::vector<Task>> batches(blocks);
+        for (size_t b = 0; b < blocks; ++b) {
+            size_t first = range * b / blocks;
+            size_t last = range * (b + 1) / blocks;
+            futures.push_back(detail::add_chunk(batches[b], [first, last, &run]() {
+                run(first, last);
+            }));
+        }
+        try {
+            for (size_t b = 0; b < blocks; ++b) {
+                pool.submit_batch_to(b, batches[b]);
+            }
+        } catch (...) {
+            batches.clear();
+            detail::wait_all(futures);
+            throw;
+        }
+    } else {
+        size_t runners = std::min(workers, (range + min_chunk - 1) / min_chunk);
+        std::vector<Task> batch;
+        batch.reserve(runners);
+        for (size_t r = 0; r < runners; ++r) {
+            futures.push_back(detail::add_chunk(batch, [&claim, &run]() {
+                size_t first = 0, last = 0;
+                while (claim(first, last)) {
+                    run(first, last);
+                }
+            }));
+        }
+        pool.submit_batch(batch);
+    }
+
+    detail::wait_all(futures);
     for (auto& future : futures) {
         future.get();
     }
@@ -0,0 +1,143 @@
+#ifndef PARALLEL_FOR_EACH_H
+#define PARALLEL_FOR_EACH_H
+
+#include <runtime/thread_pool.h>
+#include <runtime/parallel_for.h>
+#include <runtime/config.h>
+#include <vector>
+#include <future>
+#include <iterator>
+#include <type_traits>
+
+namespace runtime {
+
+namespace detail {
+
+template<typename It>
+constexpr bool is_random_access_v = std::is_base_of<
+    std::random_access_iterator_tag,
+    typename std::iterator_traits<It>::iterator_category>::value;
+
+// Iterator ranges cannot be probed for cost cheaply; fall back to the default
+inline size_t iterator_chunk_size(size_t chunk_size) {
+    return chunk_size == config::parallel_alg::auto_chunk ? config::parallel_alg::chunk_size
+                                                          : chunk_size;
+}
+
+// Splitter for forward iterators: the calling thread walks the sequence
+// once, cutting it into chunk_size-element pieces and submitting each
+// piece as soon as its start is known, so workers are already running the
+// front of the sequence while the caller is still walking the rest.
+// run(first, count) processes one piece; each goes in as a batch of one
+// (see add_chunk). Every piece is waited for before the first exception
+// (if any) is rethrown. Returns the iterator the walk
+// ended on (equal to last).
+template<typename ForwardIt, typename RunChunk>
+ForwardIt run_forward_chunks(ThreadPool& pool, ForwardIt first, ForwardIt last,
+                             size_t chunk_size, RunChunk& run) {
+    std::vector<std::future<void>> futures;
+
+    try {
+        while (first != last) {
+            ForwardIt chunk_begin = first;
+            size_t count = 0;
+            while (first != last && count < chunk_size) {
+                ++first;
+                ++count;
+            }
+            if (first == last && futures.empty()) {
+                run(chunk_begin, count);
+                return first;
+            }
+            std::vector<Task> piece;
+            futures.push_back(add_chunk(piece, [chunk_begin, count, &run]() {
+                run(chunk_begin, count);
+            }));
+            pool.submit_batch(piece);
+        }
+    } catch (...) {
+        // The iterator threw, or the pool is shutting down
+        wait_all(futures);
+        throw;
+    }
+
+    wait_all(futures);
+    for (auto& future : futures) {
+        future.get();
+    }
+    return first;
+}
+
+} // namespace detail
+
+// Call func(element) for every element of [first, last).
+// Random-access ranges are split by index in O(1) and each chunk runs the
+// same loop as parallel_for over indices; other forward iterators go
+// through a chunking splitter (see detail::run_forward_chunks). Either
+// way every chunk has finished before the first exception is rethrown.
+template<typename Iterator, typename Func>
+void parallel_for_each(ThreadPool& pool, Iterator first, Iterator last, Func&& func,
+                       size_t chunk_size = config::parallel_alg::chunk_size) {
+    if constexpr (detail::is_random_access_v<Iterator>) {
+        const size_t n = static_cast<size_t>(last - first);
+        parallel_for(pool, size_t(0), n, [first, &func](size_t i) {
+            func(first[static_cast<typename std::iterator_traits<Iterator>::difference_type>(i)]);
+        }, chunk_size);
+    } else {
+        auto run = [&func](Iterator it, size_t count) {
+            for (; count > 0; --count, ++it) {
+                func(*it);
+            }
+        };
+        detail::run_forward_chunks(pool, first, last, detail::iterator_chunk_size(chunk_size), run);
+    }
+}
+
+// out[k] = func(in[k]) for every element of [in_first, in_last), like
+// std::transform. out must be a forward iterator (not e.g. a back_inserter)
+// and the output range must hold enough elements. Returns the end of the
+// output range. Random-access inputs and outputs are split by index;
+// otherwise input and output are walked together by the chunking splitter.
+template<typename InputIt, typename OutputIt, typename Func>
+OutputIt parallel_transform(ThreadPool& pool, InputIt in_first, InputIt in_last, OutputIt out,
+                            Func&& func, size_t chunk_size = config::parallel_alg::chunk_size) {
+    static_assert(std::is_base_of<std::forward_iterator_tag,
+                                  typename std::iterator_traits<OutputIt>::iterator_category>::value,
+                  "parallel_transform needs a forward output iterator");
+
+    if constexpr (detail::is_random_access_v<InputIt> && detail::is_random_access_v<OutputIt>) {
+        using InDiff = typename std::iterator_traits<InputIt>::difference_type;
+        using OutDiff = typename std::iterator_traits<OutputIt>::difference_type;
+        const size_t n = static_cast<size_t>(in_last - in_first);
+        parallel_for(pool, size_t(0), n, [in_first, out, &func](size_t i) {
+            out[static_cast<OutDiff>(i)] = func(in_first[static_cast<InDiff>(i)]);
+        }, chunk_size);
+        return out + static_cast<OutDiff>(n);
+    } else {
+        // Pair each input position with its output position while walking;
+        // only the input half takes part in the end-of-range test
+        struct Cursor {
+            InputIt in;
+            OutputIt out;
+            bool operator==(const Cursor& other) const { return in == other.in; }
+            bool operator!=(const Cursor& other) const { return in != other.in; }
+            Cursor& operator++() {
+                ++in;
+                ++out;
+                return *this;
+            }
+        };
+        auto run = [&func](Cursor cursor, size_t count) {
+            for (; count > 0; --count, ++cursor) {
+                *cursor.out = func(*cursor.in);
+            }
+        };
+        Cursor end = detail::run_forward_chunks(pool, Cursor{in_first, out}, Cursor{in_last, out},
+                                                detail::iterator_chunk_size(chunk_size), run);
+        return end.out;
+    }
+}
+
+} // namespace runtime
+
+#endif // PARALLEL_FOR_EACH_H
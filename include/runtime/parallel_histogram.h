@@ -0,0 +1,188 @@
+#ifndef PARALLEL_HISTOGRAM_H
+#define PARALLEL_HISTOGRAM_H
+
+#include <runtime/thread_pool.h>
+#include <runtime/parallel_for.h>
+#include <runtime/blocked_range.h>
+#include <runtime/config.h>
+#include <vector>
+#include <future>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <numeric>
+
+namespace runtime {
+
+namespace detail {
+
+// Allocator for the per-runner rows: with a padded stride, every row then
+// starts on a cache line of its own
+template<typename T>
+struct CacheLineAllocator {
+    using value_type = T;
+    static constexpr std::align_val_t alignment{
+        std::max(alignof(T), config::parallel_alg::cache_line_size)};
+
+    CacheLineAllocator() = default;
+    template<typename U>
+    CacheLineAllocator(const CacheLineAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), alignment));
+    }
+    void deallocate(T* p, size_t) noexcept {
+        ::operator delete(static_cast<void*>(p), alignment);
+    }
+
+    template<typename U>
+    bool operator==(const CacheLineAllocator<U>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const CacheLineAllocator<U>&) const noexcept { return false; }
+};
+
+template<typename T>
+using PrivateRows = std::vector<T, CacheLineAllocator<T>>;
+
+// Run accumulate(row, first, last) over [begin, end) with one runner task per
+// worker. Each runner claims chunks from a shared cursor and accumulates into
+// its own row of `rows` (stride `row_stride` elements), so no two runners
+// ever write the same accumulator.
+template<typename IndexType, typename Acc, typename Accumulate>
+void run_privatized(ThreadPool& pool, IndexType begin, IndexType end, size_t chunk,
+                    PrivateRows<Acc>& rows, size_t row_stride, size_t runners,
+                    Accumulate& accumulate) {
+    const size_t range = static_cast<size_t>(end - begin);
+    std::atomic<size_t> cursor{0};
+    std::vector<std::future<void>> futures;
+    std::vector<Task> batch;
+    futures.reserve(runners);
+    batch.reserve(runners);
+
+    for (size_t r = 0; r < runners; ++r) {
+        futures.push_back(add_chunk(batch, [r, begin, range, chunk, row_stride,
+                                            &cursor, &rows, &accumulate]() {
+            Acc* row = rows.data() + r * row_stride;
+            for (size_t first = cursor.fetch_add(chunk, std::memory_order_relaxed);
+                 first < range;
+                 first = cursor.fetch_add(chunk, std::memory_order_relaxed)) {
+                size_t last = std::min(range, first + chunk);
+                accumulate(row, begin + static_cast<IndexType>(first),
+                           begin + static_cast<IndexType>(last));
+            }
+        }));
+    }
+
+    pool.submit_batch(batch);
+    wait_all(futures);
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
+// Rows padded to whole cache lines so neighbouring runners never share one:
+// the stride is a multiple of the fewest elements that fill whole lines
+template<typename Acc>
+size_t padded_stride(size_t groups) {
+    const size_t line = config::parallel_alg::cache_line_size;
+    size_t per_lines = line / std::gcd(line, sizeof(Acc));
+    return (groups + per_lines - 1) / per_lines * per_lines;
+}
+
+template<typename IndexType>
+size_t claim_chunk(const blocked_range<IndexType>& range) {
+    return range.grainsize() > 1 ? range.grainsize()
+                                 : static_cast<size_t>(config::parallel_alg::chunk_size);
+}
+
+} // namespace detail
+
+// Count key_fn(i) for every i in range into `bins` buckets. Keys outside
+// [0, bins) are ignored. Each worker fills a private histogram (keys are
+// computed in batches, then counted in a tight loop) and the private
+// histograms are summed in parallel across bins at the end.
+// Chunks claimed per step come from range.grainsize() (or the default chunk size).
+template<typename IndexType, typename KeyFn>
+std::vector<size_t> parallel_histogram(ThreadPool& pool, const blocked_range<IndexType>& range,
+                                       size_t bins, KeyFn&& key_fn) {
+    std::vector<size_t> result(bins, 0);
+    if (range.empty() || bins == 0) return result;
+
+    const size_t runners = std::min(pool.thread_count(),
+                                    (range.size() + detail::claim_chunk(range) - 1) / detail::claim_chunk(range));
+    const size_t stride = detail::padded_stride<size_t>(bins);
+    detail::PrivateRows<size_t> rows(runners * stride, 0);
+
+    auto accumulate = [&key_fn, bins](size_t* row, IndexType first, IndexType last) {
+        constexpr size_t batch = 256;
+        size_t keys[batch];
+        while (first < last) {
+            size_t n = std::min(batch, static_cast<size_t>(last - first));
+            for (size_t k = 0; k < n; ++k) {
+                keys[k] = static_cast<size_t>(key_fn(first + static_cast<IndexType>(k)));
+            }
+            for (size_t k = 0; k < n; ++k) {
+                if (keys[k] < bins) row[keys[k]]++;
+            }
+            first += static_cast<IndexType>(n);
+        }
+    };
+    detail::run_privatized(pool, range.begin(), range.end(), detail::claim_chunk(range),
+                           rows, stride, runners, accumulate);
+
+    // Parallel merge: each task sums every runner's counts for a band of bins
+    parallel_for_chunked(pool, size_t(0), bins, [&](size_t first, size_t last) {
+        for (size_t r = 0; r < runners; ++r) {
+            const size_t* row = rows.data() + r * stride;
+            for (size_t b = first; b < last; ++b) {
+                result[b] += row[b];
+            }
+        }
+    }, std::max<size_t>(config::parallel_alg::chunk_size, bins / (pool.thread_count() * 4)));
+
+    return result;
+}
+
+// Dense group-by: for every i in range, fold value_fn(i) into group key_fn(i)
+// with combine(accumulator, value). Groups are [0, groups); other keys are
+// ignored. Accumulators are privatised per worker, start at init, and are
+// merged across workers with combine, one band of groups per task.
+// As with parallel_reduce, init must be the identity of combine and
+// combine must be associative.
+template<typename IndexType, typename T, typename KeyFn, typename ValueFn, typename Combine>
+std::vector<T> parallel_group_aggregate(ThreadPool& pool, const blocked_range<IndexType>& range,
+                                        size_t groups, KeyFn&& key_fn, ValueFn&& value_fn,
+                                        T init, Combine&& combine) {
+    std::vector<T> result(groups, init);
+    if (range.empty() || groups == 0) return result;
+
+    const size_t runners = std::min(pool.thread_count(),
+                                    (range.size() + detail::claim_chunk(range) - 1) / detail::claim_chunk(range));
+    const size_t stride = detail::padded_stride<T>(groups);
+    detail::PrivateRows<T> rows(runners * stride, init);
+
+    auto accumulate = [&key_fn, &value_fn, &combine, groups](T* row, IndexType first, IndexType last) {
+        for (IndexType i = first; i < last; ++i) {
+            size_t key = static_cast<size_t>(key_fn(i));
+            if (key < groups) row[key] = combine(row[key], value_fn(i));
+        }
+    };
+    detail::run_privatized(pool, range.begin(), range.end(), detail::claim_chunk(range),
+                           rows, stride, runners, accumulate);
+
+    parallel_for_chunked(pool, size_t(0), groups, [&](size_t first, size_t last) {
+        for (size_t r = 0; r < runners; ++r) {
+            const T* row = rows.data() + r * stride;
+            for (size_t g = first; g < last; ++g) {
+                result[g] = combine(result[g], row[g]);
+            }
+        }
+    }, std::max<size_t>(config::parallel_alg::chunk_size, groups / (pool.thread_count() * 4)));
+
+    return result;
+}
+
+} // namespace runtime
+
+#endif // PARALLEL_HISTOGRAM_H
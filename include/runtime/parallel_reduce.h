@@ -3,19 +3,90 @@
 
 #include <runtime/thread_pool.h>
 #include <runtime/config.h>
+#include <runtime/parallel_for.h>
+#include <runtime/adaptive_grain.h>
+#include <runtime/fork_join.h>
 #include <vector>
 #include <future>
 #include <functional>
+#include <chrono>
+#include <type_traits>
+#include <algorithm>
 
 namespace runtime {
 
-// Parallel reduction - combines elements in range [start, end) using binary operation
+namespace detail {
+
+// auto_chunk mode for parallel_reduce; see adaptive_parallel_for
+template<typename IndexType, typename T, typename Func, typename ReduceOp>
+T adaptive_parallel_reduce(ThreadPool& pool, IndexType start, IndexType end, T init,
+                           Func& map_func, ReduceOp& reduce_op) {
+    auto& estimate = grain_cost_estimate<std::decay_t<Func>>();
+    const double target_ns = std::chrono::duration<double, std::nano>(pool.target_chunk_duration()).count();
+    const size_t range = static_cast<size_t>(end - start);
+
+    auto reduce_range = [&map_func, &reduce_op, start](T partial, size_t first, size_t last) {
+        for (IndexType i = start + static_cast<IndexType>(first);
+             i < start + static_cast<IndexType>(last); ++i) {
+            partial = reduce_op(partial, map_func(i));
+        }
+        return partial;
+    };
+
+    T result = init;
+    size_t done = 0;
+    if (estimate.load(std::memory_order_relaxed) == 0.0) {
+        done = probe_grain_cost(range, [&](size_t first, size_t last) {
+            result = reduce_range(result, first, last);
+        }, estimate, target_ns);
+    }
+
+    size_t remaining = range - done;
+    if (remaining == 0) return result;
+
+    double ns = estimate.load(std::memory_order_relaxed);
+    if (ns * static_cast<double>(remaining) <= target_ns) {
+        return reduce_range(result, done, range);
+    }
+
+    size_t chunk = adaptive_chunk_size(ns, remaining, pool.thread_count(), target_ns);
+    std::vector<std::future<T>> futures;
+    std::vector<Task> batch;
+    futures.reserve((remaining + chunk - 1) / chunk);
+    batch.reserve(futures.capacity());
+
+    for (size_t first = done; first < range; first += chunk) {
+        size_t last = std::min(range, first + chunk);
+        futures.push_back(add_chunk(batch, [first, last, init, &reduce_range, &estimate]() -> T {
+            auto begin = std::chrono::steady_clock::now();
+            T partial = reduce_range(init, first, last);
+            record_grain_cost(estimate, elapsed_ns(begin) / static_cast<double>(last - first));
+            return partial;
+        }));
+    }
+
+    pool.submit_batch(batch);
+    wait_all(futures);
+    for (auto& future : futures) {
+        result = reduce_op(result, future.get());
+    }
+    return result;
+}
+
+} // namespace detail
+
+// Parallel reduction - combines elements in range [start, end) using binary operation.
+// Pass config::parallel_alg::auto_chunk as chunk_size to size chunks from measured cost.
 template<typename IndexType, typename T, typename Func, typename ReduceOp>
 T parallel_reduce(ThreadPool& pool, IndexType start, IndexType end, T init, 
                   Func&& map_func, ReduceOp&& reduce_op,
                   size_t chunk_size = config::parallel_alg::chunk_size) {
     if (start >= end) return init;
     
+    if (chunk_size == config::parallel_alg::auto_chunk) {
+        return detail::adaptive_parallel_reduce(pool, start, end, init, map_func, reduce_op);
+    }
+    
     IndexType range = end - start;
     if (range <= static_cast<IndexType>(chunk_size)) {
         // Range too small, execute sequentially
@@ -29,14 +100,16 @@ T parallel_reduce(ThreadPool& pool, IndexType start, IndexType end, T init,
     // Calculate number of chunks
     size_t num_chunks = (range + chunk_size - 1) / chunk_size;
     std::vector<std::future<T>> futures;
+    std::vector<Task> batch;
     futures.reserve(num_chunks);
+    batch.reserve(num_chunks);
     
     // Submit chunks - each chunk produces a partial result
     for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
         IndexType chunk_start = start + chunk * chunk_size;
         IndexType chunk_end = std::min(chunk_start + static_cast<IndexType>(chunk_size), end);
         
-        futures.push_back(pool.submit_task([chunk_start, chunk_end, init, &map_func, &reduce_op]() -> T {
+        futures.push_back(detail::add_chunk(batch, [chunk_start, chunk_end, init, &map_func, &reduce_op]() -> T {
             T partial = init;
             for (IndexType i = chunk_start; i < chunk_end; ++i) {
                 partial = reduce_op(partial, map_func(i));
@@ -44,8 +117,10 @@ T parallel_reduce(ThreadPool& pool, IndexType start, IndexType end, T init,
             return partial;
         }));
     }
+    pool.submit_batch(batch);
     
     // Combine all partial results
+    detail::wait_all(futures);
     T final_result = init;
     for (auto& future : futures) {
         final_result = reduce_op(final_result, future.get());
@@ -54,6 +129,100 @@ T parallel_reduce(ThreadPool& pool, IndexType start, IndexType end, T init,
     return final_result;
 }
 
+// Chunked reduction - chunk_func(first, last) reduces a contiguous subrange
+// itself (e.g. a vectorised dot-product loop) and reduce_op combines the
+// per-chunk results in chunk order
+template<typename IndexType, typename T, typename ChunkFunc, typename ReduceOp>
+T parallel_reduce_chunked(ThreadPool& pool, IndexType begin, IndexType end, T init,
+                          ChunkFunc&& chunk_func, ReduceOp&& reduce_op,
+                          size_t chunk_size = config::parallel_alg::chunk_size,
+                          const ChunkAlignment& align = {}) {
+    auto chunks = detail::chunk_ranges(begin, end, chunk_size, align);
+    if (chunks.empty()) return init;
+
+    if (chunks.size() == 1) {
+        return reduce_op(init, chunk_func(chunks.front().first, chunks.front().second));
+    }
+
+    std::vector<std::future<T>> futures;
+    std::vector<Task> batch;
+    futures.reserve(chunks.size());
+    batch.reserve(chunks.size());
+
+    for (const auto& chunk : chunks) {
+        IndexType first = chunk.first;
+        IndexType last = chunk.second;
+        futures.push_back(detail::add_chunk(batch, [first, last, &chunk_func]() -> T {
+            return chunk_func(first, last);
+        }));
+    }
+    pool.submit_batch(batch);
+
+    detail::wait_all(futures);
+    T final_result = init;
+    for (auto& future : futures) {
+        final_result = reduce_op(final_result, future.get());
+    }
+
+    return final_result;
+}
+
+namespace detail {
+
+// Reduce leaves [lo, hi) of a deterministic reduction: split the leaf range
+// in half, reduce both halves in parallel, combine left with right
+template<typename IndexType, typename T, typename Func, typename ReduceOp>
+T deterministic_reduce_leaves(ThreadPool& pool, IndexType start, IndexType end, size_t grain,
+                              size_t lo, size_t hi, Func& map_func, ReduceOp& reduce_op) {
+    if (hi - lo == 1) {
+        IndexType first = start + static_cast<IndexType>(lo * grain);
+        IndexType last = std::min(end, static_cast<IndexType>(first + static_cast<IndexType>(grain)));
+        T partial = map_func(first);
+        for (IndexType i = first + 1; i < last; ++i) {
+            partial = reduce_op(partial, map_func(i));
+        }
+        return partial;
+    }
+
+    size_t mid = lo + (hi - lo) / 2;
+    T left{};
+    T right{};
+    fork_join(pool,
+        [&]() { left = deterministic_reduce_leaves<IndexType, T>(pool, start, end, grain, lo, mid, map_func, reduce_op); },
+        [&]() { right = deterministic_reduce_leaves<IndexType, T>(pool, start, end, grain, mid, hi, map_func, reduce_op); });
+    return reduce_op(left, right);
+}
+
+} // namespace detail
+
+// Reproducible reduction. The range is cut into leaves of exactly `grain`
+// indices (the last may be shorter) and the leaves are combined by a fixed
+// balanced binary tree, so the order of every reduce_op call depends only
+// on the range size and grain - never on thread count, chunk placement or
+// steal order. Floating-point results are bitwise identical from run to
+// run and across pool sizes. init is combined once, at the root.
+// T must be default constructible.
+template<typename IndexType, typename T, typename Func, typename ReduceOp>
+T parallel_deterministic_reduce(ThreadPool& pool, IndexType start, IndexType end, T init,
+                                Func&& map_func, ReduceOp&& reduce_op,
+                                size_t grain = config::parallel_alg::chunk_size) {
+    if (start >= end) return init;
+    if (grain == 0) grain = 1;
+
+    const size_t range = static_cast<size_t>(end - start);
+    const size_t leaves = (range + grain - 1) / grain;
+
+    auto reduce_all = [&]() {
+        return reduce_op(init, detail::deterministic_reduce_leaves<IndexType, T>(
+            pool, start, end, grain, 0, leaves, map_func, reduce_op));
+    };
+
+    if (leaves == 1) {
+        return reduce_all();
+    }
+    return detail::run_in_pool(pool, reduce_all);
+}
+
 // Overload that creates its own thread pool
 template<typename IndexType, typename T, typename Func, typename ReduceOp>
 T parallel_reduce(IndexType start, IndexType end, T init, 
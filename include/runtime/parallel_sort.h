@@ -0,0 +1,294 @@
+#ifndef PARALLEL_SORT_H
+#define PARALLEL_SORT_H
+
+#include <runtime/thread_pool.h>
+#include <runtime/fork_join.h>
+#include <runtime/config.h>
+#include <vector>
+#include <memory>
+#include <new>
+#include <iterator>
+#include <functional>
+#include <algorithm>
+#include <utility>
+#include <cstddef>
+
+// Parallel building blocks for sort/merge style pipelines. Everything here
+// recurses through fork_join instead of waiting on futures, so these calls
+// may be nested inside tasks (and inside each other) without blocking
+// workers. All iterators must be random access.
+
+namespace runtime {
+
+namespace detail {
+
+// Raw storage for n elements of T. Callers construct elements into it
+// (possibly from several tasks) and report how many leading slots are
+// live with set_constructed(); only those are destroyed.
+template<typename T>
+class ScratchBuffer {
+    public:
+        explicit ScratchBuffer(size_t n)
+            : data_(static_cast<T*>(::operator new(std::max<size_t>(1, n) * sizeof(T)))) {}
+
+        ~ScratchBuffer() {
+            for (size_t i = 0; i < constructed_; ++i) {
+                data_[i].~T();
+            }
+            ::operator delete(static_cast<void*>(data_));
+        }
+
+        ScratchBuffer(const ScratchBuffer&) = delete;
+        ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+        T* data() { return data_; }
+        void set_constructed(size_t n) { constructed_ = n; }
+
+    private:
+        T* data_;
+        size_t constructed_ = 0;
+};
+
+// Number of blocks for the count / prefix / scatter algorithms: enough for
+// every worker to get several, none smaller than the default chunk
+inline size_t block_count(ThreadPool& pool, size_t n) {
+    size_t by_size = n / config::parallel_alg::chunk_size;
+    return std::max<size_t>(1, std::min(by_size, pool.thread_count() * 8));
+}
+
+inline size_t block_begin(size_t block, size_t blocks, size_t n) {
+    return n / blocks * block + std::min(block, n % blocks);
+}
+
+// Number of elements taken from the first input among the first `diag`
+// outputs of a stable merge of a[0, n1) and b[0, n2) (the merge-path
+// co-rank). Ties go to a, so the merge is stable.
+template<typename It1, typename It2, typename Compare>
+size_t merge_co_rank(size_t diag, It1 a, size_t n1, It2 b, size_t n2, Compare& comp) {
+    size_t lo = diag > n2 ? diag - n2 : 0;
+    size_t hi = std::min(diag, n1);
+    while (lo < hi) {
+        size_t i = lo + (hi - lo) / 2;
+        size_t j = diag - i;
+        if (comp(b[j - 1], a[i])) {
+            hi = i;
+        } else {
+            lo = i + 1;
+        }
+    }
+    return lo;
+}
+
+// Stable merge of [a, a + n1) and [b, b + n2) into out. The output is cut
+// into equal pieces; each piece's input bounds come from merge_co_rank, so
+// pieces are merged independently with no further coordination.
+template<typename It1, typename It2, typename OutIt, typename Compare>
+void merge_pieces(ThreadPool& pool, It1 a, size_t n1, It2 b, size_t n2, OutIt out, Compare& comp) {
+    const size_t total = n1 + n2;
+    const size_t grain = config::parallel_alg::sort_grain;
+    if (total <= grain) {
+        std::merge(a, a + n1, b, b + n2, out, comp);
+        return;
+    }
+
+    const size_t pieces = (total + grain - 1) / grain;
+    fork_join_for(pool, size_t(0), pieces, 1, [&](size_t first, size_t last) {
+        for (size_t p = first; p < last; ++p) {
+            size_t d0 = total / pieces * p + std::min(p, total % pieces);
+            size_t d1 = total / pieces * (p + 1) + std::min(p + 1, total % pieces);
+            size_t i0 = merge_co_rank(d0, a, n1, b, n2, comp);
+            size_t i1 = merge_co_rank(d1, a, n1, b, n2, comp);
+            std::merge(a + i0, a + i1, b + (d0 - i0), b + (d1 - i1), out + d0, comp);
+        }
+    });
+}
+
+// Merge sort of the n elements at src using dst as scratch. The sorted
+// result ends in dst if into_dst, otherwise back in src. Halves are sorted
+// with fork_join and merged with merge_pieces, alternating direction so no
+// level copies data back.
+template<typename SrcIt, typename DstIt, typename Compare>
+void merge_sort(ThreadPool& pool, SrcIt src, DstIt dst, size_t n, bool into_dst, Compare& comp) {
+    if (n <= config::parallel_alg::sort_grain) {
+        std::stable_sort(src, src + n, comp);
+        if (into_dst) std::move(src, src + n, dst);
+        return;
+    }
+
+    const size_t half = n / 2;
+    fork_join(pool,
+        [&]() { merge_sort(pool, src, dst, half, !into_dst, comp); },
+        [&]() { merge_sort(pool, src + half, dst + half, n - half, !into_dst, comp); });
+
+    if (into_dst) {
+        merge_pieces(pool, std::make_move_iterator(src), half,
+                     std::make_move_iterator(src + half), n - half, dst, comp);
+    } else {
+        merge_pieces(pool, std::make_move_iterator(dst), half,
+                     std::make_move_iterator(dst + half), n - half, src, comp);
+    }
+}
+
+} // namespace detail
+
+// Stable merge of two sorted ranges into out (which must not overlap the
+// inputs), like std::merge. Returns the end of the output.
+template<typename It1, typename It2, typename OutIt, typename Compare = std::less<>>
+OutIt parallel_merge(ThreadPool& pool, It1 first1, It1 last1, It2 first2, It2 last2,
+                     OutIt out, Compare comp = Compare()) {
+    const size_t n1 = static_cast<size_t>(last1 - first1);
+    const size_t n2 = static_cast<size_t>(last2 - first2);
+    detail::run_in_pool(pool, [&]() {
+        detail::merge_pieces(pool, first1, n1, first2, n2, out, comp);
+    });
+    return out + (n1 + n2);
+}
+
+// Stable sort, like std::stable_sort. Uses one scratch buffer of n
+// elements; values are moved, never copied, and need not be default
+// constructible.
+template<typename RandomIt, typename Compare = std::less<>>
+void parallel_stable_sort(ThreadPool& pool, RandomIt first, RandomIt last, Compare comp = Compare()) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    const size_t n = static_cast<size_t>(last - first);
+    if (n <= config::parallel_alg::sort_grain) {
+        std::stable_sort(first, last, comp);
+        return;
+    }
+
+    detail::run_in_pool(pool, [&]() {
+        // Move everything into the scratch buffer and sort back into place
+        detail::ScratchBuffer<T> scratch(n);
+        T* buffer = scratch.data();
+        const size_t blocks = detail::block_count(pool, n);
+        fork_join_for(pool, size_t(0), blocks, 1, [&](size_t b0, size_t b1) {
+            size_t i0 = detail::block_begin(b0, blocks, n);
+            size_t i1 = detail::block_begin(b1, blocks, n);
+            std::uninitialized_move(first + i0, first + i1, buffer + i0);
+        });
+        scratch.set_constructed(n);
+
+        detail::merge_sort(pool, buffer, first, n, true, comp);
+    });
+}
+
+// Stable partition, like std::stable_partition: elements satisfying pred
+// come first, in their original order, followed by the rest. Returns the
+// partition point. Blocked in three passes - evaluate pred and count per
+// block, prefix-sum the counts, scatter each block to its final slots -
+// through one scratch buffer. pred is called exactly once per element.
+template<typename RandomIt, typename Predicate>
+RandomIt parallel_partition(ThreadPool& pool, RandomIt first, RandomIt last, Predicate pred) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    const size_t n = static_cast<size_t>(last - first);
+    if (n <= config::parallel_alg::sort_grain) {
+        return std::stable_partition(first, last, pred);
+    }
+
+    const size_t blocks = detail::block_count(pool, n);
+    std::vector<unsigned char> keep(n);
+    std::vector<size_t> true_before(blocks + 1, 0);
+
+    detail::run_in_pool(pool, [&]() {
+        detail::ScratchBuffer<T> scratch(n);
+        T* buffer = scratch.data();
+
+        fork_join_for(pool, size_t(0), blocks, 1, [&](size_t b0, size_t b1) {
+            for (size_t b = b0; b < b1; ++b) {
+                size_t i0 = detail::block_begin(b, blocks, n);
+                size_t i1 = detail::block_begin(b + 1, blocks, n);
+                std::uninitialized_move(first + i0, first + i1, buffer + i0);
+                size_t count = 0;
+                for (size_t i = i0; i < i1; ++i) {
+                    keep[i] = pred(buffer[i]) ? 1 : 0;
+                    count += keep[i];
+                }
+                true_before[b + 1] = count;
+            }
+        });
+        scratch.set_constructed(n);
+
+        for (size_t b = 0; b < blocks; ++b) {
+            true_before[b + 1] += true_before[b];
+        }
+        const size_t total_true = true_before[blocks];
+
+        fork_join_for(pool, size_t(0), blocks, 1, [&](size_t b0, size_t b1) {
+            for (size_t b = b0; b < b1; ++b) {
+                size_t i0 = detail::block_begin(b, blocks, n);
+                size_t i1 = detail::block_begin(b + 1, blocks, n);
+                size_t t = true_before[b];
+                size_t f = total_true + (i0 - true_before[b]);
+                for (size_t i = i0; i < i1; ++i) {
+                    first[keep[i] ? t++ : f++] = std::move(buffer[i]);
+                }
+            }
+        });
+    });
+
+    return first + true_before[blocks];
+}
+
+// Remove consecutive duplicates, like std::unique: keeps the first element
+// of every run of equal elements and returns the new logical end. Elements
+// past it are left in a valid but unspecified state. Blocked like
+// parallel_partition; kept elements are compacted through a scratch buffer.
+template<typename RandomIt, typename BinaryPredicate = std::equal_to<>>
+RandomIt parallel_unique(ThreadPool& pool, RandomIt first, RandomIt last,
+                         BinaryPredicate equal = BinaryPredicate()) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    const size_t n = static_cast<size_t>(last - first);
+    if (n <= config::parallel_alg::sort_grain) {
+        return std::unique(first, last, equal);
+    }
+
+    const size_t blocks = detail::block_count(pool, n);
+    std::vector<unsigned char> keep(n);
+    std::vector<size_t> kept_before(blocks + 1, 0);
+
+    detail::run_in_pool(pool, [&]() {
+        // Flags only read the input, so every block can look at its left neighbour
+        fork_join_for(pool, size_t(0), blocks, 1, [&](size_t b0, size_t b1) {
+            for (size_t b = b0; b < b1; ++b) {
+                size_t i0 = detail::block_begin(b, blocks, n);
+                size_t i1 = detail::block_begin(b + 1, blocks, n);
+                size_t count = 0;
+                for (size_t i = i0; i < i1; ++i) {
+                    keep[i] = (i == 0 || !equal(first[i - 1], first[i])) ? 1 : 0;
+                    count += keep[i];
+                }
+                kept_before[b + 1] = count;
+            }
+        });
+
+        for (size_t b = 0; b < blocks; ++b) {
+            kept_before[b + 1] += kept_before[b];
+        }
+        const size_t kept = kept_before[blocks];
+
+        detail::ScratchBuffer<T> scratch(kept);
+        T* buffer = scratch.data();
+        fork_join_for(pool, size_t(0), blocks, 1, [&](size_t b0, size_t b1) {
+            for (size_t b = b0; b < b1; ++b) {
+                size_t i0 = detail::block_begin(b, blocks, n);
+                size_t i1 = detail::block_begin(b + 1, blocks, n);
+                size_t out = kept_before[b];
+                for (size_t i = i0; i < i1; ++i) {
+                    if (keep[i]) new (buffer + out++) T(std::move(first[i]));
+                }
+            }
+        });
+        scratch.set_constructed(kept);
+
+        fork_join_for(pool, size_t(0), kept, config::parallel_alg::sort_grain,
+            [&](size_t i0, size_t i1) {
+                std::move(buffer + i0, buffer + i1, first + i0);
+            });
+    });
+
+    return first + kept_before[blocks];
+}
+
+} // namespace runtime
+
+#endif // PARALLEL_SORT_H
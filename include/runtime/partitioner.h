@@ -0,0 +1,97 @@
+#ifndef PARTITIONER_H
+#define PARTITIONER_H
+
+#include <runtime/thread_pool.h>
+#include <runtime/config.h>
+#include <vector>
+#include <atomic>
+#include <memory>
+
+namespace runtime {
+
+// OpenMP-style loop schedule for parallel_for.
+//   Static     - one contiguous block per worker, submitted to that worker
+//   Dynamic(c) - workers claim chunks of c iterations from a shared cursor
+//   Guided(m)  - like Dynamic, but each claim takes remaining / (2 * workers)
+//                iterations (never fewer than m), so chunks shrink geometrically
+//   Auto       - lets the runtime choose (currently Guided)
+// Dynamic and Guided start one runner task per worker; claiming a chunk is a
+// single atomic operation and allocates nothing.
+struct Schedule {
+    enum class Kind {
+        Static,
+        Dynamic,
+        Guided,
+        Auto
+    };
+
+    Kind kind = Kind::Auto;
+    size_t chunk = 1;
+
+    static Schedule Static() { return {Kind::Static, 0}; }
+    static Schedule Dynamic(size_t chunk = config::parallel_alg::chunk_size) {
+        return {Kind::Dynamic, chunk == 0 ? 1 : chunk};
+    }
+    static Schedule Guided(size_t min_chunk = 1) {
+        return {Kind::Guided, min_chunk == 0 ? 1 : min_chunk};
+    }
+    static Schedule Auto() { return {Kind::Auto, 1}; }
+};
+
+// Remembers which worker ran each chunk of a parallel loop and, on the next
+// loop over the same chunk layout, submits each chunk straight to that
+// worker's queue so the data it touched is still in that worker's cache.
+// Chunks remain stealable; whoever actually runs a chunk is recorded for
+// the following call. Reuse one partitioner per loop site (e.g. across the
+// iterations of a solver) and do not share it between concurrent loops.
+class affinity_partitioner {
+    public:
+        affinity_partitioner() = default;
+
+        // Forget the recorded mapping
+        void reset() {
+            slots_.reset();
+            num_slots_ = 0;
+        }
+
+        // Number of chunks in the last call that ran on the worker they were sent to
+        size_t last_hits() const { return hits_.load(std::memory_order_relaxed); }
+        size_t chunk_count() const { return num_slots_; }
+
+        // Worker a chunk should be submitted to. The first call (or a call
+        // with a different chunk count or pool size) seeds contiguous blocks
+        // of chunks per worker.
+        size_t preferred_worker(size_t chunk) const {
+            return slots_[chunk].load(std::memory_order_relaxed);
+        }
+
+        void prepare(size_t num_chunks, size_t num_workers) {
+            hits_.store(0, std::memory_order_relaxed);
+            if (slots_ && num_chunks == num_slots_ && num_workers == num_workers_) return;
+
+            slots_ = std::make_unique<std::atomic<size_t>[]>(num_chunks);
+            num_slots_ = num_chunks;
+            num_workers_ = num_workers;
+            for (size_t i = 0; i < num_chunks; ++i) {
+                slots_[i].store(i * num_workers / num_chunks, std::memory_order_relaxed);
+            }
+        }
+
+        // Called by the task that ran `chunk` on `worker`
+        void record(size_t chunk, size_t worker) {
+            if (worker == ThreadPool::npos) return;
+            if (slots_[chunk].exchange(worker, std::memory_order_relaxed) == worker) {
+                hits_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        std::unique_ptr<std::atomic<size_t>[]> slots_;
+        size_t num_slots_ = 0;
+        size_t num_workers_ = 0;
+        std::atomic<size_t> hits_{0};
+};
+
+} // namespace runtime
+
+#endif // PARTITIONER_H
@@ -0,0 +1,61 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace runtime {
+
+// Hardware and software event counters through Linux perf_event_open, for
+// benchmarks and diagnostics (e.g. dTLB misses with and without huge
+// pages, see huge_pages.h).
+//
+// Counters follow the calling thread and every thread it starts after the
+// counters were opened, so open them before constructing the ThreadPool
+// to be measured. User-space events only. Events the kernel or the
+// hardware does not offer (perf_event_paranoid, VMs without a PMU,
+// non-Linux builds) are simply unavailable: value() reports 0 and
+// available() false.
+enum class PerfEvent {
+    Cycles,
+    Instructions,
+    CacheMisses,       // last-level cache
+    DtlbLoadMisses,
+    DtlbStoreMisses,
+    PageFaults,        // software event, available without a PMU
+    TaskClock          // software event: CPU time in ns
+};
+
+class PerfCounters {
+    public:
+        explicit PerfCounters(std::initializer_list<PerfEvent> events);
+        ~PerfCounters();
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        // Zero every counter and start counting
+        void start();
+        void stop();
+
+        bool available(PerfEvent event) const;
+        // Count since start(), scaled up if the kernel had to multiplex
+        // counters
+        uint64_t value(PerfEvent event) const;
+
+        static const char* name(PerfEvent event);
+
+    private:
+        struct Counter {
+            PerfEvent event;
+            int fd;   // -1: unavailable
+        };
+        const Counter* find(PerfEvent event) const;
+
+        std::vector<Counter> counters_;
+};
+
+} // namespace runtime
+
+#endif // PERF_COUNTERS_H
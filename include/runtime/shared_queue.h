@@ -0,0 +1,134 @@
+#ifndef SHARED_QUEUE_H
+#define SHARED_QUEUE_H
+
+#include <runtime/thread_pool.h>
+#include <runtime/config.h>
+#include <runtime/task.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+namespace runtime {
+
+// Task types that can cross a process boundary: a function id plus a
+// trivially copyable payload. Every process sharing a queue registers the
+// same ids for the same functions, before attaching. Id 0 is reserved.
+class SharedTaskRegistry {
+    public:
+        using Handler = std::function<void(const void* payload, size_t size)>;
+
+        void add(uint32_t function_id, Handler handler);
+
+        template<typename T, typename F>
+        void add(uint32_t function_id, F f);
+
+        const Handler* find(uint32_t function_id) const;
+
+    private:
+        std::unordered_map<uint32_t, Handler> handlers_;
+};
+
+// Bounded lock-free MPMC ring of task descriptors in POSIX shared memory
+// (shm_open + mmap), usable by any number of processes at once.
+//
+// Each slot carries one 64-bit state word: the ring lap it belongs to, its
+// state (empty / being written / full / being read) and the pid of the
+// process writing or reading it. Processes claim slots by CAS on that word,
+// so a process that dies mid-push or mid-pop leaves its pid behind: the
+// next process to reach the slot sees the pid is gone and releases it
+// instead of stalling the ring. A half-written task is discarded; a task
+// taken by a process that died is lost with it (at-most-once delivery).
+// recovered() counts such slots. Pids are checked with kill(pid, 0).
+//
+// The creator owns the name and unlinks it when destroyed. Creating over a
+// stale queue whose creator is dead replaces it.
+class SharedTaskQueue {
+    public:
+        enum class Mode { Create, Open };
+
+        SharedTaskQueue(const std::string& name, Mode mode,
+                        size_t capacity = config::shared_queue::capacity);
+        ~SharedTaskQueue();
+
+        SharedTaskQueue(const SharedTaskQueue&) = delete;
+        SharedTaskQueue& operator=(const SharedTaskQueue&) = delete;
+
+        // Copy a payload of up to config::shared_queue::payload_size bytes;
+        // returns false if the ring is full
+        bool try_push(uint32_t function_id, const void* payload, size_t size);
+
+        template<typename T>
+        bool try_push(uint32_t function_id, const T& payload);
+
+        // Serialise straight into the claimed slot: write(buffer, capacity)
+        // returns the number of bytes it used. If it throws, the slot is
+        // marked as skipped and the exception propagates.
+        bool try_push_with(uint32_t function_id,
+                           const std::function<size_t(void* buffer, size_t capacity)>& write);
+
+        // Read the oldest descriptor in place; returns false if none is ready
+        bool try_pop_with(const std::function<void(uint32_t function_id, const void* payload, size_t size)>& read);
+
+        // Pop a descriptor and bind it to its registered handler. A descriptor
+        // of an unregistered type is left in place for a process that
+        // registered it; until one pops it, this returns false.
+        bool try_pop(const SharedTaskRegistry& registry, Task& task);
+
+        size_t capacity() const { return capacity_; }
+        size_t size_approx() const;
+        uint64_t recovered() const;
+        const std::string& name() const { return name_; }
+
+    private:
+        struct Header;
+        struct Slot;
+
+        static size_t slots_offset();
+        Slot* slot(uint64_t position) const;
+        // try_pop_with, stopping short of descriptors registry cannot run
+        // (nullptr: take any)
+        bool pop_slot(const SharedTaskRegistry* registry,
+                      const std::function<void(uint32_t, const void*, size_t)>& read);
+
+        std::string name_;
+        bool owner_ = false;
+        void* mapping_ = nullptr;
+        size_t mapping_size_ = 0;
+        Header* header_ = nullptr;
+        size_t capacity_ = 0;
+};
+
+// Let pool's idle workers run registered tasks from queue (which may belong
+// to another process) once the pool's own queues are empty. queue and
+// registry must outlive the pool.
+void attach_shared_queue(ThreadPool& pool, SharedTaskQueue& queue, const SharedTaskRegistry& registry);
+
+template<typename T, typename F>
+void SharedTaskRegistry::add(uint32_t function_id, F f) {
+    static_assert(std::is_trivially_copyable<T>::value, "Shared task payloads must be trivially copyable");
+    static_assert(sizeof(T) <= config::shared_queue::payload_size, "Payload does not fit a shared queue slot");
+    add(function_id, [f](const void* payload, size_t size) {
+        T value;
+        if (size != sizeof(T)) {
+            throw std::invalid_argument("Shared task payload has the wrong size");
+        }
+        std::memcpy(&value, payload, sizeof(T));
+        f(value);
+    });
+}
+
+template<typename T>
+bool SharedTaskQueue::try_push(uint32_t function_id, const T& payload) {
+    static_assert(std::is_trivially_copyable<T>::value, "Shared task payloads must be trivially copyable");
+    static_assert(sizeof(T) <= config::shared_queue::payload_size, "Payload does not fit a shared queue slot");
+    return try_push(function_id, &payload, sizeof(T));
+}
+
+} // namespace runtime
+
+#endif // SHARED_QUEUE_H
@@ -12,6 +12,20 @@ struct RuntimeStats {
     std::atomic<uint64_t> tasks_stolen{0};
     std::atomic<uint64_t> steal_attempts{0};
     std::atomic<uint64_t> failed_steals{0};
+    std::atomic<uint64_t> timers_fired{0};
+    std::atomic<uint64_t> producer_waits{0};   // submits parked on a full pool
+    std::atomic<uint64_t> tasks_rejected{0};
+    std::atomic<uint64_t> fibers_started{0};
+    std::atomic<uint64_t> fiber_stacks_mapped{0};  // stacks not served from a worker's cache
+    std::atomic<uint64_t> spawns{0};               // SpawnScope::spawn calls
+    std::atomic<uint64_t> continuations_stolen{0}; // parents resumed from a queue, not by their returning child
+    std::atomic<uint64_t> arena_fallbacks{0};      // task_arena() allocations that went to the heap
+    std::atomic<uint64_t> huge_page_regions{0};    // internal regions on huge pages (MAP_HUGETLB or THP-advised)
+    std::atomic<uint64_t> huge_page_fallbacks{0};  // regions left on normal pages: huge pages unavailable
+    std::atomic<uint64_t> external_tasks{0};       // taken from steal sources
+    std::atomic<uint64_t> spin_hits{0};            // work found by an idle worker before parking
+    std::atomic<uint64_t> worker_parks{0};         // condition-variable waits by idle workers
+    std::atomic<uint64_t> worker_wakeups{0};       // parked workers woken by a submitter or searcher
 };
 
 } // namespace runtime
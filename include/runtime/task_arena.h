@@ -0,0 +1,114 @@
+#ifndef TASK_ARENA_H
+#define TASK_ARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace runtime {
+
+// Bump allocator for scratch memory that dies with the task using it.
+//
+// Every pool worker owns one (ThreadPoolOptions::task_arena_size bytes,
+// mapped on first use by the worker itself) and the pool resets it when
+// the outermost task running on that worker returns: allocating is a
+// pointer bump, freeing is free, and workers never contend on malloc.
+// Requests that do not fit go to the heap; those blocks are freed by
+// deallocate() or, at the latest, by the next reset.
+//
+// An arena belongs to one thread: do not hand its memory to other threads
+// or keep it past the end of the task. Tasks run inside a task (through
+// run_pending_task) share the outer task's arena, which is reset only once
+// the outer one returns. A fiber (fiber.h, continuation.h) may suspend and
+// let the worker reset its arena meanwhile, so code running on a fiber gets
+// an arena of the fiber's own instead: capacity 0, freed when the fiber
+// finishes.
+class TaskArena : public std::pmr::memory_resource {
+    public:
+        // capacity 0: every allocation goes to the heap. fallback_stat, if
+        // set, counts those heap allocations (see RuntimeStats). The buffer
+        // comes from upstream if given (e.g. huge pages), else from mmap.
+        explicit TaskArena(size_t capacity, std::atomic<uint64_t>* fallback_stat = nullptr,
+                           std::pmr::memory_resource* upstream = nullptr);
+        ~TaskArena() override;
+
+        TaskArena(const TaskArena&) = delete;
+        TaskArena& operator=(const TaskArena&) = delete;
+
+        // allocate / deallocate come from std::pmr::memory_resource.
+        // Deallocating gives back only the newest arena block (a short-lived
+        // temporary costs nothing); heap blocks are freed.
+
+        // Uninitialised storage for n objects of type T
+        template<typename T>
+        T* allocate_array(size_t n) {
+            return static_cast<T*>(allocate(n * sizeof(T), alignof(T)));
+        }
+
+        // Free everything allocated so far
+        void reset();
+
+        size_t capacity() const { return capacity_; }
+        // Arena bytes in use (heap fallbacks not included)
+        size_t used() const { return top_; }
+        size_t high_water() const { return high_water_; }
+        // Heap blocks not yet freed
+        size_t heap_blocks() const { return heap_blocks_; }
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+    private:
+        // Header in front of each heap fallback block, linked for reset()
+        struct HeapBlock {
+            HeapBlock* prev;
+            HeapBlock* next;
+            void* base;
+            size_t alignment;
+        };
+
+        void* allocate_heap(size_t bytes, size_t alignment);
+
+        size_t capacity_;
+        std::atomic<uint64_t>* fallback_stat_;
+        std::pmr::memory_resource* upstream_;
+        unsigned char* buffer_ = nullptr;  // mapped on first allocation
+        size_t top_ = 0;
+        size_t last_ = 0;                  // offset of the newest block
+        size_t last_top_ = 0;              // top_ before it was allocated
+        size_t high_water_ = 0;
+        HeapBlock* heap_ = nullptr;
+        size_t heap_blocks_ = 0;
+};
+
+// Arena of the calling pool worker. Outside a worker this is a per-thread
+// arena of capacity 0 that is never reset: everything goes to the heap and
+// stays there until deallocated or the thread exits.
+TaskArena& task_arena();
+
+// task_arena() as a std::pmr::memory_resource, e.g.
+// std::pmr::vector<int> scratch(runtime::task_resource());
+inline std::pmr::memory_resource* task_resource() {
+    return &task_arena();
+}
+
+namespace detail {
+
+// Make arena the calling thread's task_arena() and return the one bound
+// before; for the pool's workers and the fibers they run
+TaskArena* bind_task_arena(TaskArena* arena);
+// Bracket one task run by ThreadPool::execute_task: leave_task resets the
+// thread's arena when the outermost task returns
+size_t enter_task();
+void leave_task(size_t outer);
+
+} // namespace detail
+
+} // namespace runtime
+
+#endif // TASK_ARENA_H
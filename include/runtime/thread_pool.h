@@ -5,6 +5,9 @@
 #include <runtime/config.h>
 #include <runtime/stats.h>
 #include <runtime/work_stealing_queue.h>
+#include <runtime/timer_wheel.h>
+#include <runtime/task_arena.h>
+#include <runtime/huge_pages.h>
 #include <thread>
 #include <vector>
 #include <random>
@@ -12,11 +15,21 @@
 #include <chrono>
 #include <condition_variable>
 #include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <type_traits>
 
 
 namespace runtime { 
 
+// Thrown by submit() when the pool stayed full for the whole submit_timeout
+// and no rejection handler is configured
+class TaskRejectedError : public std::runtime_error {
+    public:
+        using std::runtime_error::runtime_error;
+};
+
 class ThreadPool {
     public:
         // Constructor with options
@@ -27,23 +40,127 @@ class ThreadPool {
         template<typename F, typename... Args>
         auto submit_task(F&& f, Args&&... args) 
             -> std::future<typename std::invoke_result<F, Args...>::type>;
+        // Backpressure: with options.max_pending_tasks set, a producer that
+        // finds that many tasks unfinished (queued + running) is parked until
+        // one finishes, for up to options.submit_timeout; then the task goes
+        // to options.rejection_handler, or TaskRejectedError is thrown.
+        // The pool's own workers are never held back (a task that submits
+        // more work must not wait on itself), and neither are submit_batch,
+        // submit_batch_to and timers.
         void submit(Task task);
+        // Enqueue only if there is room right now; otherwise drop the task
+        // and return false
+        bool try_submit(Task task);
+        // Wait up to `timeout` for room (config::backpressure::wait_forever
+        // to wait indefinitely); on timeout drop the task and return false
+        bool submit_for(Task task, std::chrono::milliseconds timeout);
+        // Submit to a specific worker's queue (still stealable by others)
+        void submit_to(size_t worker_index, Task task);
+        // Submit to the calling worker's own queue (see fork_join.h)
+        void submit_local(Task task);
+        // Pop the calling worker's newest queued task back out (see
+        // continuation.h); false if there is none. The task no longer counts
+        // as pending: run it or submit it again.
+        bool take_local(Task& task);
+        // Submit many tasks at once: they are spread over the worker queues
+        // in contiguous groups, one queue lock per group. Empties `tasks`.
+        void submit_batch(std::vector<Task>& tasks);
+        // submit_batch into one worker's queue (still stealable by others)
+        void submit_batch_to(size_t worker_index, std::vector<Task>& tasks);
+
+        // Fiber support (see fiber.h). submit_pinned runs the task on exactly
+        // this worker - it is never stolen. retain_work / release_work count
+        // work parked outside the queues (a suspended fiber) so that wait()
+        // and shutdown() cover it.
+        void submit_pinned(size_t worker_index, Task task);
+        void retain_work();
+        void release_work();
+
+        // Extra work sources idle workers poll once the pool's own queues
+        // are empty (e.g. another process's queue, see shared_queue.h).
+        // A source must not block; it returns true with a task to run.
+        using StealSource = std::function<bool(Task&)>;
+        void add_steal_source(StealSource source);
+
+        // Timers: run a task after a delay, at a point in time, or
+        // periodically (fixed rate). No worker waits meanwhile - pending
+        // timers live in a timing wheel (see timer_wheel.h) whose thread
+        // starts on first use and submits expired timers in batches.
+        // Pending timers are discarded at shutdown; wait() does not wait for them.
+        TimerHandle schedule_after(std::chrono::steady_clock::duration delay, Task task);
+        TimerHandle schedule_at(std::chrono::steady_clock::time_point when, Task task);
+        TimerHandle schedule_every(std::chrono::steady_clock::duration period, Task task);
+        // Returns true if the timer was still pending and will not run (again)
+        bool cancel_timer(TimerHandle handle);
+        size_t pending_timers() const;
+        // Run one pending task on the calling thread; returns false if none was found.
+        // Lets a task help with queued work while it waits instead of blocking.
+        bool run_pending_task();
         void wait(); 
         void shutdown();
+        size_t thread_count() const { return thread_count_; }
+        size_t max_pending_tasks() const { return max_pending_tasks_; }
+        size_t fiber_stack_size() const { return fiber_stack_size_; }
+        size_t task_arena_size() const { return task_arena_size_; }
+        config::HugePages huge_pages() const {
+            return huge_pages_ ? huge_pages_->mode() : config::HugePages::Off;
+        }
+        config::IdleStrategy idle_strategy() const { return idle_strategy_; }
+        // Duration auto_chunk loops size their chunks for
+        std::chrono::microseconds target_chunk_duration() const { return target_chunk_duration_; }
+        // Index of the calling worker thread, or npos if the caller is not one of this pool's workers
+        size_t current_worker() const;
         const RuntimeStats& stats() const { return stats_; }
+
+        static constexpr size_t npos = static_cast<size_t>(-1);
         RuntimeStats stats_;
     private:
 
         void execute_task(Task& task);
+        bool admit(std::chrono::milliseconds timeout);
+        bool try_admit();
+        void enqueue(Task task);
+        void reject(Task task);
+        TimerWheel& timers();
+        void run_task(Task& task);
+        bool find_task(size_t idx, Task& task);
         void worker(size_t idx);
+
+        // One worker's progress through the idle phases (spin, yield, park)
+        struct IdleState {
+            bool searching = false;  // counted in searching_
+            size_t failed_sweeps = 0;
+            size_t spin_limit;   // adapts between 1 and idle_spins_
+            size_t spin_end = 0; // spin_limit when this idle period began
+            std::chrono::microseconds park_timeout;
+        };
+        void found_work(IdleState& idle);
+        void stop_searching(IdleState& idle);
+        void wait_idle(size_t idx, IdleState& idle);
+        void park(size_t idx, std::chrono::microseconds timeout);
+        bool wake_one();
+        bool wake_worker(size_t idx);
+        void unpark(size_t idx);
+        void notify_work(size_t count);
+        bool has_visible_work(size_t idx) const;
         size_t get_random_thread();
         size_t get_next_victim(size_t i, size_t attempt);
 
         size_t thread_count_;
         int steal_attempts_;
         std::chrono::milliseconds idle_sleep_;
+        config::IdleStrategy idle_strategy_;
+        size_t idle_spins_;
+        size_t idle_yields_;
+        bool adaptive_spin_;
         size_t max_queue_tasks_;
         config::StealPolicy steal_policy_;
+        std::chrono::microseconds target_chunk_duration_;
+        size_t max_pending_tasks_;
+        std::chrono::milliseconds submit_timeout_;
+        config::RejectionHandler rejection_handler_;
+        size_t fiber_stack_size_;
+        size_t task_arena_size_;
 
         struct TaskGuard {
             std::atomic<size_t>& counter;
@@ -68,16 +185,48 @@ class ThreadPool {
         std::atomic<bool> stop_;
         
         std::vector<std::thread> threads_;
+        // Backs the worker queues and arenas below under options.huge_pages
+        // (null when Off); declared first so it outlives them. The global and
+        // pinned queues have no bound and stay on the heap: huge-page storage
+        // is kept at its peak, and their peak is whatever a burst left there.
+        std::unique_ptr<HugePageResource> huge_pages_;
         std::vector<std::unique_ptr<WorkStealingQueue>> work_queues_;
         WorkStealingQueue global_queue_;  // Add unbounded overflow queue
+        std::vector<std::unique_ptr<WorkStealingQueue>> pinned_queues_;  // only the owner pops
+        std::atomic<size_t> pinned_pending_{0};  // lets find_task skip them when all are empty
+        std::vector<std::unique_ptr<TaskArena>> arenas_;  // one per worker, reset after each task
+
+        // Copy-on-write list: workers read a snapshot without locking
+        std::shared_ptr<const std::vector<StealSource>> steal_sources_;
+        std::mutex steal_sources_mutex_;
 
         std::atomic<size_t> active_tasks_{0}; // track running tasks
         std::condition_variable cv_completion_; 
         std::mutex completion_mutex_;
 
-        std::condition_variable cv_work_;
-        std::mutex work_mutex_;
+        // Targeted wakeup: idle workers are either searching (spinning or
+        // about to park) or sleeping on their own Parker. Submitters wake a
+        // sleeper only when nobody is searching.
+        struct Parker {
+            std::mutex mutex;
+            std::condition_variable cv;
+            bool notified = false;
+        };
+        std::vector<std::unique_ptr<Parker>> parkers_;
+        std::atomic<size_t> searching_{0};
+        std::atomic<size_t> sleeping_{0};
+        std::vector<size_t> sleepers_;  // parked worker indices, most recent last
+        std::mutex idle_mutex_;
+
+        // Producers parked by max_pending_tasks; finishing tasks wake one each
+        std::atomic<size_t> blocked_producers_{0};
+        std::condition_variable cv_space_;
+        std::mutex space_mutex_;
 
+        // Created on first schedule_*; declared last so its thread stops
+        // before anything it dispatches into is destroyed
+        mutable std::mutex timers_mutex_;
+        std::unique_ptr<TimerWheel> timers_;
 };
 
 template<typename F, typename... Args>
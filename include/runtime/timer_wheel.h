@@ -0,0 +1,111 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <runtime/task.h>
+#include <runtime/config.h>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <cstdint>
+
+namespace runtime {
+
+// Identifies a scheduled timer for cancellation. Handles of timers that
+// have fired or been cancelled simply stop matching; a default-constructed
+// handle refers to no timer.
+struct TimerHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool valid() const { return index != UINT32_MAX; }
+};
+
+// Hierarchical timing wheel (config::timer::levels levels of 2^slot_bits
+// slots, one tick = config::timer::tick) driven by a single timer thread.
+// Every slot is an intrusive doubly linked list of timer nodes, so
+// scheduling and cancelling are O(1) whatever the number of pending timers;
+// timers on outer levels are cascaded inward as the wheel turns.
+// Timers that expire on the same tick are handed to `dispatch` as one batch.
+//
+// The timer thread sleeps until the next occupied tick (or the next
+// cascade) and not at all while the wheel is empty.
+class TimerWheel {
+    public:
+        using Clock = std::chrono::steady_clock;
+        // Receives expired tasks; may leave the vector in any state
+        using Dispatch = std::function<void(std::vector<Task>&)>;
+
+        explicit TimerWheel(Dispatch dispatch);
+        ~TimerWheel() noexcept;
+
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+
+        // Run task once at (or just after) `when`
+        TimerHandle schedule_at(Clock::time_point when, Task task);
+        // Run task every `period` (fixed rate), first one period from now.
+        // Runs may overlap if the task takes longer than the period.
+        TimerHandle schedule_every(Clock::duration period, Task task);
+        // Returns true if the timer was pending and will not run (again)
+        bool cancel(TimerHandle handle);
+
+        size_t pending() const;
+
+        // Stop the timer thread and drop every pending timer
+        void stop();
+
+    private:
+        static constexpr uint32_t nil = UINT32_MAX;
+        static constexpr uint64_t slots = uint64_t(1) << config::timer::slot_bits;
+        static constexpr uint64_t slot_mask = slots - 1;
+
+        struct Node {
+            Task task;
+            std::shared_ptr<Task> repeat;   // set for periodic timers
+            uint64_t expires = 0;           // deadline tick
+            uint64_t period = 0;            // ticks, 0 for one-shot timers
+            uint32_t prev = nil;
+            uint32_t next = nil;
+            uint32_t bucket = nil;          // level * slots + slot while linked
+            uint32_t generation = 1;
+        };
+
+        void run();
+        void advance(std::vector<Task>& batch);
+        void cascade(unsigned level, uint64_t slot);
+        void expire(uint32_t head, std::vector<Task>& batch);
+        uint64_t next_wake_tick() const;
+
+        uint32_t allocate_node();
+        void release_node(uint32_t index);
+        void link(uint32_t index);
+        void unlink(uint32_t index);
+        uint32_t detach(uint32_t bucket);
+        TimerHandle arm(uint32_t index);
+
+        uint64_t tick_at_or_after(Clock::time_point when) const;
+        uint64_t ticks_elapsed(Clock::time_point now) const;
+
+        Dispatch dispatch_;
+        const Clock::time_point start_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        std::vector<Node> nodes_;
+        std::vector<uint32_t> free_nodes_;
+        std::vector<uint32_t> heads_;       // one list head per bucket
+        uint64_t current_ = 0;              // next tick to process
+        uint64_t wake_tick_ = UINT64_MAX;   // tick the timer thread sleeps until
+        size_t count_ = 0;
+        bool stop_ = false;
+
+        std::thread thread_;
+};
+
+} // namespace runtime
+
+#endif // TIMER_WHEEL_H
@@ -4,6 +4,8 @@
 #include <runtime/task.h>
 #include <mutex>
 #include <deque>
+#include <memory>
+#include <memory_resource>
 
 namespace runtime {
 
@@ -13,7 +15,11 @@ class WorkStealingQueue {
         // All operations are protected by mutex_.
         // Owner thread calls push/try_pop.
         // Other threads call try_steal.
-        WorkStealingQueue() noexcept = default;
+        // With upstream set, the deque's blocks are pooled per queue and
+        // refilled from upstream (e.g. huge pages, see huge_pages.h); the
+        // queue then keeps its peak storage until it is destroyed.
+        // Otherwise they come from the heap
+        explicit WorkStealingQueue(std::pmr::memory_resource* upstream = nullptr);
 
         // Remove copy and move capabilities
         WorkStealingQueue(const WorkStealingQueue&) noexcept = delete;
@@ -23,12 +29,16 @@ class WorkStealingQueue {
 
         void push(Task task);           // Owner: push back
         bool try_push(Task&& task, size_t max_queue_size);       // Owner: try push back
+        void push_batch(Task* tasks, size_t count);              // Push all under one lock
+        size_t try_push_batch(Task* tasks, size_t count, size_t max_queue_size); // Push what fits; returns count pushed
         bool try_pop(Task& task);        // Owner: pop back
         bool try_steal(Task& task);      // Thief: pop front
         bool empty() const; 
         size_t size() const; 
     private:
-        std::deque<Task> deque_;
+        // Only touched under mutex_, so it needs no locking of its own
+        std::unique_ptr<std::pmr::unsynchronized_pool_resource> blocks_;
+        std::pmr::deque<Task> deque_;
         mutable std::mutex mutex_;
 };
 
@@ -0,0 +1,182 @@
+// Continuation-based mutex, semaphore, latch and barrier
+#include <runtime/async_sync.h>
+#include <runtime/fiber.h>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+namespace runtime {
+
+void AsyncMutex::lock(Task on_locked) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (locked_) {
+            waiters_.push_back(std::move(on_locked));
+            return;
+        }
+        locked_ = true;
+    }
+    on_locked();
+}
+
+bool AsyncMutex::try_lock() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (locked_) return false;
+    locked_ = true;
+    return true;
+}
+
+// Hand the mutex straight to the oldest waiter: it stays locked
+void AsyncMutex::unlock() {
+    Task next;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (waiters_.empty()) {
+            locked_ = false;
+            return;
+        }
+        next = std::move(waiters_.front());
+        waiters_.pop_front();
+    }
+    pool_.submit_local(std::move(next));
+}
+
+void AsyncSemaphore::acquire(Task on_acquired) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (permits_ == 0) {
+            waiters_.push_back(std::move(on_acquired));
+            return;
+        }
+        --permits_;
+    }
+    on_acquired();
+}
+
+bool AsyncSemaphore::try_acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (permits_ == 0) return false;
+    --permits_;
+    return true;
+}
+
+// Released permits go to waiters first, one each; the rest become available
+void AsyncSemaphore::release(size_t n) {
+    std::vector<Task> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (n > 0 && !waiters_.empty()) {
+            ready.push_back(std::move(waiters_.front()));
+            waiters_.pop_front();
+            --n;
+        }
+        permits_ += n;
+    }
+    for (auto& task : ready) {
+        pool_.submit_local(std::move(task));
+    }
+}
+
+size_t AsyncSemaphore::available() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return permits_;
+}
+
+void Latch::count_down(size_t n) {
+    std::vector<Task> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t count = count_.load(std::memory_order_relaxed);
+        if (n > count) {
+            throw std::logic_error("Latch counted down below zero");
+        }
+        count_.store(count - n, std::memory_order_release);
+        if (count != n) return;
+        ready.swap(waiters_);
+    }
+    for (auto& task : ready) {
+        pool_.submit_local(std::move(task));
+    }
+}
+
+void Latch::async_wait(Task continuation) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (count_.load(std::memory_order_relaxed) != 0) {
+            waiters_.push_back(std::move(continuation));
+            return;
+        }
+    }
+    continuation();
+}
+
+void Latch::wait() {
+    if (this_fiber::active()) {
+        this_fiber::wait(*this);
+        return;
+    }
+    while (!try_wait()) {
+        if (!pool_.run_pending_task()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+Barrier::Barrier(ThreadPool& pool, size_t expected, Task on_phase_completion)
+    : pool_(pool),
+      expected_(expected),
+      on_phase_completion_(std::move(on_phase_completion)) {
+    if (expected_ == 0) {
+        throw std::invalid_argument("Barrier needs at least one participant");
+    }
+    arrived_.reserve(expected_);
+}
+
+void Barrier::arrive(Task continuation) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    arrived_.push_back(std::move(continuation));
+    if (arrived_.size() == expected_) {
+        complete_phase(lock);
+    }
+}
+
+void Barrier::arrive_and_drop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (expected_ == 0) {
+        throw std::logic_error("Barrier has no participants left");
+    }
+    --expected_;
+    if (!arrived_.empty() && arrived_.size() == expected_) {
+        complete_phase(lock);
+    }
+}
+
+size_t Barrier::phase() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return phase_;
+}
+
+void Barrier::complete_phase(std::unique_lock<std::mutex>& lock) {
+    std::vector<Task> ready;
+    ready.swap(arrived_);
+    arrived_.reserve(expected_);
+    ++phase_;
+    lock.unlock();
+
+    // The phase is over even if the completion step throws: release its
+    // participants first, then let the exception out of arrive()
+    std::exception_ptr error;
+    if (on_phase_completion_) {
+        try {
+            on_phase_completion_();
+        } catch (...) {
+            error = std::current_exception();
+        }
+    }
+    for (auto& task : ready) {
+        pool_.submit_local(std::move(task));
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+} // namespace runtime
@@ -0,0 +1,585 @@
+// Work stealing between ThreadPools in different processes over TCP
+#include <runtime/distributed.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+
+namespace runtime {
+
+namespace {
+
+// Frame: u32 body length, then the body: u8 type and its fields, in host
+// byte order (nodes share an architecture)
+enum MessageType : uint8_t {
+    StealRequest = 1,  // u32 most tasks wanted
+    Tasks = 2,         // u32 count, then per task: u64 uid, u32 function id, u32 size, payload
+    NoTasks = 3,
+    Result = 4         // u64 uid, u8 ok, u32 size, result bytes (or error message)
+};
+
+constexpr size_t max_frame = 64u << 20;
+
+template<typename T>
+void put(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void put_bytes(std::string& out, const std::string& bytes) {
+    put<uint32_t>(out, static_cast<uint32_t>(bytes.size()));
+    out.append(bytes);
+}
+
+// Reads fields off a received frame; throws on a truncated one
+class Reader {
+    public:
+        explicit Reader(const std::string& frame) : data_(frame) {}
+
+        template<typename T>
+        T get() {
+            need(sizeof(T));
+            T value;
+            std::memcpy(&value, data_.data() + offset_, sizeof(T));
+            offset_ += sizeof(T);
+            return value;
+        }
+
+        std::string get_bytes() {
+            uint32_t size = get<uint32_t>();
+            need(size);
+            std::string bytes = data_.substr(offset_, size);
+            offset_ += size;
+            return bytes;
+        }
+
+    private:
+        void need(size_t n) const {
+            if (offset_ + n > data_.size()) {
+                throw std::runtime_error("Truncated distributed frame");
+            }
+        }
+
+        const std::string& data_;
+        size_t offset_ = 0;
+};
+
+std::string frame(const std::string& body) {
+    std::string out;
+    out.reserve(sizeof(uint32_t) + body.size());
+    put<uint32_t>(out, static_cast<uint32_t>(body.size()));
+    out.append(body);
+    return out;
+}
+
+int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void set_nonblocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+void set_nodelay(int fd) {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+} // namespace
+
+struct DistributedNode::Peer {
+    uint64_t id;
+    int fd;
+    std::string in;
+    std::mutex out_mutex;
+    std::string out;
+};
+
+void DistributedRegistry::add(uint32_t function_id, Handler handler) {
+    if (!handlers_.emplace(function_id, std::move(handler)).second) {
+        throw std::invalid_argument("Distributed task function id already registered");
+    }
+}
+
+const DistributedRegistry::Handler* DistributedRegistry::find(uint32_t function_id) const {
+    auto it = handlers_.find(function_id);
+    return it == handlers_.end() ? nullptr : &it->second;
+}
+
+DistributedNode::DistributedNode(const DistributedRegistry& registry, const config::NodeOptions& options)
+    : registry_(registry),
+      max_steal_batch_(options.max_steal_batch == 0 ? 1 : options.max_steal_batch),
+      steal_backoff_(options.steal_backoff),
+      pool_(options.pool) {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(options.port);
+    if (inet_pton(AF_INET, options.bind_address.c_str(), &address.sin_addr) != 1) {
+        throw std::invalid_argument("Bind address must be an IPv4 address: " + options.bind_address);
+    }
+
+    listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0) {
+        throw std::system_error(errno, std::generic_category(), "socket");
+    }
+    int one = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listen_fd_, 64) != 0) {
+        int error = errno;
+        close(listen_fd_);
+        throw std::system_error(error, std::generic_category(), "bind/listen " + options.bind_address);
+    }
+    socklen_t length = sizeof(address);
+    getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&address), &length);
+    port_ = ntohs(address.sin_port);
+    set_nonblocking(listen_fd_);
+
+    if (pipe2(wake_fds_, O_NONBLOCK | O_CLOEXEC) != 0) {
+        int error = errno;
+        close(listen_fd_);
+        throw std::system_error(error, std::generic_category(), "pipe2");
+    }
+
+    io_thread_ = std::thread([this]() { io_loop(); });
+    pool_.add_steal_source([this](Task& task) { return take_task(task); });
+}
+
+DistributedNode::~DistributedNode() {
+    // Let running tasks finish and queue their results, then flush and close
+    closing_.store(true, std::memory_order_release);
+    pool_.shutdown();
+    stop_.store(true, std::memory_order_release);
+    wake_io();
+    io_thread_.join();
+
+    for (auto& entry : peers_) {
+        close(entry.second->fd);
+    }
+    close(listen_fd_);
+    close(wake_fds_[0]);
+    close(wake_fds_[1]);
+}
+
+void DistributedNode::connect(const std::string& host, uint16_t port) {
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* results = nullptr;
+    int status = getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &results);
+    if (status != 0) {
+        throw std::runtime_error("Cannot resolve " + host + ": " + gai_strerror(status));
+    }
+    int fd = -1;
+    int error = 0;
+    for (addrinfo* ai = results; ai; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) {
+            error = errno;
+            continue;
+        }
+        if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) break;
+        error = errno;
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(results);
+    if (fd < 0) {
+        throw std::system_error(error, std::generic_category(), "connect " + host + ":" + std::to_string(port));
+    }
+    add_peer(fd);
+}
+
+size_t DistributedNode::peers() const {
+    std::lock_guard<std::mutex> lock(peers_mutex_);
+    return peers_.size();
+}
+
+std::future<std::string> DistributedNode::submit_bytes(uint32_t function_id, std::string payload) {
+    auto promise = std::make_shared<std::promise<std::string>>();
+    std::future<std::string> future = promise->get_future();
+    enqueue(function_id, std::move(payload), [promise](bool ok, const std::string& result) {
+        if (ok) {
+            promise->set_value(result);
+        } else {
+            promise->set_exception(std::make_exception_ptr(RemoteTaskError(result)));
+        }
+    });
+    return future;
+}
+
+void DistributedNode::wait() {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    cv_done_.wait(lock, [this]() { return completions_.empty() && completing_ == 0; });
+}
+
+void DistributedNode::enqueue(uint32_t function_id, std::string payload, Completion done) {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    uint64_t uid = next_uid_++;
+    completions_.emplace(uid, std::move(done));
+    queue_.push_back(Entry{uid, function_id, std::move(payload)});
+    stats_.tasks_submitted.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Steal source for our own workers: oldest local task, else ask a peer
+bool DistributedNode::take_task(Task& task) {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        if (!queue_.empty()) {
+            Entry entry = std::move(queue_.front());
+            queue_.pop_front();
+            task = [this, entry]() mutable { run_entry(entry, 0); };
+            return true;
+        }
+    }
+    request_steal();
+    return false;
+}
+
+void DistributedNode::request_steal() {
+    if (closing_.load(std::memory_order_acquire) ||
+        steal_in_flight_.load(std::memory_order_acquire) ||
+        now_ns() < next_steal_ns_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    uint64_t target = 0;
+    {
+        std::lock_guard<std::mutex> lock(peers_mutex_);
+        if (peers_.empty() || steal_in_flight_.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        auto it = peers_.begin();
+        std::advance(it, steal_cursor_ % peers_.size());
+        target = it->first;
+        steal_target_ = target;
+    }
+    std::string body;
+    put<uint8_t>(body, StealRequest);
+    put<uint32_t>(body, static_cast<uint32_t>(max_steal_batch_));
+    stats_.steal_requests.fetch_add(1, std::memory_order_relaxed);
+    send(target, frame(body));
+}
+
+void DistributedNode::run_entry(Entry& entry, uint64_t origin_peer) {
+    bool ok = true;
+    std::string result;
+    const DistributedRegistry::Handler* handler = registry_.find(entry.function_id);
+    if (!handler) {
+        ok = false;
+        result = "No distributed task registered for id " + std::to_string(entry.function_id);
+    } else {
+        try {
+            result = (*handler)(entry.payload);
+        } catch (const std::exception& e) {
+            ok = false;
+            result = e.what();
+        } catch (...) {
+            ok = false;
+            result = "Unknown exception in distributed task";
+        }
+    }
+    stats_.tasks_run.fetch_add(1, std::memory_order_relaxed);
+
+    if (origin_peer == 0) {
+        complete(entry.uid, ok, result);
+        return;
+    }
+    std::string body;
+    put<uint8_t>(body, Result);
+    put<uint64_t>(body, entry.uid);
+    put<uint8_t>(body, ok ? 1 : 0);
+    put_bytes(body, result);
+    send(origin_peer, frame(body));
+}
+
+void DistributedNode::complete(uint64_t uid, bool ok, const std::string& result) {
+    Completion done;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        auto it = completions_.find(uid);
+        if (it == completions_.end()) {
+            return;  // already completed by an earlier copy of the task
+        }
+        done = std::move(it->second);
+        completions_.erase(it);
+        ++completing_;
+    }
+    done(ok, result);
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        --completing_;
+    }
+    cv_done_.notify_all();
+}
+
+void DistributedNode::send(uint64_t peer_id, const std::string& data) {
+    std::shared_ptr<Peer> peer;
+    {
+        std::lock_guard<std::mutex> lock(peers_mutex_);
+        auto it = peers_.find(peer_id);
+        if (it == peers_.end()) {
+            return;  // gone; whatever it was owed is requeued or lost with it
+        }
+        peer = it->second;
+    }
+    {
+        std::lock_guard<std::mutex> lock(peer->out_mutex);
+        peer->out.append(data);
+    }
+    wake_io();
+}
+
+void DistributedNode::add_peer(int fd) {
+    set_nonblocking(fd);
+    set_nodelay(fd);
+    auto peer = std::make_shared<Peer>();
+    peer->fd = fd;
+    {
+        std::lock_guard<std::mutex> lock(peers_mutex_);
+        peer->id = next_peer_id_++;
+        peers_.emplace(peer->id, peer);
+    }
+    // A new peer may have work: stop backing off
+    next_steal_ns_.store(0, std::memory_order_relaxed);
+    wake_io();
+}
+
+void DistributedNode::wake_io() {
+    char byte = 1;
+    (void)!write(wake_fds_[1], &byte, 1);  // full pipe: a wakeup is already pending
+}
+
+void DistributedNode::io_loop() {
+    std::vector<pollfd> fds;
+    std::vector<std::shared_ptr<Peer>> polled;
+    int64_t flush_deadline = 0;
+
+    while (true) {
+        bool stopping = stop_.load(std::memory_order_acquire);
+        fds.clear();
+        polled.clear();
+        fds.push_back(pollfd{wake_fds_[0], POLLIN, 0});
+        fds.push_back(pollfd{listen_fd_, static_cast<short>(stopping ? 0 : POLLIN), 0});
+        bool unsent = false;
+        {
+            std::lock_guard<std::mutex> lock(peers_mutex_);
+            for (auto& entry : peers_) {
+                const auto& peer = entry.second;
+                short events = POLLIN;
+                {
+                    std::lock_guard<std::mutex> out_lock(peer->out_mutex);
+                    if (!peer->out.empty()) {
+                        events |= POLLOUT;
+                        unsent = true;
+                    }
+                }
+                fds.push_back(pollfd{peer->fd, events, 0});
+                polled.push_back(peer);
+            }
+        }
+        if (stopping) {
+            // Give queued results a moment to reach their nodes, then leave
+            if (flush_deadline == 0) flush_deadline = now_ns() + 100000000;
+            if (!unsent || now_ns() > flush_deadline) break;
+        }
+
+        if (poll(fds.data(), fds.size(), 100) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            char buffer[256];
+            while (read(wake_fds_[0], buffer, sizeof(buffer)) > 0) {
+            }
+        }
+        if (fds[1].revents & POLLIN) {
+            int fd;
+            while ((fd = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC)) >= 0) {
+                add_peer(fd);
+            }
+        }
+
+        for (size_t i = 0; i < polled.size(); ++i) {
+            const auto& peer = polled[i];
+            short revents = fds[i + 2].revents;
+            bool closed = (revents & (POLLERR | POLLNVAL)) != 0;
+
+            if (!closed && (revents & (POLLIN | POLLHUP))) {
+                char buffer[64 * 1024];
+                while (true) {
+                    ssize_t n = recv(peer->fd, buffer, sizeof(buffer), 0);
+                    if (n > 0) {
+                        peer->in.append(buffer, static_cast<size_t>(n));
+                        continue;
+                    }
+                    if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                        closed = true;
+                    }
+                    if (n < 0 && errno == EINTR) continue;
+                    break;
+                }
+                // Dispatch whole frames
+                size_t offset = 0;
+                try {
+                    while (peer->in.size() - offset >= sizeof(uint32_t)) {
+                        uint32_t length;
+                        std::memcpy(&length, peer->in.data() + offset, sizeof(length));
+                        if (length == 0 || length > max_frame) {
+                            throw std::runtime_error("Bad distributed frame length");
+                        }
+                        if (peer->in.size() - offset - sizeof(uint32_t) < length) break;
+                        on_frame(peer, peer->in.substr(offset + sizeof(uint32_t), length));
+                        offset += sizeof(uint32_t) + length;
+                    }
+                } catch (const std::exception&) {
+                    closed = true;  // protocol error or refused tasks: drop the peer
+                }
+                peer->in.erase(0, offset);
+            }
+
+            if (!closed && (revents & POLLOUT)) {
+                std::lock_guard<std::mutex> lock(peer->out_mutex);
+                ssize_t n = ::send(peer->fd, peer->out.data(), peer->out.size(), MSG_NOSIGNAL);
+                if (n > 0) {
+                    peer->out.erase(0, static_cast<size_t>(n));
+                } else if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    closed = true;
+                }
+            }
+
+            if (closed) {
+                on_disconnect(peer);
+            }
+        }
+    }
+}
+
+void DistributedNode::on_frame(const std::shared_ptr<Peer>& peer, const std::string& data) {
+    Reader reader(data);
+    switch (reader.get<uint8_t>()) {
+        case StealRequest: {
+            size_t wanted = reader.get<uint32_t>();
+            std::string body;
+            size_t count = 0;
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex_);
+                // Half of what we have, newest first: our workers take the oldest
+                count = std::min({wanted, max_steal_batch_, (queue_.size() + 1) / 2});
+                if (count > 0) {
+                    put<uint8_t>(body, Tasks);
+                    put<uint32_t>(body, static_cast<uint32_t>(count));
+                    auto& given = given_[peer->id];
+                    for (size_t i = 0; i < count; ++i) {
+                        Entry entry = std::move(queue_.back());
+                        queue_.pop_back();
+                        put<uint64_t>(body, entry.uid);
+                        put<uint32_t>(body, entry.function_id);
+                        put_bytes(body, entry.payload);
+                        given.emplace(entry.uid, std::move(entry));
+                    }
+                }
+            }
+            if (count == 0) {
+                put<uint8_t>(body, NoTasks);
+            }
+            stats_.tasks_given.fetch_add(count, std::memory_order_relaxed);
+            send(peer->id, frame(body));
+            break;
+        }
+
+        case Tasks: {
+            uint32_t count = reader.get<uint32_t>();
+            std::vector<Entry> entries;
+            entries.reserve(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                uint64_t uid = reader.get<uint64_t>();
+                uint32_t function_id = reader.get<uint32_t>();
+                entries.push_back(Entry{uid, function_id, reader.get_bytes()});
+            }
+            {
+                std::lock_guard<std::mutex> lock(peers_mutex_);
+                empty_answers_ = 0;  // keep asking this peer while it has work
+            }
+            steal_in_flight_.store(false, std::memory_order_release);
+            stats_.tasks_taken.fetch_add(count, std::memory_order_relaxed);
+            uint64_t origin = peer->id;
+            std::vector<Task> batch;
+            batch.reserve(entries.size());
+            for (auto& entry : entries) {
+                batch.push_back([this, entry = std::move(entry), origin]() mutable {
+                    run_entry(entry, origin);
+                });
+            }
+            // Not held back by backpressure: this thread must not park, and
+            // every stolen entry has to run or go back. Refused only while
+            // shutting down; the throw drops the peer, which requeues them.
+            pool_.submit_batch(batch);
+            break;
+        }
+
+        case NoTasks: {
+            stats_.empty_steals.fetch_add(1, std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lock(peers_mutex_);
+                ++steal_cursor_;
+                if (++empty_answers_ >= peers_.size()) {
+                    empty_answers_ = 0;
+                    next_steal_ns_.store(now_ns() + std::chrono::nanoseconds(steal_backoff_).count(),
+                                         std::memory_order_relaxed);
+                }
+            }
+            steal_in_flight_.store(false, std::memory_order_release);
+            break;
+        }
+
+        case Result: {
+            uint64_t uid = reader.get<uint64_t>();
+            bool ok = reader.get<uint8_t>() != 0;
+            std::string result = reader.get_bytes();
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex_);
+                auto it = given_.find(peer->id);
+                if (it != given_.end()) it->second.erase(uid);
+            }
+            complete(uid, ok, result);
+            break;
+        }
+
+        default:
+            throw std::runtime_error("Unknown distributed message type");
+    }
+}
+
+void DistributedNode::on_disconnect(const std::shared_ptr<Peer>& peer) {
+    bool was_target = false;
+    {
+        std::lock_guard<std::mutex> lock(peers_mutex_);
+        if (peers_.erase(peer->id) == 0) return;
+        was_target = steal_target_ == peer->id;
+        empty_answers_ = 0;
+    }
+    close(peer->fd);
+    if (was_target) {
+        steal_in_flight_.store(false, std::memory_order_release);
+    }
+
+    // Whatever it stole and never answered for runs again here
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    auto it = given_.find(peer->id);
+    if (it == given_.end()) return;
+    for (auto& entry : it->second) {
+        queue_.push_front(std::move(entry.second));
+    }
+    stats_.tasks_requeued.fetch_add(it->second.size(), std::memory_order_relaxed);
+    given_.erase(it);
+}
+
+} // namespace runtime
@@ -0,0 +1,120 @@
+// Concurrency-limited and serial executors
+#include <runtime/executor.h>
+#include <stdexcept>
+#include <thread>
+
+namespace runtime {
+
+namespace detail {
+
+MpscTaskQueue::MpscTaskQueue()
+    : head_(new Node()) {
+    tail_ = head_.load(std::memory_order_relaxed);
+}
+
+MpscTaskQueue::~MpscTaskQueue() {
+    Node* node = tail_;
+    while (node) {
+        Node* next = node->next.load(std::memory_order_relaxed);
+        delete node;
+        node = next;
+    }
+}
+
+void MpscTaskQueue::push(Task task) {
+    Node* node = new Node();
+    node->task = std::move(task);
+    Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+    // Until this store the consumer cannot see node (or anything after it)
+    prev->next.store(node, std::memory_order_release);
+}
+
+bool MpscTaskQueue::try_pop(Task& task) {
+    Node* next = tail_->next.load(std::memory_order_acquire);
+    if (!next) return false;
+
+    task = std::move(next->task);
+    delete tail_;
+    tail_ = next;  // next becomes the new stub
+    return true;
+}
+
+} // namespace detail
+
+LimitedExecutor::LimitedExecutor(ThreadPool& pool, size_t max_concurrency)
+    : pool_(pool),
+      max_concurrency_(max_concurrency) {
+    if (max_concurrency_ == 0) {
+        throw std::invalid_argument("Max concurrency must be > 0");
+    }
+}
+
+LimitedExecutor::~LimitedExecutor() {
+    wait();
+}
+
+void LimitedExecutor::submit(Task task) {
+    queue_.push(std::move(task));
+    // Below the limit: this task needs a runner of its own
+    if (count_.fetch_add(1, std::memory_order_acq_rel) < max_concurrency_) {
+        // A runner must not reach the pool's rejection handler (dropping it
+        // would strand queued tasks): on a full pool, wait for room instead
+        try {
+            pool_.submit_for([this]() { run_batch(); }, config::backpressure::wait_forever);
+        } catch (const std::runtime_error&) {
+            run_batch();  // pool is shutting down
+        }
+    }
+}
+
+void LimitedExecutor::wait() {
+    while (count_.load(std::memory_order_acquire) != 0) {
+        if (!pool_.run_pending_task()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+// The count guarantees a task is queued for every runner, but its push may
+// not be visible yet, and other runners may be at the consumer end
+Task LimitedExecutor::next_task() {
+    Task task;
+    while (true) {
+        if (!popping_.exchange(true, std::memory_order_acquire)) {
+            bool popped = queue_.try_pop(task);
+            popping_.store(false, std::memory_order_release);
+            if (popped) return task;
+        }
+        std::this_thread::yield();
+    }
+}
+
+void LimitedExecutor::run_batch() {
+    for (size_t done = 1; ; ++done) {
+        Task task = next_task();
+        try {
+            task();
+        } catch (...) {
+            // Swallowed, as ThreadPool does
+        }
+        task = nullptr;
+
+        // At or below the limit after this task: one runner too many, retire.
+        // Nothing may touch *this after the decrement that may reach zero.
+        if (count_.fetch_sub(1, std::memory_order_acq_rel) <= max_concurrency_) {
+            return;
+        }
+        if (done >= config::executor::runner_batch) {
+            // As in submit(): on a full pool wait for room, never reject.
+            // Only a non-worker helping out in wait() can be held back here.
+            try {
+                pool_.submit_for([this]() { run_batch(); }, config::backpressure::wait_forever);
+                return;
+            } catch (const std::runtime_error&) {
+                // Pool is shutting down: keep draining here
+            }
+        }
+    }
+}
+
+} // namespace runtime
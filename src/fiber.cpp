@@ -0,0 +1,853 @@
+// Fibers: guard-paged stacks, context switches and suspend / resume;
+// continuation-stealing spawn fibers on the same machinery
+#include <runtime/fiber.h>
+#include <runtime/continuation.h>
+#include <runtime/task_arena.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+// Hand-written switches need the plain SysV / AAPCS64 ABIs; with CET shadow
+// stacks enabled only ucontext (which glibc keeps CET-aware) is safe
+#if !defined(RUNTIME_FIBER_UCONTEXT) && !defined(__CET__) && defined(__linux__) && \
+    (defined(__x86_64__) || defined(__aarch64__))
+#define RUNTIME_FIBER_ASM 1
+#else
+#define RUNTIME_FIBER_ASM 0
+#include <ucontext.h>
+#endif
+
+#if defined(__SANITIZE_ADDRESS__)
+#define RUNTIME_FIBER_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define RUNTIME_FIBER_ASAN 1
+#endif
+#endif
+#ifndef RUNTIME_FIBER_ASAN
+#define RUNTIME_FIBER_ASAN 0
+#endif
+#if RUNTIME_FIBER_ASAN
+#include <sanitizer/common_interface_defs.h>
+#endif
+
+#if RUNTIME_FIBER_ASM
+// runtime_fiber_switch(save, load): push the callee-saved registers, store
+// the stack pointer to *save, then pop the registers saved on stack `load`
+// and return into it. A fresh stack is laid out so that this "returns"
+// into runtime_fiber_trampoline, with the entry function and its argument
+// in callee-saved registers.
+extern "C" void runtime_fiber_switch(void** save, void* load);
+extern "C" void runtime_fiber_trampoline();
+
+#if defined(__x86_64__)
+asm(
+    ".text\n"
+    ".globl runtime_fiber_switch\n"
+    ".hidden runtime_fiber_switch\n"
+    ".type runtime_fiber_switch, @function\n"
+    ".p2align 4\n"
+    "runtime_fiber_switch:\n"
+    "    pushq %rbp\n"
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    pushq %r14\n"
+    "    pushq %r15\n"
+    "    subq $16, %rsp\n"
+    "    stmxcsr 8(%rsp)\n"
+    "    fnstcw 12(%rsp)\n"
+    "    movq %rsp, (%rdi)\n"
+    "    movq %rsi, %rsp\n"
+    "    ldmxcsr 8(%rsp)\n"
+    "    fldcw 12(%rsp)\n"
+    "    addq $16, %rsp\n"
+    "    popq %r15\n"
+    "    popq %r14\n"
+    "    popq %r13\n"
+    "    popq %r12\n"
+    "    popq %rbx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+    ".size runtime_fiber_switch, .-runtime_fiber_switch\n"
+    ".globl runtime_fiber_trampoline\n"
+    ".hidden runtime_fiber_trampoline\n"
+    ".type runtime_fiber_trampoline, @function\n"
+    "runtime_fiber_trampoline:\n"
+    "    movq %r12, %rdi\n"
+    "    callq *%r13\n"
+    "    ud2\n"
+    ".size runtime_fiber_trampoline, .-runtime_fiber_trampoline\n"
+);
+#elif defined(__aarch64__)
+asm(
+    ".text\n"
+    ".globl runtime_fiber_switch\n"
+    ".hidden runtime_fiber_switch\n"
+    ".type runtime_fiber_switch, %function\n"
+    ".p2align 4\n"
+    "runtime_fiber_switch:\n"
+    "    sub sp, sp, #160\n"
+    "    stp x19, x20, [sp, #0]\n"
+    "    stp x21, x22, [sp, #16]\n"
+    "    stp x23, x24, [sp, #32]\n"
+    "    stp x25, x26, [sp, #48]\n"
+    "    stp x27, x28, [sp, #64]\n"
+    "    stp x29, x30, [sp, #80]\n"
+    "    stp d8, d9, [sp, #96]\n"
+    "    stp d10, d11, [sp, #112]\n"
+    "    stp d12, d13, [sp, #128]\n"
+    "    stp d14, d15, [sp, #144]\n"
+    "    mov x9, sp\n"
+    "    str x9, [x0]\n"
+    "    mov sp, x1\n"
+    "    ldp x19, x20, [sp, #0]\n"
+    "    ldp x21, x22, [sp, #16]\n"
+    "    ldp x23, x24, [sp, #32]\n"
+    "    ldp x25, x26, [sp, #48]\n"
+    "    ldp x27, x28, [sp, #64]\n"
+    "    ldp x29, x30, [sp, #80]\n"
+    "    ldp d8, d9, [sp, #96]\n"
+    "    ldp d10, d11, [sp, #112]\n"
+    "    ldp d12, d13, [sp, #128]\n"
+    "    ldp d14, d15, [sp, #144]\n"
+    "    add sp, sp, #160\n"
+    "    ret\n"
+    ".size runtime_fiber_switch, .-runtime_fiber_switch\n"
+    ".globl runtime_fiber_trampoline\n"
+    ".hidden runtime_fiber_trampoline\n"
+    ".type runtime_fiber_trampoline, %function\n"
+    "runtime_fiber_trampoline:\n"
+    "    mov x0, x19\n"
+    "    blr x20\n"
+    "    brk #0\n"
+    ".size runtime_fiber_trampoline, .-runtime_fiber_trampoline\n"
+);
+#endif
+#endif // RUNTIME_FIBER_ASM
+
+namespace runtime {
+
+namespace {
+
+size_t page_size() {
+    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+size_t round_to_pages(size_t bytes) {
+    size_t page = page_size();
+    return (bytes + page - 1) / page * page;
+}
+
+// mmap'ed stack with a PROT_NONE guard page below the usable part
+class FiberStack {
+    public:
+        FiberStack() = default;
+        explicit FiberStack(size_t size)
+            : usable_(round_to_pages(size)),
+              mapped_(usable_ + page_size()) {
+            base_ = mmap(nullptr, mapped_, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+            if (base_ == MAP_FAILED) {
+                base_ = nullptr;
+                throw std::bad_alloc();
+            }
+            if (mprotect(base_, page_size(), PROT_NONE) != 0) {
+                int error = errno;
+                munmap(base_, mapped_);
+                base_ = nullptr;
+                throw std::system_error(error, std::generic_category(), "Fiber guard page");
+            }
+        }
+        ~FiberStack() {
+            if (base_) munmap(base_, mapped_);
+        }
+
+        FiberStack(FiberStack&& other) noexcept
+            : base_(std::exchange(other.base_, nullptr)),
+              usable_(other.usable_),
+              mapped_(other.mapped_) {}
+        FiberStack& operator=(FiberStack&& other) noexcept {
+            if (this != &other) {
+                if (base_) munmap(base_, mapped_);
+                base_ = std::exchange(other.base_, nullptr);
+                usable_ = other.usable_;
+                mapped_ = other.mapped_;
+            }
+            return *this;
+        }
+
+        void* bottom() const { return static_cast<char*>(base_) + page_size(); }
+        void* top() const { return static_cast<char*>(base_) + mapped_; }
+        size_t size() const { return usable_; }
+
+    private:
+        void* base_ = nullptr;
+        size_t usable_ = 0;
+        size_t mapped_ = 0;
+};
+
+// AddressSanitizer keeps one stack per thread: every switch is announced
+// with the stack it goes to and confirmed on arrival, which also reports
+// the bounds of the stack just left. No-ops without ASan.
+struct SanitizerStack {
+    const void* bottom = nullptr;
+    size_t size = 0;
+    void* fake_stack = nullptr;  // ASan's per-stack fake frames
+};
+
+// Before switching away from `from` (nullptr: it is never resumed) to `to`
+void sanitizer_start_switch(SanitizerStack* from, const SanitizerStack& to) {
+#if RUNTIME_FIBER_ASAN
+    __sanitizer_start_switch_fiber(from ? &from->fake_stack : nullptr, to.bottom, to.size);
+#else
+    (void)from;
+    (void)to;
+#endif
+}
+
+// First thing after arriving on `to`; records the stack left in `from`
+void sanitizer_finish_switch(SanitizerStack& to, SanitizerStack* from) {
+#if RUNTIME_FIBER_ASAN
+    __sanitizer_finish_switch_fiber(to.fake_stack, from ? &from->bottom : nullptr,
+                                    from ? &from->size : nullptr);
+#else
+    (void)to;
+    (void)from;
+#endif
+}
+
+SanitizerStack sanitizer_stack(const FiberStack& stack) {
+    SanitizerStack bounds;
+    bounds.bottom = stack.bottom();
+    bounds.size = stack.size();
+    return bounds;
+}
+
+struct Fiber {
+    ThreadPool* pool = nullptr;
+    size_t worker = ThreadPool::npos;
+    Task task;
+    FiberStack stack;
+    bool finished = false;
+    // Set by a suspending fiber; called by run_fiber once off the fiber's stack
+    const std::function<void(Task)>* on_suspend = nullptr;
+    std::exception_ptr suspend_error;
+    TaskArena arena{0};  // task_arena() while the fiber runs
+    SanitizerStack sanitizer;
+    SanitizerStack caller_sanitizer;  // whichever stack last switched in
+#if RUNTIME_FIBER_ASM
+    void* sp = nullptr;
+    void* caller_sp = nullptr;
+#else
+    ucontext_t context;
+    ucontext_t caller_context;
+#endif
+};
+
+// Fiber running on this thread (innermost, if a fiber helped run another)
+thread_local Fiber* tls_fiber = nullptr;
+
+// Recycled stacks of this worker. Fibers never leave the worker that
+// started them, so a stack always returns to the cache it came from.
+thread_local std::vector<FiberStack> tls_stack_cache;
+
+FiberStack take_stack(ThreadPool& pool) {
+    size_t size = round_to_pages(pool.fiber_stack_size());
+    while (!tls_stack_cache.empty()) {
+        FiberStack stack = std::move(tls_stack_cache.back());
+        tls_stack_cache.pop_back();
+        if (stack.size() == size) {
+            return stack;
+        }
+        // Sized for another pool: dropped
+    }
+    pool.stats_.fiber_stacks_mapped.fetch_add(1, std::memory_order_relaxed);
+    return FiberStack(size);
+}
+
+void recycle_stack(FiberStack&& stack) {
+    if (tls_stack_cache.size() < config::fiber::stack_cache) {
+        tls_stack_cache.push_back(std::move(stack));
+    }
+}
+
+void switch_into(Fiber* f) {
+    sanitizer_start_switch(&f->caller_sanitizer, f->sanitizer);
+#if RUNTIME_FIBER_ASM
+    runtime_fiber_switch(&f->caller_sp, f->sp);
+#else
+    swapcontext(&f->caller_context, &f->context);
+#endif
+    sanitizer_finish_switch(f->caller_sanitizer, nullptr);
+}
+
+void switch_to_caller(Fiber* f) {
+    sanitizer_start_switch(f->finished ? nullptr : &f->sanitizer, f->caller_sanitizer);
+#if RUNTIME_FIBER_ASM
+    runtime_fiber_switch(&f->sp, f->caller_sp);
+#else
+    swapcontext(&f->context, &f->caller_context);
+#endif
+    // Resumed, perhaps from another worker's stack
+    sanitizer_finish_switch(f->sanitizer, &f->caller_sanitizer);
+}
+
+[[noreturn]] void fiber_main(void* arg) {
+    Fiber* f = static_cast<Fiber*>(arg);
+    sanitizer_finish_switch(f->sanitizer, &f->caller_sanitizer);
+    try {
+        f->task();
+    } catch (...) {
+        // Swallowed, as ThreadPool does
+    }
+    f->task = nullptr;
+    f->finished = true;
+    switch_to_caller(f);
+    std::terminate();  // a finished fiber is never switched into again
+}
+
+#if RUNTIME_FIBER_ASM
+// Lay out a fresh stack so that switching to the returned stack pointer
+// calls entry(arg)
+void* prepare_stack(const FiberStack& stack, void (*entry)(void*), void* arg) {
+    auto* top = static_cast<uint64_t*>(stack.top());
+#if defined(__x86_64__)
+    // Frame popped by runtime_fiber_switch: pad, mxcsr + x87 control word,
+    // r15, r14, r13 (entry), r12 (argument), rbx, rbp, return address.
+    // Leaves rsp 16-byte aligned in the trampoline, as a call expects.
+    uint64_t* sp = top - 11;
+    uint32_t mxcsr;
+    uint16_t fpu_control;
+    asm volatile("stmxcsr %0" : "=m"(mxcsr));
+    asm volatile("fnstcw %0" : "=m"(fpu_control));
+    sp[0] = 0;
+    sp[1] = mxcsr | (static_cast<uint64_t>(fpu_control) << 32);
+    sp[2] = 0;
+    sp[3] = 0;
+    sp[4] = reinterpret_cast<uint64_t>(entry);
+    sp[5] = reinterpret_cast<uint64_t>(arg);
+    sp[6] = 0;
+    sp[7] = 0;
+    sp[8] = reinterpret_cast<uint64_t>(&runtime_fiber_trampoline);
+#elif defined(__aarch64__)
+    // Frame popped by runtime_fiber_switch: x19 (argument), x20 (entry),
+    // x21-x28, x29 (frame pointer), x30 (return address), d8-d15
+    uint64_t* sp = top - 20;
+    for (int i = 0; i < 20; ++i) sp[i] = 0;
+    sp[0] = reinterpret_cast<uint64_t>(arg);
+    sp[1] = reinterpret_cast<uint64_t>(entry);
+    sp[11] = reinterpret_cast<uint64_t>(&runtime_fiber_trampoline);
+#endif
+    return sp;
+}
+
+void init_context(Fiber* f) {
+    f->sp = prepare_stack(f->stack, &fiber_main, f);
+    f->sanitizer = sanitizer_stack(f->stack);
+}
+#else
+void ucontext_entry() {
+    fiber_main(tls_fiber);  // set by run_fiber just before the first switch
+}
+
+void init_context(Fiber* f) {
+    if (getcontext(&f->context) != 0) {
+        throw std::system_error(errno, std::generic_category(), "getcontext");
+    }
+    f->context.uc_stack.ss_sp = f->stack.bottom();
+    f->context.uc_stack.ss_size = f->stack.size();
+    f->context.uc_link = nullptr;
+    makecontext(&f->context, &ucontext_entry, 0);
+    f->sanitizer = sanitizer_stack(f->stack);
+}
+#endif
+
+void run_fiber(Fiber* f);
+
+// Callable handed out by a suspending fiber; the first call queues the
+// fiber on its own worker
+Task resume_handle(Fiber* f, std::shared_ptr<std::atomic<bool>> fired) {
+    return [f, fired]() {
+        if (fired->exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        f->pool->submit_pinned(f->worker, [f]() {
+            f->pool->release_work();
+            run_fiber(f);
+        });
+    };
+}
+
+// Switch into f and handle what it switched back for: finishing, or
+// suspending (its resume is registered here, off the fiber's stack)
+void run_fiber(Fiber* f) {
+    Fiber* outer = tls_fiber;
+    while (true) {
+        tls_fiber = f;
+        TaskArena* outer_arena = detail::bind_task_arena(&f->arena);
+        switch_into(f);
+        detail::bind_task_arena(outer_arena);
+        tls_fiber = outer;
+
+        if (f->finished) {
+            recycle_stack(std::move(f->stack));
+            delete f;
+            return;
+        }
+
+        const auto* register_resume = std::exchange(f->on_suspend, nullptr);
+        auto fired = std::make_shared<std::atomic<bool>>(false);
+        f->pool->retain_work();  // until the resume task runs
+        try {
+            (*register_resume)(resume_handle(f, fired));
+            return;
+        } catch (...) {
+            if (fired->exchange(true, std::memory_order_acq_rel)) {
+                return;  // resume was requested before the throw; it stands
+            }
+            // Could not park: continue at once and rethrow inside the fiber
+            f->pool->release_work();
+            f->suspend_error = std::current_exception();
+        }
+    }
+}
+
+void start_fiber(ThreadPool& pool, Task task) {
+    auto f = std::make_unique<Fiber>();
+    f->pool = &pool;
+    f->worker = pool.current_worker();
+    f->task = std::move(task);
+    f->stack = take_stack(pool);
+    init_context(f.get());
+    pool.stats_.fibers_started.fetch_add(1, std::memory_order_relaxed);
+    run_fiber(f.release());
+}
+
+// ---- Spawn fibers (continuation.h) ----
+//
+// Unlike the fibers above, spawn fibers switch straight into each other
+// (child to parent and back) and move between workers, so their contexts
+// are not tied to a caller. Every thread that runs them does so from a
+// scheduler context (run_spawn_fiber_here); a spawn fiber with nothing to
+// continue switches back to the scheduler of whatever thread it is on.
+
+struct SpawnContext {
+#if RUNTIME_FIBER_ASM
+    void* sp = nullptr;
+#else
+    ucontext_t context;
+#endif
+    // A scheduler's bounds are learnt when it first switches away
+    SanitizerStack sanitizer;
+    SpawnContext* switched_from = nullptr;
+};
+
+// Arrival half of switch_context, also run first thing by a fresh fiber.
+// The context left is never resumed before this: it is published only
+// after the switch.
+void arrive(SpawnContext& context) {
+    SpawnContext* from = context.switched_from;
+    sanitizer_finish_switch(context.sanitizer, from ? &from->sanitizer : nullptr);
+}
+
+// finished: save belongs to a fiber that is never switched into again
+void switch_context(SpawnContext& save, SpawnContext& load, bool finished = false) {
+    load.switched_from = &save;
+    sanitizer_start_switch(finished ? nullptr : &save.sanitizer, load.sanitizer);
+#if RUNTIME_FIBER_ASM
+    runtime_fiber_switch(&save.sp, load.sp);
+#else
+    swapcontext(&save.context, &load.context);
+#endif
+    arrive(save);
+}
+
+struct SpawnRoot {
+    std::atomic<bool> done{false};
+    std::exception_ptr error;
+};
+
+struct SpawnFiber {
+    ThreadPool* pool = nullptr;
+    FiberStack stack;
+    SpawnContext context;
+    detail::SpawnEntry entry = nullptr;
+    void* arg = nullptr;
+    detail::SpawnFrame* frame = nullptr;  // scope it was spawned into; null for a root
+    SpawnRoot* root = nullptr;
+    bool published = false;               // parent's continuation queued
+    TaskArena arena{0};                   // task_arena() while the fiber runs
+};
+
+// A spawning fiber waiting in a queue; whoever runs it continues the fiber
+struct ContinuationTask {
+    SpawnFiber* fiber;
+    void operator()() const;
+};
+
+// A fiber can come back from a switch on another thread, and compilers
+// may keep a thread_local's address across a call. Code reading these after
+// a switch does so through [[gnu::noinline]] functions.
+thread_local SpawnFiber* tls_spawn_fiber = nullptr;
+thread_local SpawnContext* tls_scheduler = nullptr;
+// Left by a fiber switching away, for the context it switched to: a
+// finished fiber to recycle (it could not free its own stack), or the
+// frame a fiber is waiting on in sync
+thread_local SpawnFiber* tls_dead_fiber = nullptr;
+thread_local detail::SpawnFrame* tls_waiting_frame = nullptr;
+
+// Spawn fibers with their stacks, kept for reuse. They migrate, so they
+// come back to whichever thread they finish on.
+thread_local std::vector<std::unique_ptr<SpawnFiber>> tls_spawn_fiber_cache;
+
+SpawnFiber* take_spawn_fiber(ThreadPool& pool) {
+    size_t size = round_to_pages(pool.fiber_stack_size());
+    while (!tls_spawn_fiber_cache.empty()) {
+        std::unique_ptr<SpawnFiber> fiber = std::move(tls_spawn_fiber_cache.back());
+        tls_spawn_fiber_cache.pop_back();
+        if (fiber->stack.size() == size) {
+            fiber->pool = &pool;
+            return fiber.release();
+        }
+    }
+    auto fiber = std::make_unique<SpawnFiber>();
+    fiber->pool = &pool;
+    fiber->stack = FiberStack(size);
+    pool.stats_.fiber_stacks_mapped.fetch_add(1, std::memory_order_relaxed);
+    return fiber.release();
+}
+
+[[gnu::noinline]] void bury_dead_fiber() {
+    SpawnFiber* dead = std::exchange(tls_dead_fiber, nullptr);
+    if (!dead) return;
+    dead->arena.reset();
+    if (tls_spawn_fiber_cache.size() < config::fiber::spawn_fiber_cache) {
+        tls_spawn_fiber_cache.emplace_back(dead);
+    } else {
+        delete dead;
+    }
+}
+
+// Leave a finished fiber for good: continue `next`, or the scheduler
+[[noreturn, gnu::noinline]] void finish_spawn_fiber(SpawnFiber* fiber, SpawnFiber* next) {
+    tls_dead_fiber = fiber;
+    tls_spawn_fiber = next;
+    if (next) detail::bind_task_arena(&next->arena);  // else the scheduler rebinds its own
+    switch_context(fiber->context, next ? next->context : *tls_scheduler, true);
+    std::terminate();  // a finished fiber is never switched into again
+}
+
+[[noreturn]] void spawn_fiber_main(void* arg) {
+    SpawnFiber* fiber = static_cast<SpawnFiber*>(arg);
+    arrive(fiber->context);
+    bury_dead_fiber();
+    // Locals here are never destroyed: the fiber leaves its stack by a
+    // switch. Whatever owns memory is handed on or cleared first.
+    std::exception_ptr error;
+    try {
+        fiber->entry(fiber->arg);
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    if (fiber->root) {
+        fiber->root->error = std::exchange(error, nullptr);
+        fiber->root->done.store(true, std::memory_order_release);  // last access to root
+        finish_spawn_fiber(fiber, nullptr);
+    }
+
+    // Threw before taking the closure: the parent is still unqueued
+    detail::publish_continuation();
+    detail::SpawnFrame* frame = fiber->frame;
+    SpawnFiber* parent = static_cast<SpawnFiber*>(frame->parent);
+    if (error) {
+        std::lock_guard<std::mutex> lock(frame->error_mutex);
+        if (!frame->error) frame->error = error;
+        error = nullptr;
+    }
+
+    // Usually the parent is still on top of our queue: continue it here,
+    // as if the child had been a plain call
+    Task task;
+    if (fiber->pool->take_local(task)) {
+        auto* continuation = task.target<ContinuationTask>();
+        if (continuation && continuation->fiber == parent) {
+            frame->join.fetch_sub(1, std::memory_order_relaxed);
+            finish_spawn_fiber(fiber, parent);
+        }
+        fiber->pool->submit_local(std::move(task));  // not ours: put it back
+    }
+    // Taken by a thief. If it already waits in sync for us, continue it
+    if (frame->join.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        finish_spawn_fiber(fiber, parent);
+    }
+    finish_spawn_fiber(fiber, nullptr);
+}
+
+#if !RUNTIME_FIBER_ASM
+void spawn_fiber_ucontext_entry() {
+    spawn_fiber_main(tls_spawn_fiber);  // set before the first switch into it
+}
+#endif
+
+void init_spawn_fiber(SpawnFiber* fiber) {
+#if RUNTIME_FIBER_ASM
+    fiber->context.sp = prepare_stack(fiber->stack, &spawn_fiber_main, fiber);
+#else
+    ucontext_t& context = fiber->context.context;
+    if (getcontext(&context) != 0) {
+        throw std::system_error(errno, std::generic_category(), "getcontext");
+    }
+    context.uc_stack.ss_sp = fiber->stack.bottom();
+    context.uc_stack.ss_size = fiber->stack.size();
+    context.uc_link = nullptr;
+    makecontext(&context, &spawn_fiber_ucontext_entry, 0);
+#endif
+    fiber->context.sanitizer = sanitizer_stack(fiber->stack);
+}
+
+// Run fiber on this thread until it has nothing left to do here: it
+// finished, moved to another thread, or waits in sync for children
+void run_spawn_fiber_here(SpawnFiber* fiber) {
+    SpawnContext scheduler;
+    SpawnContext* outer_scheduler = std::exchange(tls_scheduler, &scheduler);
+    SpawnFiber* outer = tls_spawn_fiber;
+    while (fiber) {
+        tls_spawn_fiber = fiber;
+        TaskArena* outer_arena = detail::bind_task_arena(&fiber->arena);
+        switch_context(scheduler, fiber->context);
+        detail::bind_task_arena(outer_arena);
+        tls_spawn_fiber = outer;
+        bury_dead_fiber();
+        fiber = nullptr;
+        if (detail::SpawnFrame* frame = std::exchange(tls_waiting_frame, nullptr)) {
+            // Off its stack now, the waiting fiber drops its own reference;
+            // if its children finished meanwhile it goes on right away
+            if (frame->join.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                fiber = static_cast<SpawnFiber*>(frame->parent);
+            }
+        }
+    }
+    tls_scheduler = outer_scheduler;
+}
+
+void ContinuationTask::operator()() const {
+    ThreadPool& pool = *fiber->pool;
+    if (pool.current_worker() == ThreadPool::npos) {
+        // Picked up by a non-worker helping out (run_pending_task):
+        // spawn fibers live on workers
+        pool.submit_pinned(0, ContinuationTask{fiber});
+        return;
+    }
+    pool.stats_.continuations_stolen.fetch_add(1, std::memory_order_relaxed);
+    run_spawn_fiber_here(fiber);
+}
+
+} // namespace
+
+void submit_fiber(ThreadPool& pool, Task task) {
+    pool.submit([&pool, task = std::move(task)]() mutable {
+        if (pool.current_worker() == ThreadPool::npos) {
+            // Picked up by a non-worker helping out (run_pending_task):
+            // fibers live on workers
+            pool.submit_pinned(0, [&pool, task = std::move(task)]() mutable {
+                start_fiber(pool, std::move(task));
+            });
+            return;
+        }
+        start_fiber(pool, std::move(task));
+    });
+}
+
+namespace this_fiber {
+
+bool active() {
+    return tls_fiber != nullptr;
+}
+
+void suspend(const std::function<void(Task resume)>& register_resume) {
+    Fiber* f = tls_fiber;
+    if (!f) {
+        struct Waiter {
+            std::mutex mutex;
+            std::condition_variable cv;
+            bool ready = false;
+        };
+        auto waiter = std::make_shared<Waiter>();
+        register_resume([waiter]() {
+            {
+                std::lock_guard<std::mutex> lock(waiter->mutex);
+                waiter->ready = true;
+            }
+            waiter->cv.notify_one();
+        });
+        std::unique_lock<std::mutex> lock(waiter->mutex);
+        waiter->cv.wait(lock, [&waiter]() { return waiter->ready; });
+        return;
+    }
+
+    f->on_suspend = &register_resume;
+    switch_to_caller(f);
+    if (f->suspend_error) {
+        std::rethrow_exception(std::exchange(f->suspend_error, nullptr));
+    }
+}
+
+void yield() {
+    Fiber* f = tls_fiber;
+    if (!f) {
+        std::this_thread::yield();
+        return;
+    }
+    ThreadPool* pool = f->pool;
+    suspend([pool](Task resume) {
+        pool->run_pending_task();
+        resume();
+    });
+}
+
+void sleep_for(std::chrono::steady_clock::duration duration) {
+    Fiber* f = tls_fiber;
+    if (!f) {
+        std::this_thread::sleep_for(duration);
+        return;
+    }
+    ThreadPool* pool = f->pool;
+    suspend([pool, duration](Task resume) {
+        pool->schedule_after(duration, std::move(resume));
+    });
+}
+
+void lock(AsyncMutex& mutex) {
+    if (mutex.try_lock()) return;
+    suspend([&mutex](Task resume) { mutex.lock(std::move(resume)); });
+}
+
+void acquire(AsyncSemaphore& semaphore) {
+    if (semaphore.try_acquire()) return;
+    suspend([&semaphore](Task resume) { semaphore.acquire(std::move(resume)); });
+}
+
+void wait(Latch& latch) {
+    if (latch.try_wait()) return;
+    suspend([&latch](Task resume) { latch.async_wait(std::move(resume)); });
+}
+
+void arrive_and_wait(Barrier& barrier) {
+    suspend([&barrier](Task resume) { barrier.arrive(std::move(resume)); });
+}
+
+} // namespace this_fiber
+
+namespace detail {
+
+double measure_switch_ns(size_t round_trips) {
+    Fiber f;
+    f.stack = FiberStack(64 * 1024);
+    f.task = [&f, round_trips]() {
+        for (size_t i = 0; i < round_trips; ++i) {
+            switch_to_caller(&f);
+        }
+    };
+    init_context(&f);
+
+    Fiber* outer = tls_fiber;
+    tls_fiber = &f;
+    auto start = std::chrono::steady_clock::now();
+    while (!f.finished) {
+        switch_into(&f);
+    }
+    auto end = std::chrono::steady_clock::now();
+    tls_fiber = outer;
+
+    double switches = 2.0 * static_cast<double>(round_trips + 1);
+    return std::chrono::duration<double, std::nano>(end - start).count() / switches;
+}
+
+ThreadPool* current_spawn_pool() {
+    return tls_spawn_fiber ? tls_spawn_fiber->pool : nullptr;
+}
+
+void spawn_child(SpawnFrame& frame, SpawnEntry entry, void* arg) {
+    SpawnFiber* parent = tls_spawn_fiber;
+    SpawnFiber* child = take_spawn_fiber(*frame.pool);
+    child->entry = entry;
+    child->arg = arg;
+    child->frame = &frame;
+    child->root = nullptr;
+    child->published = false;
+    try {
+        init_spawn_fiber(child);
+    } catch (...) {
+        delete child;
+        throw;
+    }
+    frame.parent = parent;
+    frame.join.fetch_add(1, std::memory_order_relaxed);
+    frame.pool->stats_.spawns.fetch_add(1, std::memory_order_relaxed);
+
+    tls_spawn_fiber = child;
+    detail::bind_task_arena(&child->arena);
+    switch_context(parent->context, child->context);
+    // Continued by the returning child, or by a thief on its own worker
+    bury_dead_fiber();
+}
+
+[[gnu::noinline]] void publish_continuation() {
+    SpawnFiber* fiber = tls_spawn_fiber;
+    if (fiber->published) return;
+    fiber->published = true;
+    fiber->pool->submit_local(ContinuationTask{static_cast<SpawnFiber*>(fiber->frame->parent)});
+}
+
+void sync_children(SpawnFrame& frame) {
+    if (frame.join.load(std::memory_order_acquire) == 1) {
+        return;  // no child left (always the case unless we were stolen)
+    }
+    // Leave the thread; run_spawn_fiber_here drops our reference once we are off
+    // this stack, and whoever brings the count to zero continues us
+    tls_waiting_frame = &frame;
+    switch_context(tls_spawn_fiber->context, *tls_scheduler);
+    bury_dead_fiber();
+    frame.join.store(1, std::memory_order_relaxed);
+}
+
+void run_spawn_root(ThreadPool& pool, SpawnEntry entry, void* arg) {
+    SpawnRoot root;
+    SpawnFiber* fiber = take_spawn_fiber(pool);
+    fiber->entry = entry;
+    fiber->arg = arg;
+    fiber->frame = nullptr;
+    fiber->root = &root;
+    fiber->published = true;
+    try {
+        init_spawn_fiber(fiber);
+    } catch (...) {
+        delete fiber;
+        throw;
+    }
+
+    run_spawn_fiber_here(fiber);
+    // It may finish on another worker: help with queued work until it has
+    while (!root.done.load(std::memory_order_acquire)) {
+        if (!pool.run_pending_task()) {
+            std::this_thread::yield();
+        }
+    }
+    if (root.error) std::rethrow_exception(root.error);
+}
+
+} // namespace detail
+
+} // namespace runtime
@@ -0,0 +1,129 @@
+// Huge-page regions for runtime-internal memory
+#include <runtime/huge_pages.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cstdint>
+#include <new>
+
+namespace runtime {
+
+namespace {
+
+size_t round_up(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+void* map_anonymous(size_t size, int extra_flags) {
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+    return p == MAP_FAILED ? nullptr : p;
+}
+
+// Anonymous mapping aligned to a huge page, so THP can back all of it
+void* map_aligned(size_t size) {
+    const size_t huge = config::huge_pages::page_size;
+    char* raw = static_cast<char*>(map_anonymous(size + huge, 0));
+    if (!raw) return nullptr;
+    char* aligned = reinterpret_cast<char*>(round_up(reinterpret_cast<uintptr_t>(raw), huge));
+    if (aligned != raw) munmap(raw, static_cast<size_t>(aligned - raw));
+    size_t tail = static_cast<size_t>(raw + size + huge - (aligned + size));
+    if (tail != 0) munmap(aligned + size, tail);
+    return aligned;
+}
+
+} // namespace
+
+PageRegion map_pages(size_t bytes, config::HugePages mode) {
+    PageRegion region;
+    if (mode == config::HugePages::Off) {
+        region.size = round_up(bytes, static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+        region.base = map_anonymous(region.size, 0);
+        if (!region.base) throw std::bad_alloc();
+        return region;
+    }
+
+    region.size = round_up(bytes, config::huge_pages::page_size);
+#ifdef MAP_HUGETLB
+    if (mode == config::HugePages::Explicit) {
+        region.base = map_anonymous(region.size, MAP_HUGETLB);
+        if (region.base) {
+            region.huge = true;
+            return region;
+        }
+        // No reserved huge pages (vm.nr_hugepages): try THP instead
+    }
+#endif
+    region.base = map_aligned(region.size);
+    if (!region.base) throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+    region.huge = madvise(region.base, region.size, MADV_HUGEPAGE) == 0;
+#endif
+    return region;
+}
+
+void unmap_pages(const PageRegion& region) {
+    if (region.base) munmap(region.base, region.size);
+}
+
+HugePageResource::HugePageResource(config::HugePages mode,
+                                   std::atomic<uint64_t>* huge_stat,
+                                   std::atomic<uint64_t>* fallback_stat)
+    : mode_(mode),
+      huge_stat_(huge_stat),
+      fallback_stat_(fallback_stat) {}
+
+HugePageResource::~HugePageResource() {
+    for (const auto& region : regions_) unmap_pages(region);
+    for (const auto& entry : large_) unmap_pages(entry.second);
+}
+
+size_t HugePageResource::mapped_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t total = 0;
+    for (const auto& region : regions_) total += region.size;
+    for (const auto& entry : large_) total += entry.second.size;
+    return total;
+}
+
+PageRegion HugePageResource::map(size_t bytes) {
+    PageRegion region = map_pages(bytes, mode_);
+    std::atomic<uint64_t>* stat = region.huge ? huge_stat_ : fallback_stat_;
+    if (stat) stat->fetch_add(1, std::memory_order_relaxed);
+    return region;
+}
+
+void* HugePageResource::do_allocate(size_t bytes, size_t alignment) {
+    const size_t region_size = config::huge_pages::page_size;
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Only what cannot fit in a shared region is mapped alone
+    if (bytes > region_size) {
+        PageRegion region = map(bytes);
+        large_.emplace(region.base, region);
+        return region.base;
+    }
+
+    if (!regions_.empty()) {
+        uintptr_t base = reinterpret_cast<uintptr_t>(regions_.back().base);
+        size_t start = round_up(base + top_, alignment) - base;
+        if (start + bytes <= regions_.back().size) {
+            top_ = start + bytes;
+            return reinterpret_cast<void*>(base + start);
+        }
+    }
+    regions_.push_back(map(region_size));
+    top_ = bytes;
+    return regions_.back().base;
+}
+
+void HugePageResource::do_deallocate(void* p, size_t, size_t) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = large_.find(p);
+    if (it != large_.end()) {
+        unmap_pages(it->second);
+        large_.erase(it);
+    }
+    // Pieces of shared regions are released with the resource
+}
+
+} // namespace runtime
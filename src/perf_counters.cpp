@@ -0,0 +1,148 @@
+// perf_event_open counters
+#include <runtime/perf_counters.h>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace runtime {
+
+namespace {
+
+#if defined(__linux__)
+
+bool describe(PerfEvent event, perf_event_attr& attr) {
+    auto cache = [](uint64_t cache_id, uint64_t op) {
+        return cache_id | (op << 8) | (static_cast<uint64_t>(PERF_COUNT_HW_CACHE_RESULT_MISS) << 16);
+    };
+    switch (event) {
+        case PerfEvent::Cycles:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            return true;
+        case PerfEvent::Instructions:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            return true;
+        case PerfEvent::CacheMisses:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            return true;
+        case PerfEvent::DtlbLoadMisses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = cache(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ);
+            return true;
+        case PerfEvent::DtlbStoreMisses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = cache(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_WRITE);
+            return true;
+        case PerfEvent::PageFaults:
+            attr.type = PERF_TYPE_SOFTWARE;
+            attr.config = PERF_COUNT_SW_PAGE_FAULTS;
+            return true;
+        case PerfEvent::TaskClock:
+            attr.type = PERF_TYPE_SOFTWARE;
+            attr.config = PERF_COUNT_SW_TASK_CLOCK;
+            return true;
+    }
+    return false;
+}
+
+int open_counter(PerfEvent event) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    if (!describe(event, attr)) return -1;
+    attr.disabled = 1;
+    attr.inherit = 1;          // threads started later count too
+    attr.exclude_kernel = 1;   // allowed at perf_event_paranoid 2
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    return fd < 0 ? -1 : static_cast<int>(fd);
+}
+
+#endif
+
+} // namespace
+
+PerfCounters::PerfCounters(std::initializer_list<PerfEvent> events) {
+    for (PerfEvent event : events) {
+#if defined(__linux__)
+        counters_.push_back({event, open_counter(event)});
+#else
+        counters_.push_back({event, -1});
+#endif
+    }
+}
+
+PerfCounters::~PerfCounters() {
+#if defined(__linux__)
+    for (const auto& counter : counters_) {
+        if (counter.fd >= 0) close(counter.fd);
+    }
+#endif
+}
+
+void PerfCounters::start() {
+#if defined(__linux__)
+    for (const auto& counter : counters_) {
+        if (counter.fd < 0) continue;
+        ioctl(counter.fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter.fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+void PerfCounters::stop() {
+#if defined(__linux__)
+    for (const auto& counter : counters_) {
+        if (counter.fd >= 0) ioctl(counter.fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+#endif
+}
+
+const PerfCounters::Counter* PerfCounters::find(PerfEvent event) const {
+    for (const auto& counter : counters_) {
+        if (counter.event == event) return &counter;
+    }
+    return nullptr;
+}
+
+bool PerfCounters::available(PerfEvent event) const {
+    const Counter* counter = find(event);
+    return counter && counter->fd >= 0;
+}
+
+uint64_t PerfCounters::value(PerfEvent event) const {
+    const Counter* counter = find(event);
+    if (!counter || counter->fd < 0) return 0;
+#if defined(__linux__)
+    uint64_t data[3] = {0, 0, 0};  // value, time enabled, time running
+    if (read(counter->fd, data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) return 0;
+    if (data[2] != 0 && data[2] < data[1]) {
+        return static_cast<uint64_t>(static_cast<double>(data[0]) * data[1] / data[2]);
+    }
+    return data[0];
+#else
+    return 0;
+#endif
+}
+
+const char* PerfCounters::name(PerfEvent event) {
+    switch (event) {
+        case PerfEvent::Cycles: return "cycles";
+        case PerfEvent::Instructions: return "instructions";
+        case PerfEvent::CacheMisses: return "cache-misses";
+        case PerfEvent::DtlbLoadMisses: return "dTLB-load-misses";
+        case PerfEvent::DtlbStoreMisses: return "dTLB-store-misses";
+        case PerfEvent::PageFaults: return "page-faults";
+        case PerfEvent::TaskClock: return "task-clock";
+    }
+    return "unknown";
+}
+
+} // namespace runtime
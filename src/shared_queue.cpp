@@ -0,0 +1,409 @@
+// Cross-process task queue in POSIX shared memory
+#include <runtime/shared_queue.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <pthread.h>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <new>
+#include <system_error>
+#include <thread>
+
+namespace runtime {
+
+namespace {
+
+constexpr uint64_t queue_magic = 0x52544b5348515545ULL;  // "RTKSHQUE"
+constexpr uint32_t queue_version = 1;
+
+// Slot state word: lap (32 bits) | state (2 bits) | pid (30 bits)
+enum SlotState : uint64_t {
+    Empty = 0,    // ready for this lap's producer
+    Writing = 1,  // claimed by the producer whose pid is stored
+    Full = 2,     // descriptor ready
+    Reading = 3   // claimed by the consumer whose pid is stored
+};
+
+constexpr uint64_t pid_mask = (uint64_t(1) << 30) - 1;
+
+constexpr uint64_t pack(uint32_t lap, SlotState state, uint32_t pid) {
+    return (uint64_t(lap) << 32) | (uint64_t(state) << 30) | (pid & pid_mask);
+}
+uint32_t lap_of(uint64_t word) { return static_cast<uint32_t>(word >> 32); }
+SlotState state_of(uint64_t word) { return static_cast<SlotState>((word >> 30) & 3); }
+uint32_t pid_of(uint64_t word) { return static_cast<uint32_t>(word & pid_mask); }
+
+bool process_alive(uint32_t pid) {
+    return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+}
+
+// getpid() is a system call on current glibc; every push and pop needs it
+uint32_t cached_pid = 0;
+
+void refresh_pid() {
+    cached_pid = static_cast<uint32_t>(getpid());
+}
+
+uint32_t current_pid() {
+    static const bool registered = []() {
+        refresh_pid();
+        pthread_atfork(nullptr, nullptr, &refresh_pid);
+        return true;
+    }();
+    (void)registered;
+    return cached_pid;
+}
+
+size_t round_up_pow2(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+size_t log2_of(size_t pow2) {
+    size_t bits = 0;
+    while ((size_t(1) << bits) < pow2) ++bits;
+    return bits;
+}
+
+} // namespace
+
+struct SharedTaskQueue::Header {
+    std::atomic<uint64_t> magic;  // stored last by the creator
+    uint32_t version;
+    uint32_t capacity;
+    int32_t creator_pid;
+    std::atomic<uint64_t> recovered;
+    alignas(64) std::atomic<uint64_t> enqueue_pos;
+    alignas(64) std::atomic<uint64_t> dequeue_pos;
+};
+
+struct SharedTaskQueue::Slot {
+    std::atomic<uint64_t> word;
+    uint32_t function_id;  // 0: skipped by a producer whose write failed
+    uint32_t size;
+    unsigned char payload[config::shared_queue::payload_size];
+};
+
+void SharedTaskRegistry::add(uint32_t function_id, Handler handler) {
+    if (function_id == 0) {
+        throw std::invalid_argument("Shared task function id 0 is reserved");
+    }
+    if (!handlers_.emplace(function_id, std::move(handler)).second) {
+        throw std::invalid_argument("Shared task function id already registered");
+    }
+}
+
+const SharedTaskRegistry::Handler* SharedTaskRegistry::find(uint32_t function_id) const {
+    auto it = handlers_.find(function_id);
+    return it == handlers_.end() ? nullptr : &it->second;
+}
+
+SharedTaskQueue::SharedTaskQueue(const std::string& name, Mode mode, size_t capacity)
+    : name_(name) {
+    static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                  "Shared queue needs address-free 64-bit atomics");
+
+    if (mode == Mode::Create) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Shared queue capacity must be > 0");
+        }
+        capacity_ = round_up_pow2(capacity);
+        mapping_size_ = slots_offset() + capacity_ * sizeof(Slot);
+
+        int fd = shm_open(name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd < 0 && errno == EEXIST) {
+            // Left behind by a creator that died? Then take the name over
+            int old_fd = shm_open(name_.c_str(), O_RDWR, 0);
+            bool stale = false;
+            if (old_fd >= 0) {
+                struct stat st {};
+                if (fstat(old_fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(Header)) {
+                    void* old = mmap(nullptr, sizeof(Header), PROT_READ, MAP_SHARED, old_fd, 0);
+                    if (old != MAP_FAILED) {
+                        auto* header = static_cast<Header*>(old);
+                        stale = !process_alive(static_cast<uint32_t>(header->creator_pid));
+                        munmap(old, sizeof(Header));
+                    }
+                } else {
+                    stale = true;  // never initialised
+                }
+                close(old_fd);
+            }
+            if (stale) {
+                shm_unlink(name_.c_str());
+                fd = shm_open(name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+            } else {
+                errno = EEXIST;
+            }
+        }
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "shm_open " + name_);
+        }
+        if (ftruncate(fd, static_cast<off_t>(mapping_size_)) != 0) {
+            int error = errno;
+            close(fd);
+            shm_unlink(name_.c_str());
+            throw std::system_error(error, std::generic_category(), "ftruncate " + name_);
+        }
+        mapping_ = mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        int error = errno;
+        close(fd);
+        if (mapping_ == MAP_FAILED) {
+            mapping_ = nullptr;
+            shm_unlink(name_.c_str());
+            throw std::system_error(error, std::generic_category(), "mmap " + name_);
+        }
+        owner_ = true;
+
+        header_ = new (mapping_) Header();
+        header_->version = queue_version;
+        header_->capacity = static_cast<uint32_t>(capacity_);
+        header_->creator_pid = static_cast<int32_t>(getpid());
+        header_->recovered.store(0, std::memory_order_relaxed);
+        header_->enqueue_pos.store(0, std::memory_order_relaxed);
+        header_->dequeue_pos.store(0, std::memory_order_relaxed);
+        for (size_t i = 0; i < capacity_; ++i) {
+            Slot* s = new (static_cast<char*>(mapping_) + slots_offset() + i * sizeof(Slot)) Slot();
+            s->word.store(pack(0, Empty, 0), std::memory_order_relaxed);
+        }
+        header_->magic.store(queue_magic, std::memory_order_release);
+        return;
+    }
+
+    int fd = shm_open(name_.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "shm_open " + name_);
+    }
+    // The creator may still be sizing / initialising it
+    struct stat st {};
+    for (int attempt = 0; ; ++attempt) {
+        if (fstat(fd, &st) != 0) {
+            int error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "fstat " + name_);
+        }
+        if (static_cast<size_t>(st.st_size) >= sizeof(Header)) break;
+        if (attempt == 1000) {
+            close(fd);
+            throw std::runtime_error("Shared queue " + name_ + " was never initialised");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    mapping_size_ = static_cast<size_t>(st.st_size);
+    mapping_ = mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    int error = errno;
+    close(fd);
+    if (mapping_ == MAP_FAILED) {
+        mapping_ = nullptr;
+        throw std::system_error(error, std::generic_category(), "mmap " + name_);
+    }
+    header_ = static_cast<Header*>(mapping_);
+    for (int attempt = 0; header_->magic.load(std::memory_order_acquire) != queue_magic; ++attempt) {
+        if (attempt == 1000) {
+            munmap(mapping_, mapping_size_);
+            throw std::runtime_error("Shared queue " + name_ + " was never initialised");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    capacity_ = header_->capacity;
+    if (header_->version != queue_version || mapping_size_ < slots_offset() + capacity_ * sizeof(Slot)) {
+        munmap(mapping_, mapping_size_);
+        throw std::runtime_error("Shared queue " + name_ + " has an incompatible layout");
+    }
+}
+
+SharedTaskQueue::~SharedTaskQueue() {
+    if (mapping_) {
+        munmap(mapping_, mapping_size_);
+    }
+    if (owner_) {
+        shm_unlink(name_.c_str());
+    }
+}
+
+size_t SharedTaskQueue::slots_offset() {
+    return (sizeof(Header) + 63) / 64 * 64;
+}
+
+SharedTaskQueue::Slot* SharedTaskQueue::slot(uint64_t position) const {
+    return reinterpret_cast<Slot*>(static_cast<char*>(mapping_) + slots_offset() +
+                                   (position & (capacity_ - 1)) * sizeof(Slot));
+}
+
+bool SharedTaskQueue::try_push(uint32_t function_id, const void* payload, size_t size) {
+    if (size > config::shared_queue::payload_size) {
+        throw std::length_error("Payload does not fit a shared queue slot");
+    }
+    return try_push_with(function_id, [payload, size](void* buffer, size_t) {
+        std::memcpy(buffer, payload, size);
+        return size;
+    });
+}
+
+bool SharedTaskQueue::try_push_with(uint32_t function_id,
+                                    const std::function<size_t(void*, size_t)>& write) {
+    if (function_id == 0) {
+        throw std::invalid_argument("Shared task function id 0 is reserved");
+    }
+    const uint32_t pid = current_pid();
+    const size_t lap_shift = log2_of(capacity_);
+
+    while (true) {
+        uint64_t pos = header_->enqueue_pos.load(std::memory_order_acquire);
+        Slot* s = slot(pos);
+        uint32_t lap = static_cast<uint32_t>(pos >> lap_shift);
+        uint64_t word = s->word.load(std::memory_order_acquire);
+        int32_t ahead = static_cast<int32_t>(lap_of(word) - lap);
+
+        if (ahead == 0 && state_of(word) == Empty) {
+            if (!s->word.compare_exchange_weak(word, pack(lap, Writing, pid), std::memory_order_acq_rel)) {
+                continue;
+            }
+            header_->enqueue_pos.compare_exchange_strong(pos, pos + 1, std::memory_order_acq_rel);
+
+            size_t size = 0;
+            try {
+                size = write(s->payload, config::shared_queue::payload_size);
+                if (size > config::shared_queue::payload_size) {
+                    throw std::length_error("Payload does not fit a shared queue slot");
+                }
+            } catch (...) {
+                // Consumers must not wait on this slot forever: publish it as skipped
+                s->function_id = 0;
+                s->size = 0;
+                s->word.store(pack(lap, Full, pid), std::memory_order_release);
+                throw;
+            }
+            s->function_id = function_id;
+            s->size = static_cast<uint32_t>(size);
+            s->word.store(pack(lap, Full, pid), std::memory_order_release);
+            return true;
+        }
+        if (ahead >= 0) {
+            // Already claimed for this lap, or long done: move the position on
+            header_->enqueue_pos.compare_exchange_strong(pos, pos + 1, std::memory_order_acq_rel);
+            continue;
+        }
+        // Still holds the previous lap: the ring is full, unless its reader died
+        if (state_of(word) == Reading && !process_alive(pid_of(word))) {
+            if (s->word.compare_exchange_strong(word, pack(lap, Empty, 0), std::memory_order_acq_rel)) {
+                header_->recovered.fetch_add(1, std::memory_order_relaxed);
+            }
+            continue;
+        }
+        return false;
+    }
+}
+
+bool SharedTaskQueue::try_pop_with(const std::function<void(uint32_t, const void*, size_t)>& read) {
+    return pop_slot(nullptr, read);
+}
+
+bool SharedTaskQueue::pop_slot(const SharedTaskRegistry* registry,
+                               const std::function<void(uint32_t, const void*, size_t)>& read) {
+    const uint32_t pid = current_pid();
+    const size_t lap_shift = log2_of(capacity_);
+
+    while (true) {
+        uint64_t pos = header_->dequeue_pos.load(std::memory_order_acquire);
+        Slot* s = slot(pos);
+        uint32_t lap = static_cast<uint32_t>(pos >> lap_shift);
+        uint64_t word = s->word.load(std::memory_order_acquire);
+        int32_t ahead = static_cast<int32_t>(lap_of(word) - lap);
+
+        if (ahead > 0) {
+            header_->dequeue_pos.compare_exchange_strong(pos, pos + 1, std::memory_order_acq_rel);
+            continue;
+        }
+        if (ahead < 0) {
+            // The previous lap is still being read here: nothing newer yet
+            if (state_of(word) == Reading && !process_alive(pid_of(word)) &&
+                s->word.compare_exchange_strong(word, pack(lap, Empty, 0), std::memory_order_acq_rel)) {
+                header_->recovered.fetch_add(1, std::memory_order_relaxed);
+            }
+            return false;
+        }
+
+        switch (state_of(word)) {
+            case Empty:
+                return false;
+
+            case Full: {
+                // The acquire load above published the descriptor: leave
+                // types this process has no handler for to one that does
+                uint32_t function_id = s->function_id;
+                if (registry && function_id != 0 && !registry->find(function_id)) {
+                    return false;
+                }
+                if (!s->word.compare_exchange_weak(word, pack(lap, Reading, pid), std::memory_order_acq_rel)) {
+                    continue;
+                }
+                header_->dequeue_pos.compare_exchange_strong(pos, pos + 1, std::memory_order_acq_rel);
+                if (s->function_id == 0) {
+                    s->word.store(pack(lap + 1, Empty, 0), std::memory_order_release);
+                    continue;
+                }
+                try {
+                    read(s->function_id, s->payload, s->size);
+                } catch (...) {
+                    s->word.store(pack(lap + 1, Empty, 0), std::memory_order_release);
+                    throw;
+                }
+                s->word.store(pack(lap + 1, Empty, 0), std::memory_order_release);
+                return true;
+            }
+
+            case Writing:
+                if (process_alive(pid_of(word))) {
+                    return false;  // push in progress
+                }
+                // Writer died mid-push: drop the half-written descriptor
+                if (s->word.compare_exchange_strong(word, pack(lap, Reading, pid), std::memory_order_acq_rel)) {
+                    header_->dequeue_pos.compare_exchange_strong(pos, pos + 1, std::memory_order_acq_rel);
+                    s->word.store(pack(lap + 1, Empty, 0), std::memory_order_release);
+                    header_->recovered.fetch_add(1, std::memory_order_relaxed);
+                }
+                continue;
+
+            case Reading:
+                if (!process_alive(pid_of(word)) &&
+                    s->word.compare_exchange_strong(word, pack(lap + 1, Empty, 0), std::memory_order_acq_rel)) {
+                    header_->recovered.fetch_add(1, std::memory_order_relaxed);
+                }
+                header_->dequeue_pos.compare_exchange_strong(pos, pos + 1, std::memory_order_acq_rel);
+                continue;
+        }
+    }
+}
+
+bool SharedTaskQueue::try_pop(const SharedTaskRegistry& registry, Task& task) {
+    return pop_slot(&registry, [&](uint32_t function_id, const void* payload, size_t size) {
+        const SharedTaskRegistry::Handler* handler = registry.find(function_id);
+        std::array<unsigned char, config::shared_queue::payload_size> bytes;
+        std::memcpy(bytes.data(), payload, size);
+        task = [handler, bytes, size]() { (*handler)(bytes.data(), size); };
+    });
+}
+
+size_t SharedTaskQueue::size_approx() const {
+    uint64_t enqueued = header_->enqueue_pos.load(std::memory_order_acquire);
+    uint64_t dequeued = header_->dequeue_pos.load(std::memory_order_acquire);
+    return enqueued > dequeued ? static_cast<size_t>(enqueued - dequeued) : 0;
+}
+
+uint64_t SharedTaskQueue::recovered() const {
+    return header_->recovered.load(std::memory_order_relaxed);
+}
+
+void attach_shared_queue(ThreadPool& pool, SharedTaskQueue& queue, const SharedTaskRegistry& registry) {
+    pool.add_steal_source([&queue, &registry](Task& task) {
+        return queue.try_pop(registry, task);
+    });
+}
+
+} // namespace runtime
@@ -0,0 +1,143 @@
+// Per-worker bump arenas for task scratch memory
+#include <runtime/task_arena.h>
+#include <sys/mman.h>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace runtime {
+
+namespace {
+
+thread_local TaskArena* tls_arena = nullptr;
+thread_local size_t tls_task_depth = 0;
+
+constexpr size_t page_alignment = 4096;
+
+size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+TaskArena::TaskArena(size_t capacity, std::atomic<uint64_t>* fallback_stat,
+                     std::pmr::memory_resource* upstream)
+    : capacity_(capacity),
+      fallback_stat_(fallback_stat),
+      upstream_(upstream) {}
+
+TaskArena::~TaskArena() {
+    reset();
+    if (!buffer_) return;
+    if (upstream_) upstream_->deallocate(buffer_, capacity_, page_alignment);
+    else munmap(buffer_, capacity_);
+}
+
+void* TaskArena::do_allocate(size_t bytes, size_t alignment) {
+    if (bytes == 0) bytes = 1;
+    if (!buffer_ && capacity_ != 0) {
+        // Mapped lazily, so the pages are first touched by the owning worker
+        void* mapped = MAP_FAILED;
+        if (upstream_) {
+            try {
+                mapped = upstream_->allocate(capacity_, page_alignment);
+            } catch (const std::bad_alloc&) {
+            }
+        } else {
+            mapped = mmap(nullptr, capacity_, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        }
+        if (mapped == MAP_FAILED) {
+            capacity_ = 0;  // no arena after all: the heap serves everything
+        } else {
+            buffer_ = static_cast<unsigned char*>(mapped);
+        }
+    }
+
+    // Written so that no sum can wrap for huge requests or alignments
+    size_t start = align_up(top_, alignment);
+    if (start >= top_ && start <= capacity_ && bytes <= capacity_ - start) {
+        last_ = start;
+        last_top_ = top_;
+        top_ = start + bytes;
+        if (top_ > high_water_) high_water_ = top_;
+        return buffer_ + start;
+    }
+    return allocate_heap(bytes, alignment);
+}
+
+void* TaskArena::allocate_heap(size_t bytes, size_t alignment) {
+    if (alignment < alignof(HeapBlock)) alignment = alignof(HeapBlock);
+    size_t header = align_up(sizeof(HeapBlock), alignment);
+    if (header < sizeof(HeapBlock) || bytes > SIZE_MAX - header) {
+        throw std::bad_alloc();
+    }
+    void* base = ::operator new(header + bytes, std::align_val_t(alignment));
+
+    unsigned char* p = static_cast<unsigned char*>(base) + header;
+    HeapBlock* block = reinterpret_cast<HeapBlock*>(p) - 1;
+    block->prev = nullptr;
+    block->next = heap_;
+    block->base = base;
+    block->alignment = alignment;
+    if (heap_) heap_->prev = block;
+    heap_ = block;
+    ++heap_blocks_;
+    if (fallback_stat_) fallback_stat_->fetch_add(1, std::memory_order_relaxed);
+    return p;
+}
+
+void TaskArena::do_deallocate(void* p, size_t, size_t) {
+    unsigned char* bytes = static_cast<unsigned char*>(p);
+    if (buffer_ && bytes >= buffer_ && bytes < buffer_ + capacity_) {
+        // Only the newest block can be given back without a free list
+        if (bytes == buffer_ + last_ && top_ != last_top_) top_ = last_top_;
+        return;
+    }
+
+    HeapBlock* block = reinterpret_cast<HeapBlock*>(p) - 1;
+    if (block->prev) block->prev->next = block->next;
+    else heap_ = block->next;
+    if (block->next) block->next->prev = block->prev;
+    --heap_blocks_;
+    ::operator delete(block->base, std::align_val_t(block->alignment));
+}
+
+void TaskArena::reset() {
+    while (heap_) {
+        HeapBlock* block = heap_;
+        heap_ = block->next;
+        ::operator delete(block->base, std::align_val_t(block->alignment));
+    }
+    heap_blocks_ = 0;
+    top_ = 0;
+    last_ = 0;
+    last_top_ = 0;
+}
+
+TaskArena& task_arena() {
+    if (tls_arena) return *tls_arena;
+    thread_local TaskArena heap_only(0);
+    return heap_only;
+}
+
+namespace detail {
+
+TaskArena* bind_task_arena(TaskArena* arena) {
+    return std::exchange(tls_arena, arena);
+}
+
+size_t enter_task() {
+    return tls_task_depth++;
+}
+
+// Reads the thread_locals afresh: a fiber that ran the task may have
+// suspended and come back on another worker's thread in the meantime
+[[gnu::noinline]] void leave_task(size_t outer) {
+    tls_task_depth = outer;
+    if (outer == 0 && tls_arena) tls_arena->reset();
+}
+
+} // namespace detail
+
+} // namespace runtime
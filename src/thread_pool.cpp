@@ -1,18 +1,64 @@
 // Thread pool with work stealing
 #include <runtime/thread_pool.h>
 #include <stdexcept>
+#include <algorithm>
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
 // #include <iostream>
 
 namespace runtime {
 
+namespace {
+
+// Identify which pool (and which worker of it) the current thread belongs to
+thread_local const ThreadPool* tls_pool = nullptr;
+thread_local size_t tls_worker_index = ThreadPool::npos;
+
+// RAII guard for exception safety: undo the active task count if enqueueing throws
+struct SubmitGuard {
+    std::atomic<size_t>& counter;
+    bool committed = false;
+    ~SubmitGuard() noexcept {
+        if (!committed) {
+            counter.fetch_sub(1, std::memory_order_release);
+        }
+    }
+};
+
+// Tell the core we are spinning: frees pipeline resources for a sibling
+// hyperthread and saves power
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+} // namespace
+
 // Constructor with options
 ThreadPool::ThreadPool(const config::ThreadPoolOptions& options)
     : thread_count_(options.threads),
       steal_attempts_(options.steal_attempts),
       idle_sleep_(options.idle_sleep),
+      idle_strategy_(options.idle_strategy),
+      idle_spins_(options.idle_spins),
+      idle_yields_(options.idle_yields),
+      adaptive_spin_(options.adaptive_spin),
       max_queue_tasks_(options.max_queue_tasks),
       steal_policy_(options.steal_policy),
-      stop_(false)
+      target_chunk_duration_(options.target_chunk_duration),
+      max_pending_tasks_(options.max_pending_tasks),
+      submit_timeout_(options.submit_timeout),
+      rejection_handler_(options.rejection_handler),
+      fiber_stack_size_(options.fiber_stack_size),
+      task_arena_size_(options.task_arena_size),
+      stop_(false),
+      huge_pages_(options.huge_pages == config::HugePages::Off ? nullptr
+                  : std::make_unique<HugePageResource>(options.huge_pages, &stats_.huge_page_regions,
+                                                       &stats_.huge_page_fallbacks))
     {
         // std::cout << "Creating ThreadPool " << "\n";
         // Validate configuration
@@ -22,10 +68,22 @@ ThreadPool::ThreadPool(const config::ThreadPoolOptions& options)
         if (steal_attempts_ <= 0) {
             throw std::invalid_argument("Steal attempts must be > 0");
         }
+        if (target_chunk_duration_.count() <= 0) {
+            throw std::invalid_argument("Target chunk duration must be > 0");
+        }
+        if (fiber_stack_size_ == 0) {
+            throw std::invalid_argument("Fiber stack size must be > 0");
+        }
         work_queues_.reserve(thread_count_);
+        pinned_queues_.reserve(thread_count_);
         for (size_t i = 0; i < thread_count_; ++i) {
-            work_queues_.emplace_back(std::make_unique<WorkStealingQueue>());
+            work_queues_.emplace_back(std::make_unique<WorkStealingQueue>(huge_pages_.get()));
+            pinned_queues_.emplace_back(std::make_unique<WorkStealingQueue>());
+            parkers_.emplace_back(std::make_unique<Parker>());
+            arenas_.emplace_back(std::make_unique<TaskArena>(task_arena_size_, &stats_.arena_fallbacks,
+                                                             huge_pages_.get()));
         }
+        sleepers_.reserve(thread_count_);
 
         threads_.reserve(thread_count_);
         for (size_t i = 0; i < thread_count_; ++i) {
@@ -49,12 +107,25 @@ void ThreadPool::shutdown() {
         // already shutting down
         return;
     }
+
+    // release producers parked on a full pool; they see stop_ and throw
+    {
+        std::lock_guard<std::mutex> lock(space_mutex_);
+        cv_space_.notify_all();
+    }
+
+    // drop pending timers so none fires into a stopped pool
+    {
+        std::lock_guard<std::mutex> lock(timers_mutex_);
+        if (timers_) timers_->stop();
+    }
     
     // wait for currently active tasks to finish
     wait();
 
     // wake all workers so they can exit
-    cv_work_.notify_all();
+    while (wake_one()) {
+    }
 
     // join threads
     for (auto& t : threads_) {
@@ -66,101 +137,580 @@ void ThreadPool::shutdown() {
     threads_.clear();
 }
 
-// Choose a thread's queue and add a task to it
+// Add a task, parking the caller while the pool is full
 void ThreadPool::submit(Task task) {
     // std::cout << "Submitting a task " << "\n";
     // Check if shutting down
     if (stop_.load(std::memory_order_acquire)) {
         throw std::runtime_error("ThreadPool is shutting down");
     }
-    
-    // RAII guard for exception safety
-    struct SubmitGuard {
-        std::atomic<size_t>& counter;
-        bool committed = false;
-        ~SubmitGuard() noexcept {
-            if (!committed) {
-                counter.fetch_sub(1, std::memory_order_release);
-            }
-        }
+    if (!admit(submit_timeout_)) {
+        reject(std::move(task));
+        return;
+    }
+    enqueue(std::move(task));
+}
+
+bool ThreadPool::try_submit(Task task) {
+    if (stop_.load(std::memory_order_acquire)) {
+        throw std::runtime_error("ThreadPool is shutting down");
+    }
+    if (!admit(std::chrono::milliseconds::zero())) {
+        stats_.tasks_rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    enqueue(std::move(task));
+    return true;
+}
+
+bool ThreadPool::submit_for(Task task, std::chrono::milliseconds timeout) {
+    if (stop_.load(std::memory_order_acquire)) {
+        throw std::runtime_error("ThreadPool is shutting down");
+    }
+    if (!admit(timeout)) {
+        stats_.tasks_rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    enqueue(std::move(task));
+    return true;
+}
+
+// Count one more task into active_tasks_. Producers outside the pool are
+// held to max_pending_tasks_ and wait up to `timeout` for a task to finish;
+// returns false if no room was found in time.
+bool ThreadPool::admit(std::chrono::milliseconds timeout) {
+    if (max_pending_tasks_ == 0 || current_worker() != npos) {
+        active_tasks_.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+    if (try_admit()) {
+        return true;
+    }
+    if (timeout <= std::chrono::milliseconds::zero()) {
+        return false;
+    }
+
+    stats_.producer_waits.fetch_add(1, std::memory_order_relaxed);
+    std::unique_lock<std::mutex> lock(space_mutex_);
+    // seq_cst, paired with the fence in run_task: either the finishing task
+    // sees this producer and notifies, or try_admit below sees its slot
+    blocked_producers_.fetch_add(1);
+    bool stopping = false;
+    auto room = [this, &stopping]() {
+        stopping = stop_.load(std::memory_order_acquire);
+        return stopping || try_admit();
     };
-    
-    active_tasks_.fetch_add(1, std::memory_order_release);
+    bool admitted = true;
+    if (timeout == config::backpressure::wait_forever) {
+        cv_space_.wait(lock, room);
+    } else {
+        admitted = cv_space_.wait_for(lock, timeout, room);
+    }
+    blocked_producers_.fetch_sub(1);
+
+    if (stopping) {
+        throw std::runtime_error("ThreadPool is shutting down");
+    }
+    return admitted;
+}
+
+// Take a slot if the pool is below max_pending_tasks_
+bool ThreadPool::try_admit() {
+    size_t pending = active_tasks_.load();
+    while (pending < max_pending_tasks_) {
+        if (active_tasks_.compare_exchange_weak(pending, pending + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Choose a thread's queue and add an admitted task to it
+void ThreadPool::enqueue(Task task) {
     SubmitGuard guard{active_tasks_};
-    
-    
-    
+
     size_t idx = get_random_thread();
-    if (work_queues_[idx]->try_push(std::move(task), max_queue_tasks_)) {
-        guard.committed = true;
-        cv_work_.notify_one();
-        stats_.tasks_submitted.fetch_add(1, std::memory_order_relaxed);
-        // std::cout << "Submitted a task " << "\n";
+    if (!work_queues_[idx]->try_push(std::move(task), max_queue_tasks_)) {
+        global_queue_.push(std::move(task));
+    }
+    guard.committed = true;
+    notify_work(1);
+    stats_.tasks_submitted.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ThreadPool::reject(Task task) {
+    stats_.tasks_rejected.fetch_add(1, std::memory_order_relaxed);
+    if (!rejection_handler_) {
+        throw TaskRejectedError("ThreadPool is full (max_pending_tasks reached)");
+    }
+    rejection_handler_(std::move(task));
+}
+
+// Push to the given worker's queue, spilling to the global queue when full
+void ThreadPool::submit_to(size_t worker_index, Task task) {
+    if (stop_.load(std::memory_order_acquire)) {
+        throw std::runtime_error("ThreadPool is shutting down");
+    }
+    if (worker_index >= thread_count_) {
+        throw std::out_of_range("Worker index out of range");
+    }
+
+    if (!admit(submit_timeout_)) {
+        reject(std::move(task));
         return;
     }
-    
-    global_queue_.push(std::move(task));  // Protected now!
+    SubmitGuard guard{active_tasks_};
+
+    if (!work_queues_[worker_index]->try_push(std::move(task), max_queue_tasks_)) {
+        global_queue_.push(std::move(task));
+    }
     guard.committed = true;
-    // std::cout << "Submitted a task " << "\n";
-    cv_work_.notify_one();
+    // Wake the target if it sleeps; otherwise anyone may take the task
+    if (!wake_worker(worker_index)) {
+        notify_work(1);
+    }
     stats_.tasks_submitted.fetch_add(1, std::memory_order_relaxed);
 }
 
+// Spread the tasks over the worker queues in contiguous groups, starting at
+// a random worker; whatever does not fit goes to the global queue
+void ThreadPool::submit_batch(std::vector<Task>& tasks) {
+    if (tasks.empty()) return;
+    if (stop_.load(std::memory_order_acquire)) {
+        throw std::runtime_error("ThreadPool is shutting down");
+    }
+
+    const size_t count = tasks.size();
+    active_tasks_.fetch_add(count, std::memory_order_release);
+
+    const size_t groups = std::min(count, thread_count_);
+    const size_t first_worker = get_random_thread();
+    for (size_t g = 0; g < groups; ++g) {
+        size_t begin = count * g / groups;
+        size_t end = count * (g + 1) / groups;
+        size_t pushed = work_queues_[(first_worker + g) % thread_count_]->try_push_batch(
+            tasks.data() + begin, end - begin, max_queue_tasks_);
+        if (begin + pushed < end) {
+            global_queue_.push_batch(tasks.data() + begin + pushed, end - begin - pushed);
+        }
+    }
+    tasks.clear();
+
+    notify_work(count);
+    stats_.tasks_submitted.fetch_add(count, std::memory_order_relaxed);
+}
+
+// The whole batch goes to one worker's queue, spilling to the global queue
+// when full; the target is woken first, then helpers for the rest
+void ThreadPool::submit_batch_to(size_t worker_index, std::vector<Task>& tasks) {
+    if (tasks.empty()) return;
+    if (stop_.load(std::memory_order_acquire)) {
+        throw std::runtime_error("ThreadPool is shutting down");
+    }
+    if (worker_index >= thread_count_) {
+        throw std::out_of_range("Worker index out of range");
+    }
+
+    const size_t count = tasks.size();
+    active_tasks_.fetch_add(count, std::memory_order_release);
+    size_t pushed = work_queues_[worker_index]->try_push_batch(tasks.data(), count, max_queue_tasks_);
+    if (pushed < count) {
+        global_queue_.push_batch(tasks.data() + pushed, count - pushed);
+    }
+    tasks.clear();
+
+    size_t woken = wake_worker(worker_index) ? 1 : 0;
+    if (count > woken) {
+        notify_work(count - woken);
+    }
+    stats_.tasks_submitted.fetch_add(count, std::memory_order_relaxed);
+}
+
+// Like submit_to, but into a queue that only the target worker takes from.
+// Accepted while stopping: the fibers it resumes are already counted.
+void ThreadPool::submit_pinned(size_t worker_index, Task task) {
+    if (worker_index >= thread_count_) {
+        throw std::out_of_range("Worker index out of range");
+    }
+
+    active_tasks_.fetch_add(1, std::memory_order_release);
+    SubmitGuard guard{active_tasks_};
+
+    pinned_queues_[worker_index]->push(std::move(task));
+    pinned_pending_.fetch_add(1, std::memory_order_release);
+    guard.committed = true;
+    // Only the target can run it; if it is awake it finds it on its next sweep
+    wake_worker(worker_index);
+    stats_.tasks_submitted.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ThreadPool::add_steal_source(StealSource source) {
+    std::lock_guard<std::mutex> lock(steal_sources_mutex_);
+    auto sources = std::make_shared<std::vector<StealSource>>();
+    if (auto current = std::atomic_load(&steal_sources_)) {
+        *sources = *current;
+    }
+    sources->push_back(std::move(source));
+    std::atomic_store(&steal_sources_, std::shared_ptr<const std::vector<StealSource>>(std::move(sources)));
+}
+
+void ThreadPool::retain_work() {
+    active_tasks_.fetch_add(1, std::memory_order_release);
+}
+
+void ThreadPool::release_work() {
+    TaskGuard guard(active_tasks_, cv_completion_);
+}
+
+TimerWheel& ThreadPool::timers() {
+    std::lock_guard<std::mutex> lock(timers_mutex_);
+    if (stop_.load(std::memory_order_acquire)) {
+        throw std::runtime_error("ThreadPool is shutting down");
+    }
+    if (!timers_) {
+        timers_ = std::make_unique<TimerWheel>([this](std::vector<Task>& batch) {
+            stats_.timers_fired.fetch_add(batch.size(), std::memory_order_relaxed);
+            try {
+                submit_batch(batch);
+            } catch (const std::runtime_error&) {
+                // Shutting down: the timers are dropped
+            }
+        });
+    }
+    return *timers_;
+}
+
+TimerHandle ThreadPool::schedule_after(std::chrono::steady_clock::duration delay, Task task) {
+    return schedule_at(std::chrono::steady_clock::now() + delay, std::move(task));
+}
+
+TimerHandle ThreadPool::schedule_at(std::chrono::steady_clock::time_point when, Task task) {
+    return timers().schedule_at(when, std::move(task));
+}
+
+TimerHandle ThreadPool::schedule_every(std::chrono::steady_clock::duration period, Task task) {
+    return timers().schedule_every(period, std::move(task));
+}
+
+bool ThreadPool::cancel_timer(TimerHandle handle) {
+    std::lock_guard<std::mutex> lock(timers_mutex_);
+    return timers_ ? timers_->cancel(handle) : false;
+}
+
+size_t ThreadPool::pending_timers() const {
+    std::lock_guard<std::mutex> lock(timers_mutex_);
+    return timers_ ? timers_->pending() : 0;
+}
+
+size_t ThreadPool::current_worker() const {
+    return tls_pool == this ? tls_worker_index : npos;
+}
+
 void ThreadPool::worker(size_t idx) {
     // std::cout << "Worker " << std::this_thread::get_id() << " is here\n";
+    tls_pool = this;
+    tls_worker_index = idx;
+    detail::bind_task_arena(arenas_[idx].get());
+    IdleState idle;
+    idle.spin_limit = std::max<size_t>(idle_spins_, 1);
+    idle.park_timeout = config::worker::park_backoff_min;
     while(true) {
         Task task;
 
-        if (work_queues_[idx]->try_pop(task)) {
-            {
-                TaskGuard guard(active_tasks_, cv_completion_);
-                execute_task(task);
+        if (find_task(idx, task)) {
+            if (idle.searching) {
+                stop_searching(idle);
             }
+            found_work(idle);
+            run_task(task);
             continue;
         }
+        
+        if (stop_.load(std::memory_order_acquire) && active_tasks_.load(std::memory_order_acquire) == 0) {
+            break;
+        }
 
-        // stealing from other threads
+        if (!idle.searching) {
+            idle.searching = true;
+            searching_.fetch_add(1, std::memory_order_seq_cst);
+        }
+        wait_idle(idx, idle);
+    }
+    if (idle.searching) {
+        searching_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+}
 
-        bool found_work = false;
+// A searching worker found a task. If it was the last one searching and
+// there is more queued work than awake workers, hand the search on to a
+// sleeper so the rest does not wait for the next submit.
+void ThreadPool::stop_searching(IdleState& idle) {
+    idle.searching = false;
+    if (searching_.fetch_sub(1, std::memory_order_seq_cst) != 1) {
+        return;
+    }
+    size_t sleeping = sleeping_.load(std::memory_order_seq_cst);
+    if (sleeping != 0 && active_tasks_.load(std::memory_order_acquire) > thread_count_ - sleeping) {
+        wake_one();
+    }
+}
 
-        for (size_t attempt = 1; attempt <= steal_attempts_; ++attempt) {
-            size_t i = get_next_victim(idx, attempt);
-            stats_.steal_attempts.fetch_add(1, std::memory_order_relaxed);
-            if (work_queues_[i]->try_steal(task)) {
-                found_work = true;
-                stats_.tasks_stolen.fetch_add(1, std::memory_order_relaxed);
-                {
-                    TaskGuard guard(active_tasks_, cv_completion_);
-                    execute_task(task);
-                }
-                break;
-            }
-            stats_.failed_steals.fetch_add(1, std::memory_order_relaxed);
+// A sweep found work: if the worker had not parked yet, spinning paid off
+void ThreadPool::found_work(IdleState& idle) {
+    if (idle.failed_sweeps == 0) {
+        return;
+    }
+    bool parked = idle_strategy_ == config::IdleStrategy::ParkImmediately ||
+                  (idle_strategy_ == config::IdleStrategy::SpinThenPark &&
+                   idle.failed_sweeps > idle.spin_end + idle_yields_);
+    if (!parked) {
+        stats_.spin_hits.fetch_add(1, std::memory_order_relaxed);
+        if (adaptive_spin_) {
+            idle.spin_limit = std::min(idle.spin_limit * 2, std::max<size_t>(idle_spins_, 1));
+        }
+    }
+    idle.failed_sweeps = 0;
+    idle.park_timeout = config::worker::park_backoff_min;
+}
+
+// A sweep found nothing: spin, yield or park according to idle_strategy_
+void ThreadPool::wait_idle(size_t idx, IdleState& idle) {
+    if (idle_strategy_ == config::IdleStrategy::ParkImmediately) {
+        idle.failed_sweeps = 1;
+        park(idx, idle_sleep_);
+        return;
+    }
+    if (++idle.failed_sweeps == 1) {
+        idle.spin_end = idle_strategy_ == config::IdleStrategy::BusySpin ? static_cast<size_t>(-1)
+                                                                        : idle.spin_limit;
+    }
+
+    if (idle.failed_sweeps <= idle.spin_end) {
+        for (unsigned i = 0; i < config::worker::spin_pauses; ++i) cpu_relax();
+        return;
+    }
+    // Spun for the whole budget without finding work: spin less next time
+    if (adaptive_spin_ && idle.failed_sweeps == idle.spin_end + 1) {
+        idle.spin_limit = std::max<size_t>(idle.spin_limit / 2, 1);
+    }
+    if (idle_strategy_ == config::IdleStrategy::SpinThenYield ||
+        idle.failed_sweeps <= idle.spin_end + idle_yields_) {
+        std::this_thread::yield();
+        return;
+    }
+    park(idx, idle.park_timeout);
+    idle.park_timeout = std::min<std::chrono::microseconds>(idle.park_timeout * 2, idle_sleep_);
+}
+
+// Sleep until woken or the timeout passes (steal sources are only polled).
+// Called and returns as a searching worker.
+void ThreadPool::park(size_t idx, std::chrono::microseconds timeout) {
+    stats_.worker_parks.fetch_add(1, std::memory_order_relaxed);
+    Parker& parker = *parkers_[idx];
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        sleepers_.push_back(idx);
+        sleeping_.fetch_add(1, std::memory_order_seq_cst);
+    }
+    searching_.fetch_sub(1, std::memory_order_seq_cst);
+
+    // A submitter that saw us searching skipped its wakeup: look once more
+    if (!has_visible_work(idx) && !stop_.load(std::memory_order_acquire)) {
+        std::unique_lock<std::mutex> lock(parker.mutex);
+        parker.cv.wait_for(lock, timeout, [&]() {
+            return parker.notified || stop_.load(std::memory_order_acquire);
+        });
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        auto it = std::find(sleepers_.begin(), sleepers_.end(), idx);
+        if (it != sleepers_.end()) {
+            // Woke by ourselves: nobody counted us as searching
+            sleepers_.erase(it);
+            sleeping_.fetch_sub(1, std::memory_order_seq_cst);
+            searching_.fetch_add(1, std::memory_order_seq_cst);
+            return;
+        }
+    }
+    // A waker took us off the list and counted us as searching; take its notification
+    std::unique_lock<std::mutex> lock(parker.mutex);
+    parker.cv.wait(lock, [&]() { return parker.notified; });
+    parker.notified = false;
+}
+
+// Wake one sleeping worker as a searcher; the most recently parked one,
+// whose cache is warmest. Returns false if none sleeps.
+bool ThreadPool::wake_one() {
+    size_t idx;
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        if (sleepers_.empty()) {
+            return false;
         }
+        idx = sleepers_.back();
+        sleepers_.pop_back();
+        sleeping_.fetch_sub(1, std::memory_order_seq_cst);
+        searching_.fetch_add(1, std::memory_order_seq_cst);
+    }
+    unpark(idx);
+    return true;
+}
 
-        if (found_work) continue;
+bool ThreadPool::wake_worker(size_t idx) {
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        auto it = std::find(sleepers_.begin(), sleepers_.end(), idx);
+        if (it == sleepers_.end()) {
+            return false;
+        }
+        sleepers_.erase(it);
+        sleeping_.fetch_sub(1, std::memory_order_seq_cst);
+        searching_.fetch_add(1, std::memory_order_seq_cst);
+    }
+    unpark(idx);
+    return true;
+}
 
-        // try global queue
+void ThreadPool::unpark(size_t idx) {
+    Parker& parker = *parkers_[idx];
+    {
+        std::lock_guard<std::mutex> lock(parker.mutex);
+        parker.notified = true;
+    }
+    parker.cv.notify_one();
+    stats_.worker_wakeups.fetch_add(1, std::memory_order_relaxed);
+}
+
+// After publishing `count` tasks: wake sleepers only for work the searching
+// workers cannot be counted on to find. With one task that means waking one
+// sleeper if nobody is searching; while workers search, no syscall at all.
+void ThreadPool::notify_work(size_t count) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    size_t sleeping = sleeping_.load(std::memory_order_seq_cst);
+    size_t searching = searching_.load(std::memory_order_seq_cst);
+    if (sleeping == 0 || count <= searching) {
+        return;
+    }
+    // Bounded by the sleepers seen now: a woken worker that runs out of work
+    // and parks again before this loop ends must not be woken twice
+    size_t wake = std::min(count - searching, sleeping);
+    for (size_t i = 0; i < wake && wake_one(); ++i) {
+    }
+}
+
+// Anything this worker's next sweep would find, ignoring steal sources
+bool ThreadPool::has_visible_work(size_t idx) const {
+    if (pinned_pending_.load(std::memory_order_acquire) != 0 && !pinned_queues_[idx]->empty()) {
+        return true;
+    }
+    for (const auto& queue : work_queues_) {
+        if (!queue->empty()) return true;
+    }
+    return !global_queue_.empty();
+}
+
+// Look for work: pinned tasks, own queue (LIFO), then other workers (FIFO), then the global
+// queue, then any steal sources.
+// idx is npos when called from a thread that is not a worker.
+bool ThreadPool::find_task(size_t idx, Task& task) {
+    // Pinned tasks (resumed fibers) first, oldest first
+    if (idx != npos && pinned_pending_.load(std::memory_order_acquire) != 0 &&
+        pinned_queues_[idx]->try_steal(task)) {
+        pinned_pending_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    if (idx != npos && work_queues_[idx]->try_pop(task)) {
+        return true;
+    }
+
+    // stealing from other threads
+    for (int attempt = 1; attempt <= steal_attempts_; ++attempt) {
+        size_t i = get_next_victim(idx, attempt);
+        stats_.steal_attempts.fetch_add(1, std::memory_order_relaxed);
+        if (work_queues_[i]->try_steal(task)) {
+            stats_.tasks_stolen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        stats_.failed_steals.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // try global queue
+    if (global_queue_.try_steal(task)) {  // Use try_steal (FIFO from global)
+        // std::cout << "Steal from global queue\n";
         stats_.tasks_stolen.fetch_add(1, std::memory_order_relaxed);
-        if (global_queue_.try_steal(task)) {  // Use try_steal (FIFO from global)
-            // std::cout << "Steal from global queue\n";
-            {
-                TaskGuard guard(active_tasks_, cv_completion_);
-                execute_task(task);
+        return true;
+    }
+    stats_.failed_steals.fetch_add(1, std::memory_order_relaxed);
+
+    // Work from outside the pool: it becomes one of our tasks from here on
+    if (auto sources = std::atomic_load(&steal_sources_)) {
+        for (const auto& source : *sources) {
+            if (source(task)) {
+                active_tasks_.fetch_add(1, std::memory_order_release);
+                stats_.external_tasks.fetch_add(1, std::memory_order_relaxed);
+                return true;
             }
-            continue;
         }
-        stats_.failed_steals.fetch_add(1, std::memory_order_relaxed);
-        
-        if (stop_.load(std::memory_order_acquire) && active_tasks_.load(std::memory_order_acquire) == 0) {
-            break;
+    }
+    return false;
+}
+
+void ThreadPool::run_task(Task& task) {
+    {
+        TaskGuard guard(active_tasks_, cv_completion_);
+        execute_task(task);
+    }
+    // A slot under max_pending_tasks_ just freed up: hand it to a parked producer
+    if (max_pending_tasks_ != 0) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (blocked_producers_.load(std::memory_order_relaxed) != 0) {
+            std::lock_guard<std::mutex> lock(space_mutex_);
+            cv_space_.notify_one();
         }
+    }
+}
 
-        std::unique_lock<std::mutex> lock(work_mutex_);
-        cv_work_.wait_for(lock, idle_sleep_, [this]() {
-            return stop_.load(std::memory_order_acquire);
-        });
+// Run one queued task on the calling thread, if any can be found
+bool ThreadPool::run_pending_task() {
+    Task task;
+    if (!find_task(current_worker(), task)) {
+        return false;
+    }
+    run_task(task);
+    return true;
+}
+
+// Push onto the calling worker's own queue, where it is the next task the
+// worker pops and the last one thieves take. Falls back to submit() when
+// the caller is not a worker of this pool.
+void ThreadPool::submit_local(Task task) {
+    size_t idx = current_worker();
+    if (idx == npos) {
+        submit(std::move(task));
+        return;
+    }
+
+    // A worker is running a task, so active_tasks_ > 0 and the pool cannot
+    // finish shutting down underneath us; accept the task even while stopping
+    active_tasks_.fetch_add(1, std::memory_order_release);
+    SubmitGuard guard{active_tasks_};
+
+    if (!work_queues_[idx]->try_push(std::move(task), max_queue_tasks_)) {
+        global_queue_.push(std::move(task));
+    }
+    guard.committed = true;
+    notify_work(1);
+    stats_.tasks_submitted.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool ThreadPool::take_local(Task& task) {
+    size_t idx = current_worker();
+    if (idx == npos || !work_queues_[idx]->try_pop(task)) {
+        return false;
     }
+    TaskGuard guard(active_tasks_, cv_completion_);
+    return true;
 }
 
 // get random thread function
@@ -176,8 +726,10 @@ size_t ThreadPool::get_next_victim(size_t i, size_t attempt) {
     return (i + attempt) % thread_count_;
 }
 
-// Execute task with exception handling
+// Execute task with exception handling. The worker's task arena is reset
+// once the outermost task on this thread returns.
 void ThreadPool::execute_task(Task& task) {
+    size_t outer = detail::enter_task();
     try {
         // std::cout << active_tasks_.load(std::memory_order_relaxed) << "\n";
         task();
@@ -189,6 +741,7 @@ void ThreadPool::execute_task(Task& task) {
         // Optional: 
         // std::cerr << "Task unknown exception\n";
     }
+    detail::leave_task(outer);
 }
 
 void ThreadPool::wait() {
@@ -0,0 +1,268 @@
+// Hierarchical timing wheel
+#include <runtime/timer_wheel.h>
+#include <stdexcept>
+#include <algorithm>
+
+namespace runtime {
+
+TimerWheel::TimerWheel(Dispatch dispatch)
+    : dispatch_(std::move(dispatch)),
+      start_(Clock::now()),
+      heads_(config::timer::levels * slots, nil) {
+    thread_ = std::thread(&TimerWheel::run, this);
+}
+
+TimerWheel::~TimerWheel() noexcept {
+    stop();
+}
+
+void TimerWheel::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_) return;
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    nodes_.clear();
+    free_nodes_.clear();
+    std::fill(heads_.begin(), heads_.end(), nil);
+    count_ = 0;
+}
+
+TimerHandle TimerWheel::schedule_at(Clock::time_point when, Task task) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stop_) {
+        throw std::runtime_error("TimerWheel is stopped");
+    }
+
+    uint32_t index = allocate_node();
+    Node& node = nodes_[index];
+    node.task = std::move(task);
+    node.expires = tick_at_or_after(when);
+    return arm(index);
+}
+
+TimerHandle TimerWheel::schedule_every(Clock::duration period, Task task) {
+    if (period <= Clock::duration::zero()) {
+        throw std::invalid_argument("Timer period must be > 0");
+    }
+    auto tick = std::chrono::duration_cast<Clock::duration>(config::timer::tick);
+    uint64_t period_ticks = std::max<uint64_t>(1, static_cast<uint64_t>((period + tick - Clock::duration(1)) / tick));
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stop_) {
+        throw std::runtime_error("TimerWheel is stopped");
+    }
+
+    uint32_t index = allocate_node();
+    Node& node = nodes_[index];
+    node.repeat = std::make_shared<Task>(std::move(task));
+    node.period = period_ticks;
+    node.expires = tick_at_or_after(Clock::now() + period);
+    return arm(index);
+}
+
+bool TimerWheel::cancel(TimerHandle handle) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!handle.valid() || handle.index >= nodes_.size()) return false;
+
+    Node& node = nodes_[handle.index];
+    if (node.generation != handle.generation || node.bucket == nil) return false;
+
+    unlink(handle.index);
+    release_node(handle.index);
+    return true;
+}
+
+size_t TimerWheel::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return count_;
+}
+
+// Link a filled-in node and wake the timer thread if it now fires earliest.
+// Called with mutex_ held.
+TimerHandle TimerWheel::arm(uint32_t index) {
+    link(index);
+    TimerHandle handle{index, nodes_[index].generation};
+    if (std::max(nodes_[index].expires, current_) < wake_tick_) {
+        cv_.notify_one();
+    }
+    return handle;
+}
+
+void TimerWheel::run() {
+    std::vector<Task> batch;
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (!stop_) {
+        uint64_t now = ticks_elapsed(Clock::now());
+        if (count_ == 0) {
+            current_ = std::max(current_, now + 1);
+        }
+        while (current_ <= now) {
+            advance(batch);
+        }
+
+        if (!batch.empty()) {
+            // Hand the batch over without holding the lock, then look again:
+            // time has moved on while dispatching
+            lock.unlock();
+            dispatch_(batch);
+            batch.clear();
+            lock.lock();
+            continue;
+        }
+
+        if (count_ == 0) {
+            wake_tick_ = UINT64_MAX;
+            cv_.wait(lock);
+        } else {
+            wake_tick_ = next_wake_tick();
+            cv_.wait_until(lock, start_ + config::timer::tick * wake_tick_);
+        }
+        wake_tick_ = 0;
+    }
+}
+
+// Process tick current_: cascade outer levels when level 0 wraps, then
+// expire level 0's slot for this tick
+void TimerWheel::advance(std::vector<Task>& batch) {
+    const uint64_t tick = current_;
+    if ((tick & slot_mask) == 0) {
+        for (unsigned level = 1; level < config::timer::levels; ++level) {
+            uint64_t slot = (tick >> (config::timer::slot_bits * level)) & slot_mask;
+            cascade(level, slot);
+            if (slot != 0) break;
+        }
+    }
+    expire(detach(static_cast<uint32_t>(tick & slot_mask)), batch);
+    current_ = tick + 1;
+}
+
+void TimerWheel::cascade(unsigned level, uint64_t slot) {
+    uint32_t index = detach(static_cast<uint32_t>(level * slots + slot));
+    while (index != nil) {
+        uint32_t next = nodes_[index].next;
+        link(index);
+        index = next;
+    }
+}
+
+void TimerWheel::expire(uint32_t index, std::vector<Task>& batch) {
+    while (index != nil) {
+        Node& node = nodes_[index];
+        uint32_t next = node.next;
+        if (node.period != 0) {
+            batch.emplace_back([repeat = node.repeat]() { (*repeat)(); });
+            // Fixed rate; after a stall, skip missed periods rather than burst
+            node.expires = std::max(node.expires + node.period, current_ + 1);
+            link(index);
+        } else {
+            batch.push_back(std::move(node.task));
+            release_node(index);
+        }
+        index = next;
+    }
+}
+
+// First tick the timer thread has work on: the next occupied level 0 slot
+// in this rotation, or the next rotation (when outer levels cascade)
+uint64_t TimerWheel::next_wake_tick() const {
+    if ((current_ & slot_mask) == 0) return current_;
+    const uint64_t rotation_end = (current_ | slot_mask) + 1;
+    for (uint64_t tick = current_; tick < rotation_end; ++tick) {
+        if (heads_[tick & slot_mask] != nil) return tick;
+    }
+    return rotation_end;
+}
+
+uint32_t TimerWheel::allocate_node() {
+    if (!free_nodes_.empty()) {
+        uint32_t index = free_nodes_.back();
+        free_nodes_.pop_back();
+        return index;
+    }
+    if (nodes_.size() >= nil) {
+        throw std::length_error("Too many pending timers");
+    }
+    nodes_.emplace_back();
+    return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+void TimerWheel::release_node(uint32_t index) {
+    Node& node = nodes_[index];
+    node.task = nullptr;
+    node.repeat.reset();
+    node.period = 0;
+    node.generation++;  // outstanding handles stop matching
+    free_nodes_.push_back(index);
+}
+
+// Put the node in the bucket its deadline falls in, measured from current_
+void TimerWheel::link(uint32_t index) {
+    Node& node = nodes_[index];
+    uint64_t expires = std::max(node.expires, current_);
+    uint64_t delta = expires - current_;
+
+    unsigned level = 0;
+    while (level + 1 < config::timer::levels &&
+           delta >= (uint64_t(1) << (config::timer::slot_bits * (level + 1)))) {
+        ++level;
+    }
+    // Beyond the outermost level: park at its horizon and re-file on cascade
+    const uint64_t horizon = (uint64_t(1) << (config::timer::slot_bits * config::timer::levels)) - 1;
+    uint64_t placed = delta > horizon ? current_ + horizon : expires;
+    uint64_t slot = (placed >> (config::timer::slot_bits * level)) & slot_mask;
+
+    uint32_t bucket = static_cast<uint32_t>(level * slots + slot);
+    node.bucket = bucket;
+    node.prev = nil;
+    node.next = heads_[bucket];
+    if (node.next != nil) nodes_[node.next].prev = index;
+    heads_[bucket] = index;
+    ++count_;
+}
+
+void TimerWheel::unlink(uint32_t index) {
+    Node& node = nodes_[index];
+    if (node.prev != nil) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        heads_[node.bucket] = node.next;
+    }
+    if (node.next != nil) nodes_[node.next].prev = node.prev;
+    node.prev = node.next = node.bucket = nil;
+    --count_;
+}
+
+// Take a whole bucket's list; nodes keep their next links for iteration
+uint32_t TimerWheel::detach(uint32_t bucket) {
+    uint32_t head = heads_[bucket];
+    heads_[bucket] = nil;
+    for (uint32_t index = head; index != nil; index = nodes_[index].next) {
+        nodes_[index].bucket = nil;
+        nodes_[index].prev = nil;
+        --count_;
+    }
+    return head;
+}
+
+uint64_t TimerWheel::tick_at_or_after(Clock::time_point when) const {
+    if (when <= start_) return 0;
+    auto tick = std::chrono::duration_cast<Clock::duration>(config::timer::tick);
+    auto since = when - start_;
+    return static_cast<uint64_t>((since + tick - Clock::duration(1)) / tick);
+}
+
+uint64_t TimerWheel::ticks_elapsed(Clock::time_point now) const {
+    if (now <= start_) return 0;
+    auto tick = std::chrono::duration_cast<Clock::duration>(config::timer::tick);
+    return static_cast<uint64_t>((now - start_) / tick);
+}
+
+} // namespace runtime
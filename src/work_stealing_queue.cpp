@@ -1,10 +1,18 @@
 // Thread-safe Work Stealing Queue implementation
 
 #include <runtime/work_stealing_queue.h>
+#include <runtime/config.h>
 #include <mutex>
 
 namespace runtime {
 
+WorkStealingQueue::WorkStealingQueue(std::pmr::memory_resource* upstream)
+    : blocks_(upstream ? std::make_unique<std::pmr::unsynchronized_pool_resource>(
+                             std::pmr::pool_options{config::queue::upstream_chunk_blocks, 0}, upstream)
+                       : nullptr),
+      deque_(blocks_ ? static_cast<std::pmr::memory_resource*>(blocks_.get())
+                     : std::pmr::new_delete_resource()) {}
+
 bool WorkStealingQueue::empty() const {
     std::lock_guard<std::mutex> lock(mutex_);
     return deque_.empty();
@@ -29,6 +37,25 @@ bool WorkStealingQueue::try_push(Task&& task, size_t max_queue_size) {
     return true;
 }
 
+void WorkStealingQueue::push_batch(Task* tasks, size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (size_t i = 0; i < count; ++i) {
+        deque_.push_back(std::move(tasks[i]));
+    }
+}
+
+size_t WorkStealingQueue::try_push_batch(Task* tasks, size_t count, size_t max_queue_size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    size_t room = deque_.size() >= max_queue_size ? 0 : max_queue_size - deque_.size();
+    size_t pushed = count < room ? count : room;
+    for (size_t i = 0; i < pushed; ++i) {
+        deque_.push_back(std::move(tasks[i]));
+    }
+    return pushed;
+}
+
 bool WorkStealingQueue::try_pop(Task& task) {
     std::lock_guard<std::mutex> lock(mutex_);
 
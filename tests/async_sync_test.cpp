@@ -0,0 +1,233 @@
+#include <runtime/thread_pool.h>
+#include <runtime/async_sync.h>
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <functional>
+#include <stdexcept>
+#include <cassert>
+
+void test_mutex_exclusion() {
+    std::cout << "Test 1: AsyncMutex mutual exclusion\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 4;
+    runtime::ThreadPool pool(options);
+    runtime::AsyncMutex mutex(pool);
+    long long counter = 0;  // protected only by the async mutex
+    std::atomic<int> inside{0};
+    std::atomic<bool> overlapped{false};
+
+    for (int i = 0; i < 10000; ++i) {
+        pool.submit([&]() {
+            mutex.run_locked([&]() {
+                if (inside.fetch_add(1) != 0) overlapped = true;
+                counter++;
+                inside.fetch_sub(1);
+            });
+        });
+    }
+    pool.wait();
+
+    assert(!overlapped.load());
+    assert(counter == 10000);
+    bool locked = mutex.try_lock();
+    assert(locked);
+    mutex.unlock();
+    std::cout << "  ✓ 10000 critical sections, no overlap, no lost updates\n\n";
+}
+
+void test_mutex_does_not_block_workers() {
+    std::cout << "Test 2: Waiting for an AsyncMutex leaves the worker free\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 1;
+    runtime::ThreadPool pool(options);
+    runtime::AsyncMutex mutex(pool);
+    std::vector<int> requested;
+    std::vector<int> order;
+    std::atomic<bool> unrelated_ran{false};
+
+    bool locked = mutex.try_lock();  // held by the test thread
+    assert(locked);
+    for (int i = 0; i < 5; ++i) {
+        pool.submit([&, i]() {
+            requested.push_back(i);  // only one worker: no race
+            mutex.lock([&, i]() {
+                order.push_back(i);
+                mutex.unlock();
+            });
+        });
+    }
+    pool.submit([&]() { unrelated_ran = true; });
+
+    // With a blocking mutex the only worker would now be stuck
+    while (!unrelated_ran.load()) std::this_thread::yield();
+    assert(order.empty());
+
+    mutex.unlock();
+    pool.wait();
+    assert(order.size() == 5);
+    assert(order == requested);
+    std::cout << "  ✓ Single worker kept running other tasks; waiters resumed in FIFO order\n\n";
+}
+
+void test_semaphore_limit() {
+    std::cout << "Test 3: AsyncSemaphore bounds concurrency\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 6;
+    runtime::ThreadPool pool(options);
+    runtime::AsyncSemaphore semaphore(pool, 2);
+    std::atomic<int> inside{0};
+    std::atomic<int> peak{0};
+    std::atomic<int> ran{0};
+
+    for (int i = 0; i < 300; ++i) {
+        pool.submit([&]() {
+            semaphore.acquire([&]() {
+                int now = inside.fetch_add(1) + 1;
+                int seen = peak.load();
+                while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                inside.fetch_sub(1);
+                ran++;
+                semaphore.release();
+            });
+        });
+    }
+    pool.wait();
+
+    assert(ran.load() == 300);
+    assert(peak.load() <= 2);
+    assert(semaphore.available() == 2);
+    bool acquired = semaphore.try_acquire();
+    assert(acquired);
+    assert(semaphore.available() == 1);
+    semaphore.release();
+    std::cout << "  ✓ 300 holders, peak " << peak.load() << " (2 permits), permits restored\n\n";
+}
+
+void test_latch() {
+    std::cout << "Test 4: Latch continuations and helping wait\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 1;
+    runtime::ThreadPool pool(options);
+    std::atomic<int> done{0};
+    std::atomic<int> continuation_runs{0};
+    std::atomic<int> seen_done{-1};
+
+    runtime::Latch latch(pool, 100);
+    latch.async_wait([&]() {
+        seen_done = done.load();
+        continuation_runs++;
+    });
+    // A task waits on the latch that the other tasks count down: on a
+    // single-worker pool this only finishes because wait() helps
+    auto waiter = pool.submit_task([&]() {
+        latch.wait();
+        return done.load();
+    });
+    for (int i = 0; i < 100; ++i) {
+        pool.submit([&]() {
+            done++;
+            latch.count_down();
+        });
+    }
+    int seen = waiter.get();
+    assert(seen == 100);
+    pool.wait();
+
+    bool released = latch.try_wait();
+    assert(released);
+    assert(continuation_runs.load() == 1);
+    assert(seen_done.load() == 100);
+    bool ran_inline = false;
+    latch.async_wait([&]() { ran_inline = true; });
+    assert(ran_inline);
+    bool thrown = false;
+    try {
+        latch.count_down();
+    } catch (const std::logic_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "  ✓ Continuation ran once after all 100 count-downs; no deadlock\n\n";
+}
+
+void test_barrier_phases() {
+    std::cout << "Test 5: Barrier phases and arrive_and_drop\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 4;
+    runtime::ThreadPool pool(options);
+    const int participants = 4;
+    const int phases = 50;
+    std::vector<int> progress(participants, 0);
+    std::atomic<bool> out_of_step{false};
+    std::atomic<int> completions{0};
+
+    runtime::Barrier barrier(pool, participants, [&]() {
+        // Every participant is parked at the barrier: all at the same step
+        int step = progress[0];
+        for (int p = 1; p < participants; ++p) {
+            if (progress[p] != step) out_of_step = true;
+        }
+        completions++;
+    });
+
+    // Each participant is a chain of continuations, one step per phase
+    std::vector<std::function<void()>> steps(participants);
+    for (int p = 0; p < participants; ++p) {
+        steps[p] = [&, p]() {
+            if (progress[p] == phases) return;
+            progress[p]++;
+            barrier.arrive(steps[p]);
+        };
+        pool.submit(steps[p]);
+    }
+    pool.wait();
+
+    assert(!out_of_step.load());
+    assert(completions.load() == phases);
+    assert(barrier.phase() == static_cast<size_t>(phases));
+    for (int p = 0; p < participants; ++p) assert(progress[p] == phases);
+
+    // Two participants left; one arrives, the other drops out
+    runtime::Barrier pair(pool, 2);
+    std::atomic<bool> released{false};
+    pair.arrive([&]() { released = true; });
+    assert(pair.phase() == 0);
+    pair.arrive_and_drop();
+    pool.wait();
+    assert(released.load());
+    assert(pair.phase() == 1);
+
+    // A throwing completion step still releases the phase
+    runtime::Barrier failing(pool, 3, []() { throw std::runtime_error("completion"); });
+    std::atomic<int> continued{0};
+    failing.arrive([&]() { continued++; });
+    failing.arrive([&]() { continued++; });
+    bool thrown = false;
+    try {
+        failing.arrive([&]() { continued++; });
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    pool.wait();
+    assert(thrown);
+    assert(continued.load() == 3);
+    assert(failing.phase() == 1);
+    std::cout << "  ✓ " << phases << " phases in lock-step; dropping out completes a phase\n";
+    std::cout << "  ✓ A throwing completion step still releases every participant\n\n";
+}
+
+int main() {
+    std::cout << "=== Async Synchronisation Tests ===\n\n";
+
+    test_mutex_exclusion();
+    test_mutex_does_not_block_workers();
+    test_semaphore_limit();
+    test_latch();
+    test_barrier_phases();
+
+    std::cout << "All async synchronisation tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include <runtime/thread_pool.h>
+#include <runtime/parallel_for.h>
+#include <runtime/concurrent_hash_map.h>
+#include <runtime/concurrent_vector.h>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <cstdint>
+
+void test_hash_map_basic() {
+    std::cout << "Test 1: ConcurrentHashMap insert, find and update\n";
+    runtime::ConcurrentHashMap<std::string, int> map(4);
+
+    bool inserted = map.insert("a", 1);
+    assert(inserted);
+    inserted = map.insert("a", 2);
+    assert(!inserted);
+    inserted = map.insert_or_assign("b", 3);
+    assert(inserted);
+    inserted = map.insert_or_assign("b", 4);
+    assert(!inserted);
+
+    int value = 0;
+    bool found = map.find("a", value);
+    assert(found && value == 1);
+    found = map.find("b", value);
+    assert(found && value == 4);
+    found = map.find("c", value);
+    assert(!found);
+    assert(map.size() == 2);
+
+    map.insert_or_update("a", 0, [](int& v) { v += 10; });
+    found = map.find("a", value);
+    assert(found && value == 11);
+    std::cout << "  ✓ insert / insert_or_assign / insert_or_update behave as documented\n\n";
+}
+
+void test_hash_map_growth() {
+    std::cout << "Test 2: ConcurrentHashMap segments grow past their initial capacity\n";
+    runtime::ConcurrentHashMap<int, int> map(2);
+    for (int i = 0; i < 100000; ++i) {
+        map.insert(i, i * 2);
+    }
+    assert(map.size() == 100000);
+    for (int i = 0; i < 100000; i += 7) {
+        int value = -1;
+        bool found = map.find(i, value);
+        assert(found && value == i * 2);
+    }
+    std::cout << "  ✓ 100000 keys survive rehashing\n\n";
+}
+
+void test_hash_map_concurrent_group_by() {
+    std::cout << "Test 3: ConcurrentHashMap concurrent group-by inside parallel_for\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 4;
+    runtime::ThreadPool pool(options);
+    runtime::ConcurrentHashMap<int, long long> map;
+
+    const int rows = 200000;
+    const int groups = 1000;
+    runtime::parallel_for(pool, 0, rows, [&](int i) {
+        map.insert_or_update(i % groups, 1, [](long long& count) { count++; });
+    }, 512);
+
+    assert(map.size() == static_cast<size_t>(groups));
+    std::atomic<long long> total{0};
+    std::atomic<int> wrong{0};
+    map.parallel_for_each(pool, [&](const int&, long long& count) {
+        if (count != rows / groups) wrong++;
+        total += count;
+    });
+    assert(wrong == 0);
+    assert(total == rows);
+    std::cout << "  ✓ " << groups << " groups of " << rows / groups << " rows each\n";
+    std::cout << "  ✓ parallel_for_each visits every entry once\n\n";
+}
+
+void test_vector_stable_references() {
+    std::cout << "Test 4: ConcurrentVector keeps references stable while growing\n";
+    runtime::ConcurrentVector<std::string> vec(4);
+
+    size_t first = vec.push_back("first");
+    std::string* address = &vec[first];
+    for (int i = 0; i < 10000; ++i) {
+        vec.push_back(std::to_string(i));
+    }
+    size_t block = vec.grow_by(5, "x");
+
+    assert(first == 0);
+    assert(&vec[0] == address && *address == "first");
+    assert(vec.size() == 10006);
+    assert(block == 10001 && vec[10005] == "x");
+    assert(vec[1] == "0" && vec[10000] == "9999");
+
+    // Segments honour over-aligned element types
+    struct alignas(128) Padded {
+        int value;
+    };
+    runtime::ConcurrentVector<Padded> padded(2);
+    for (int i = 0; i < 100; ++i) padded.push_back(Padded{i});
+    for (size_t i = 0; i < padded.size(); ++i) {
+        assert(reinterpret_cast<uintptr_t>(&padded[i]) % alignof(Padded) == 0);
+        assert(padded[i].value == static_cast<int>(i));
+    }
+    std::cout << "  ✓ Element 0 did not move across 10000 appends\n";
+    std::cout << "  ✓ grow_by returns the first index of its block\n";
+    std::cout << "  ✓ Over-aligned elements stay aligned\n\n";
+}
+
+void test_vector_concurrent_push_back() {
+    std::cout << "Test 5: ConcurrentVector concurrent push_back from tasks\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 4;
+    runtime::ThreadPool pool(options);
+    runtime::ConcurrentVector<int> vec(16);
+
+    const int n = 100000;
+    runtime::parallel_for(pool, 0, n, [&](int i) {
+        vec.push_back(i);
+    }, 256);
+
+    assert(vec.size() == static_cast<size_t>(n));
+    std::unique_ptr<std::atomic<int>[]> seen(new std::atomic<int>[n]);
+    for (int i = 0; i < n; ++i) seen[i] = 0;
+    vec.parallel_for_each(pool, [&](int value) { seen[value]++; });
+    for (int i = 0; i < n; ++i) {
+        assert(seen[i] == 1);
+    }
+
+    std::atomic<long long> sum{0};
+    runtime::parallel_for(pool, vec.range(4096), [&](const runtime::blocked_range<size_t>& r) {
+        long long partial = 0;
+        vec.for_each_in(r.begin(), r.end(), [&](int value) { partial += value; });
+        sum += partial;
+    });
+    assert(sum == static_cast<long long>(n) * (n - 1) / 2);
+    std::cout << "  ✓ All " << n << " values appended exactly once\n";
+    std::cout << "  ✓ Segment-wise iteration sees every element\n\n";
+}
+
+int main() {
+    std::cout << "=== Concurrent Container Tests ===\n\n";
+
+    test_hash_map_basic();
+    test_hash_map_growth();
+    test_hash_map_concurrent_group_by();
+    test_vector_stable_references();
+    test_vector_concurrent_push_back();
+
+    std::cout << "All concurrent container tests passed!\n";
+    return 0;
+}
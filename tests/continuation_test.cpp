@@ -0,0 +1,188 @@
+#include <runtime/thread_pool.h>
+#include <runtime/continuation.h>
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <functional>
+#include <chrono>
+#include <stdexcept>
+#include <cassert>
+
+long long fib_serial(int n) {
+    return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+long long fib(runtime::ThreadPool& pool, int n) {
+    if (n < 2) return n;
+    long long a = 0, b = 0;
+    runtime::continuation_fork_join(pool,
+        [&]() { a = fib(pool, n - 1); },
+        [&]() { b = fib(pool, n - 2); });
+    return a + b;
+}
+
+void test_fib() {
+    std::cout << "Test 1: Recursive fib with continuation stealing\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 4;
+    runtime::ThreadPool pool(options);
+
+    long long value = runtime::spawn_root(pool, [&]() { return fib(pool, 22); });
+    assert(value == fib_serial(22));
+    // One spawn per call with n >= 2
+    uint64_t spawns = pool.stats().spawns.load();
+    assert(spawns == static_cast<uint64_t>(fib_serial(23) - 1));
+    // Stacks are recycled: bounded by depth per worker (plus each worker's
+    // cache), not by the 28k spawns
+    uint64_t stacks = pool.stats().fiber_stacks_mapped.load();
+    assert(stacks <= 4 * (22 + runtime::config::fiber::stack_cache));
+    std::cout << "  ✓ fib(22) = " << value << " in " << spawns << " spawns, "
+              << stacks << " stacks mapped, "
+              << pool.stats().continuations_stolen.load() << " continuations stolen\n\n";
+}
+
+void test_spawn_loop() {
+    std::cout << "Test 2: A loop of spawns keeps one continuation queued\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 4;
+    runtime::ThreadPool pool(options);
+
+    const int children = 20000;
+    std::vector<int> out(children, 0);
+    runtime::spawn_root(pool, [&]() {
+        runtime::SpawnScope scope(pool);
+        for (int i = 0; i < children; ++i) {
+            scope.spawn([&out, i]() { out[i] = i * 2; });
+        }
+        scope.sync();
+    });
+    for (int i = 0; i < children; ++i) {
+        assert(out[i] == i * 2);
+    }
+    // Each child takes its parent back off the queue as it returns, and
+    // its stack goes back to the cache for the next one
+    assert(pool.stats().fiber_stacks_mapped.load() <= 4 * (2 + runtime::config::fiber::stack_cache));
+    std::cout << "  ✓ " << children << " children, "
+              << pool.stats().fiber_stacks_mapped.load() << " stacks mapped\n\n";
+}
+
+void test_stolen_continuations() {
+    std::cout << "Test 3: Stolen parents wait in sync for children on other workers\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 4;
+    runtime::ThreadPool pool(options);
+
+    std::atomic<int> finished{0};
+    std::atomic<bool> moved{false};
+    runtime::spawn_root(pool, [&]() {
+        size_t started_on = pool.current_worker();
+        runtime::SpawnScope scope(pool);
+        for (int i = 0; i < 40; ++i) {
+            // Sleeping children leave the CPU to thieves
+            scope.spawn([&finished]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                finished++;
+            });
+        }
+        scope.sync();
+        assert(finished.load() == 40);
+        if (pool.current_worker() != started_on) moved = true;
+    });
+    assert(finished.load() == 40);
+    assert(pool.stats().continuations_stolen.load() > 0);
+    pool.wait();
+    std::cout << "  ✓ 40 children joined; " << pool.stats().continuations_stolen.load()
+              << " continuations stolen" << (moved.load() ? ", parent moved workers" : "") << "\n\n";
+}
+
+void test_exceptions() {
+    std::cout << "Test 4: Exceptions reach sync; misuse is rejected\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 2;
+    runtime::ThreadPool pool(options);
+
+    bool left_thrown = false;
+    try {
+        runtime::continuation_fork_join(pool,
+            []() { throw std::runtime_error("left"); },
+            []() {});
+    } catch (const std::runtime_error& e) {
+        left_thrown = std::string(e.what()) == "left";
+    }
+    assert(left_thrown);
+
+    bool right_thrown = false;
+    try {
+        runtime::continuation_fork_join(pool,
+            []() {},
+            []() { throw std::runtime_error("right"); });
+    } catch (const std::runtime_error& e) {
+        right_thrown = std::string(e.what()) == "right";
+    }
+    assert(right_thrown);
+
+    // The scope is still usable after a failed sync
+    int ran = runtime::spawn_root(pool, [&]() {
+        runtime::SpawnScope scope(pool);
+        scope.spawn([]() { throw std::logic_error("child"); });
+        bool thrown = false;
+        try {
+            scope.sync();
+        } catch (const std::logic_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+        int value = 0;
+        scope.spawn([&value]() { value = 7; });
+        scope.sync();
+        return value;
+    });
+    assert(ran == 7);
+
+    bool rejected = false;
+    try {
+        runtime::SpawnScope scope(pool);  // not on a spawn fiber
+    } catch (const std::logic_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+    std::cout << "  ✓ Left, right and child exceptions rethrown; SpawnScope outside a spawn fiber rejected\n\n";
+}
+
+void test_deep_recursion() {
+    std::cout << "Test 5: Deep spawn chains need one stack per level\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 2;
+    options.fiber_stack_size = 32 * 1024;
+    runtime::ThreadPool pool(options);
+
+    std::function<int(int)> depth = [&](int n) -> int {
+        if (n == 0) return 0;
+        int below = 0;
+        runtime::SpawnScope scope(pool);
+        scope.spawn([&]() { below = depth(n - 1); });
+        scope.sync();
+        return below + 1;
+    };
+    int deepest = runtime::spawn_root(pool, [&]() { return depth(300); });
+    assert(deepest == 300);
+    // 301 spawn fibers live at the deepest point; the rest is per-worker caching
+    uint64_t stacks = pool.stats().fiber_stacks_mapped.load();
+    assert(stacks <= 301 + 2 * runtime::config::fiber::stack_cache);
+    std::cout << "  ✓ 300 nested spawns, " << stacks << " stacks mapped\n\n";
+}
+
+int main() {
+    std::cout << "=== Continuation Stealing Tests ===\n\n";
+
+    test_fib();
+    test_spawn_loop();
+    test_stolen_continuations();
+    test_exceptions();
+    test_deep_recursion();
+
+    std::cout << "All continuation stealing tests passed!\n";
+    return 0;
+}
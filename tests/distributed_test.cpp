@@ -0,0 +1,247 @@
+#include <runtime/distributed.h>
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <set>
+#include <map>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <cassert>
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+
+struct Square {
+    long long value;
+    int pid;
+};
+
+// A node in a child process: reports its port through report_fd, then serves
+// until the parent closes control_fd
+struct ChildNode {
+    pid_t pid;
+    uint16_t port;
+    int control_fd;
+};
+
+ChildNode fork_node(const std::function<void(runtime::DistributedRegistry&)>& register_tasks) {
+    int report[2];
+    int control[2];
+    int piped = pipe(report);
+    piped |= pipe(control);
+    assert(piped == 0);
+    pid_t child = fork();
+    if (child == 0) {
+        close(report[0]);
+        close(control[1]);
+        runtime::DistributedRegistry registry;
+        register_tasks(registry);
+        runtime::config::NodeOptions options;
+        options.pool.threads = 1;
+        runtime::DistributedNode node(registry, options);
+        uint16_t port = node.port();
+        (void)!write(report[1], &port, sizeof(port));
+        char byte;
+        while (read(control[0], &byte, 1) > 0) {
+        }
+        _exit(0);  // skip the node's shutdown: the parent may be gone already
+    }
+    close(report[1]);
+    close(control[0]);
+    uint16_t port = 0;
+    ssize_t got = read(report[0], &port, sizeof(port));
+    assert(got == sizeof(port));
+    close(report[0]);
+    return ChildNode{child, port, control[1]};
+}
+
+void register_square(runtime::DistributedRegistry& registry) {
+    registry.add<Square, int>(1, [](int x) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        return Square{static_cast<long long>(x) * x, static_cast<int>(getpid())};
+    });
+}
+
+void test_processes_share_a_job() {
+    std::cout << "Test 1: Three processes on localhost share one job\n";
+    std::vector<ChildNode> children;
+    for (int i = 0; i < 2; ++i) {
+        children.push_back(fork_node(register_square));
+    }
+
+    runtime::DistributedRegistry registry;
+    register_square(registry);
+    runtime::config::NodeOptions options;
+    options.pool.threads = 1;
+    runtime::DistributedNode node(registry, options);
+    for (const auto& child : children) {
+        node.connect("127.0.0.1", child.port);
+    }
+    assert(node.peers() == 2);
+
+    const int tasks = 300;
+    std::vector<std::future<Square>> futures;
+    for (int i = 0; i < tasks; ++i) {
+        futures.push_back(node.submit<Square>(1, i));
+    }
+    std::map<int, int> per_process;
+    for (int i = 0; i < tasks; ++i) {
+        Square result = futures[i].get();
+        assert(result.value == static_cast<long long>(i) * i);
+        per_process[result.pid]++;
+    }
+    node.wait();
+
+    assert(per_process.size() >= 2);
+    assert(node.stats().tasks_given.load() > 0);
+    assert(node.stats().tasks_given.load() + node.stats().tasks_run.load() == tasks);
+
+    // Later children inherited the earlier ones' control pipes: close all first
+    for (const auto& child : children) {
+        close(child.control_fd);
+    }
+    for (const auto& child : children) {
+        int status = 0;
+        waitpid(child.pid, &status, 0);
+        assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+    std::cout << "  ✓ " << tasks << " results correct; tasks per process:";
+    for (const auto& entry : per_process) std::cout << " " << entry.second;
+    std::cout << "\n\n";
+}
+
+void test_dead_thief() {
+    std::cout << "Test 2: Tasks held by a thief that dies run on their origin\n";
+    int started[2];
+    int piped = pipe(started);
+    assert(piped == 0);
+    // The child's version of task 2 announces itself and hangs
+    ChildNode child = fork_node([&](runtime::DistributedRegistry& registry) {
+        close(started[0]);
+        registry.add<int, int>(2, [&](int) -> int {
+            (void)!write(started[1], "s", 1);
+            pause();
+            return 0;
+        });
+    });
+    close(started[1]);
+
+    runtime::DistributedRegistry registry;
+    registry.add<int, int>(2, [](int x) { return x + 1; });
+    runtime::config::NodeOptions options;
+    options.pool.threads = 1;
+    runtime::DistributedNode node(registry, options);
+
+    // Keep our only worker busy so the child gets to steal
+    std::atomic<bool> release{false};
+    node.pool().submit([&]() {
+        while (!release.load()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 20; ++i) {
+        futures.push_back(node.submit<int>(2, i));
+    }
+    node.connect("127.0.0.1", child.port);
+
+    char byte;
+    ssize_t got = read(started[0], &byte, 1);
+    assert(got == 1);
+    close(started[0]);
+    kill(child.pid, SIGKILL);
+    waitpid(child.pid, nullptr, 0);
+    close(child.control_fd);
+    release = true;
+
+    for (int i = 0; i < 20; ++i) {
+        int value = futures[i].get();
+        assert(value == i + 1);
+    }
+    assert(node.stats().tasks_given.load() > 0);
+    assert(node.stats().tasks_requeued.load() == node.stats().tasks_given.load());
+    assert(node.peers() == 0);
+    std::cout << "  ✓ " << node.stats().tasks_requeued.load() << " stolen tasks requeued, all 20 completed\n\n";
+}
+
+struct Range {
+    int begin;
+    int end;
+};
+
+void test_results_and_errors() {
+    std::cout << "Test 3: Typed, void and byte results; errors come back as RemoteTaskError\n";
+    std::atomic<int> touched{0};
+    runtime::DistributedRegistry registry;
+    registry.add<long long, Range>(1, [](Range r) {
+        long long sum = 0;
+        for (int i = r.begin; i < r.end; ++i) sum += i;
+        return sum;
+    });
+    registry.add<void, int>(2, [&](int n) { touched += n; });
+    registry.add(3, [](const std::string& payload) {
+        return std::string(payload.rbegin(), payload.rend());
+    });
+    registry.add<int, int>(4, [](int) -> int { throw std::runtime_error("negative input"); });
+
+    bool thrown = false;
+    try {
+        registry.add(3, [](const std::string& payload) { return payload; });
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // Two nodes in this process, linked over loopback
+    runtime::config::NodeOptions options;
+    options.pool.threads = 2;
+    runtime::DistributedNode a(registry, options);
+    runtime::DistributedNode b(registry, options);
+    b.connect("127.0.0.1", a.port());
+    while (a.peers() == 0) std::this_thread::yield();
+
+    std::vector<std::future<long long>> sums;
+    for (int i = 0; i < 100; ++i) {
+        sums.push_back(a.submit<long long>(1, Range{0, i}));
+    }
+    auto nothing = a.submit<void>(2, 5);
+    auto reversed = a.submit_bytes(3, "stealing");
+    auto failing = a.submit<int>(4, -1);
+    auto unknown = a.submit<int>(99, 0);
+
+    for (int i = 0; i < 100; ++i) {
+        long long sum = sums[i].get();
+        assert(sum == static_cast<long long>(i) * (i - 1) / 2);
+    }
+    nothing.get();
+    assert(touched.load() == 5);
+    std::string text = reversed.get();
+    assert(text == "gnilaets");
+    try {
+        failing.get();
+        assert(false);
+    } catch (const runtime::RemoteTaskError& e) {
+        assert(std::string(e.what()) == "negative input");
+    }
+    try {
+        unknown.get();
+        assert(false);
+    } catch (const runtime::RemoteTaskError&) {
+    }
+    a.wait();
+    assert(a.stats().tasks_submitted.load() == 104);
+    std::cout << "  ✓ 104 tasks; " << a.stats().tasks_given.load() << " ran on the other node\n\n";
+}
+
+int main() {
+    std::cout << "=== Distributed Tests ===\n\n";
+
+    // These fork: run them while this process has no other threads
+    test_processes_share_a_job();
+    test_dead_thief();
+    test_results_and_errors();
+
+    std::cout << "All distributed tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,225 @@
+#include <runtime/thread_pool.h>
+#include <runtime/executor.h>
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <cassert>
+
+void test_serial_order_and_exclusion() {
+    std::cout << "Test 1: SerialExecutor runs tasks one at a time, in order\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 4;
+    runtime::ThreadPool pool(options);
+    std::vector<int> order;       // deliberately unsynchronised
+    std::atomic<int> inside{0};
+    std::atomic<bool> overlapped{false};
+
+    {
+        runtime::SerialExecutor strand(pool);
+        for (int i = 0; i < 20000; ++i) {
+            strand.submit([&, i]() {
+                if (inside.fetch_add(1) != 0) overlapped = true;
+                order.push_back(i);
+                inside.fetch_sub(1);
+            });
+        }
+        strand.wait();
+        assert(strand.pending() == 0);
+    }
+
+    assert(!overlapped.load());
+    assert(order.size() == 20000);
+    for (int i = 0; i < 20000; ++i) assert(order[i] == i);
+    std::cout << "  ✓ 20000 tasks, no overlap, submission order kept\n\n";
+}
+
+void test_serial_many_producers() {
+    std::cout << "Test 2: Strand with concurrent producers\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 4;
+    runtime::ThreadPool pool(options);
+    runtime::SerialExecutor strand(pool);
+    long long counter = 0;  // protected only by the strand
+    std::vector<std::vector<int>> seen(4);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 4; ++p) {
+        producers.emplace_back([&, p]() {
+            for (int i = 0; i < 5000; ++i) {
+                strand.submit([&, p, i]() {
+                    counter++;
+                    seen[p].push_back(i);
+                });
+            }
+        });
+    }
+    for (auto& t : producers) t.join();
+    strand.wait();
+
+    assert(counter == 20000);
+    for (const auto& s : seen) {
+        assert(s.size() == 5000);
+        for (int i = 0; i < 5000; ++i) assert(s[i] == i);
+    }
+    std::cout << "  ✓ No lost updates; each producer's tasks ran in its order\n\n";
+}
+
+void test_limited_concurrency() {
+    std::cout << "Test 3: LimitedExecutor never exceeds its limit\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 6;
+    runtime::ThreadPool pool(options);
+    std::atomic<int> inside{0};
+    std::atomic<int> peak{0};
+    std::atomic<int> ran{0};
+
+    runtime::LimitedExecutor limited(pool, 3);
+    assert(limited.max_concurrency() == 3);
+    for (int i = 0; i < 600; ++i) {
+        limited.submit([&]() {
+            int now = inside.fetch_add(1) + 1;
+            int seen = peak.load();
+            while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            inside.fetch_sub(1);
+            ran++;
+        });
+    }
+    limited.wait();
+
+    assert(ran.load() == 600);
+    assert(peak.load() <= 3);
+    std::cout << "  ✓ 600 tasks ran, peak concurrency " << peak.load() << " (limit 3)\n\n";
+}
+
+void test_submit_task_and_exceptions() {
+    std::cout << "Test 4: submit_task futures and throwing tasks\n";
+    runtime::ThreadPool pool;
+    runtime::SerialExecutor strand(pool);
+
+    auto value = strand.submit_task([](int a, int b) { return a * b; }, 6, 7);
+    auto failing = strand.submit_task([]() -> int { throw std::runtime_error("boom"); });
+    strand.submit([]() { throw std::logic_error("swallowed"); });
+    auto after = strand.submit_task([]() { return 1; });
+
+    int product = value.get();
+    assert(product == 42);
+    bool thrown = false;
+    try {
+        failing.get();
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    int later = after.get();
+    assert(later == 1);
+    std::cout << "  ✓ Results and exceptions reach futures; strand keeps running\n\n";
+}
+
+void test_many_strands_and_destructor() {
+    std::cout << "Test 5: Many strands on one pool; destructor waits\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 4;
+    runtime::ThreadPool pool(options);
+    const int strands = 200;
+    std::vector<long long> counters(strands, 0);
+    std::atomic<int> finished{0};
+
+    {
+        std::vector<std::unique_ptr<runtime::SerialExecutor>> executors;
+        for (int s = 0; s < strands; ++s) {
+            executors.push_back(std::make_unique<runtime::SerialExecutor>(pool));
+        }
+        for (int i = 0; i < 100; ++i) {
+            for (int s = 0; s < strands; ++s) {
+                executors[s]->submit([&counters, &finished, s]() {
+                    counters[s]++;
+                    finished++;
+                });
+            }
+        }
+        // Destructors wait for their outstanding tasks
+    }
+
+    assert(finished.load() == strands * 100);
+    for (long long c : counters) assert(c == 100);
+    std::cout << "  ✓ 200 strands x 100 tasks, each strand's counter exact\n\n";
+}
+
+void test_nested_wait_inside_task() {
+    std::cout << "Test 6: Waiting on an executor from inside a pool task\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 1;
+    runtime::ThreadPool pool(options);
+    runtime::LimitedExecutor limited(pool, 2);
+    std::atomic<int> ran{0};
+
+    pool.submit_task([&]() {
+        for (int i = 0; i < 50; ++i) {
+            limited.submit([&ran]() { ran++; });
+        }
+        limited.wait();  // helps run pool work instead of deadlocking the only worker
+    }).get();
+
+    assert(ran.load() == 50);
+    std::cout << "  ✓ Single-worker pool does not deadlock\n\n";
+}
+
+void test_runner_requeue_on_full_pool() {
+    std::cout << "Test 7: A runner requeued on a full pool is not dropped\n";
+    std::atomic<int> dropped{0};
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 1;
+    options.max_pending_tasks = 2;
+    options.submit_timeout = std::chrono::milliseconds(0);
+    options.rejection_handler = [&dropped](runtime::Task) { dropped++; };
+    runtime::ThreadPool pool(options);
+
+    // Hold the only worker, so wait() below runs the runner on this thread
+    // and its requeue finds the pool full
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+    pool.submit([&started, &release]() {
+        started = true;
+        while (!release.load()) std::this_thread::yield();
+    });
+    while (!started.load()) std::this_thread::yield();
+    std::thread releaser([&release]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        release = true;
+    });
+
+    std::atomic<int> ran{0};
+    const int tasks = 3 * static_cast<int>(runtime::config::executor::runner_batch);
+    {
+        runtime::SerialExecutor strand(pool);
+        for (int i = 0; i < tasks; ++i) {
+            strand.submit([&ran]() { ran++; });
+        }
+        strand.wait();
+    }
+    releaser.join();
+
+    assert(ran.load() == tasks);
+    assert(dropped.load() == 0);
+    std::cout << "  ✓ " << tasks << " tasks ran; the rejection handler saw no runner\n\n";
+}
+
+int main() {
+    std::cout << "=== Executor Tests ===\n\n";
+
+    test_serial_order_and_exclusion();
+    test_serial_many_producers();
+    test_limited_concurrency();
+    test_submit_task_and_exceptions();
+    test_many_strands_and_destructor();
+    test_nested_wait_inside_task();
+    test_runner_requeue_on_full_pool();
+
+    std::cout << "All executor tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,757 @@
+#include <runtime/thread_pool.h>
+#include <runtime/parallel_for.h>
+#include <runtime/blocked_range.h>
+#include <runtime/parallel_reduce.h>
+#include <runtime/partitioner.h>
+#include <runtime/fork_join.h>
+#include <runtime/parallel_histogram.h>
+#include <runtime/parallel_sort.h>
+#include <runtime/parallel_for_each.h>
+#include <runtime/execution.h>
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <list>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <thread>
+#include <chrono>
+
+void test_blocked_range_split() {
+    std::cout << "Test 1: blocked_range splitting\n";
+    runtime::blocked_range<int> r(0, 100, 10);
+    assert(r.is_divisible());
+
+    runtime::blocked_range<int> upper = r.split();
+    assert(r.begin() == 0 && r.end() == 50);
+    assert(upper.begin() == 50 && upper.end() == 100);
+
+    runtime::blocked_range<int> small(0, 10, 10);
+    assert(!small.is_divisible());
+    std::cout << "  ✓ Halves cover the range and grain stops splitting\n\n";
+}
+
+void test_blocked_range2d_longest_dimension() {
+    std::cout << "Test 2: blocked_range2d splits its longest dimension\n";
+    runtime::blocked_range2d<size_t> r(0, 1000, 10, 0, 100, 10);
+
+    runtime::blocked_range2d<size_t> upper = r.split();
+    assert(r.rows().end() == 500 && upper.rows().begin() == 500);
+    assert(r.cols().size() == 100 && upper.cols().size() == 100);
+
+    runtime::blocked_range2d<size_t> wide(0, 100, 10, 0, 1000, 10);
+    runtime::blocked_range2d<size_t> right = wide.split();
+    assert(wide.cols().end() == 500 && right.cols().begin() == 500);
+    assert(wide.rows().size() == 100);
+    std::cout << "  ✓ Rows split when tall, columns split when wide\n\n";
+}
+
+void test_parallel_for_2d_tiles() {
+    std::cout << "Test 3: parallel_for over blocked_range2d visits every cell once\n";
+    runtime::ThreadPool pool;
+    const size_t rows = 257, cols = 129;
+    std::vector<std::atomic<int>> visits(rows * cols);
+    std::atomic<int> oversized{0};
+    std::atomic<int> tiles{0};
+
+    runtime::parallel_for(pool, runtime::blocked_range2d<size_t>(0, rows, 16, 0, cols, 32),
+        [&](const runtime::blocked_range2d<size_t>& tile) {
+            if (tile.rows().size() > 16 || tile.cols().size() > 32) oversized++;
+            tiles++;
+            for (size_t i = tile.rows().begin(); i < tile.rows().end(); ++i) {
+                for (size_t j = tile.cols().begin(); j < tile.cols().end(); ++j) {
+                    visits[i * cols + j]++;
+                }
+            }
+        });
+
+    for (auto& v : visits) {
+        assert(v == 1);
+    }
+    assert(oversized == 0);
+    // Tiles are walked inside a bounded number of tasks, not one task each
+    uint64_t tasks = pool.stats().tasks_submitted.load();
+    assert(tasks <= pool.thread_count() * 2 * runtime::config::parallel_alg::range_tasks_per_thread);
+    assert(tasks < static_cast<uint64_t>(tiles.load()));
+    std::cout << "  ✓ All " << rows * cols << " cells visited exactly once\n";
+    std::cout << "  ✓ No tile exceeds its grain sizes; " << tiles.load() << " tiles in "
+              << tasks << " tasks\n\n";
+}
+
+void test_parallel_for_3d_tiles() {
+    std::cout << "Test 4: parallel_for over blocked_range3d visits every cell once\n";
+    runtime::ThreadPool pool;
+    const int n = 33;
+    std::vector<std::atomic<int>> visits(n * n * n);
+
+    runtime::parallel_for(pool, runtime::blocked_range3d<int>(0, n, 4, 0, n, 8, 0, n, 16),
+        [&](const runtime::blocked_range3d<int>& tile) {
+            for (int p = tile.pages().begin(); p < tile.pages().end(); ++p) {
+                for (int i = tile.rows().begin(); i < tile.rows().end(); ++i) {
+                    for (int j = tile.cols().begin(); j < tile.cols().end(); ++j) {
+                        visits[(p * n + i) * n + j]++;
+                    }
+                }
+            }
+        });
+
+    for (auto& v : visits) {
+        assert(v == 1);
+    }
+    std::cout << "  ✓ All " << n * n * n << " cells visited exactly once\n\n";
+}
+
+void test_parallel_for_chunked_alignment() {
+    std::cout << "Test 5: parallel_for_chunked aligns chunks to cache lines\n";
+    runtime::ThreadPool pool;
+    std::vector<double> data(100003);
+    std::atomic<int> misaligned{0};
+    std::atomic<size_t> covered{0};
+
+    // Start at index 3 so the first chunk is the only unaligned one
+    runtime::parallel_for_chunked(pool, size_t(3), data.size(), [&](size_t first, size_t last) {
+        if (first != 3 && reinterpret_cast<std::uintptr_t>(&data[first]) % 64 != 0) misaligned++;
+        for (size_t i = first; i < last; ++i) {
+            data[i] += 1.0;
+        }
+        covered += last - first;
+    }, 1000, runtime::align_chunks_to(data.data()));
+
+    assert(misaligned == 0);
+    assert(covered == data.size() - 3);
+    for (size_t i = 3; i < data.size(); ++i) {
+        assert(data[i] == 1.0);
+    }
+    std::cout << "  ✓ Every chunk after the first starts on a 64-byte boundary\n";
+    std::cout << "  ✓ Chunks cover the range exactly once\n\n";
+}
+
+void test_parallel_reduce_chunked() {
+    std::cout << "Test 6: parallel_reduce_chunked matches serial sum\n";
+    runtime::ThreadPool pool;
+    long long sum = runtime::parallel_reduce_chunked(pool, 0, 1000000, 0LL,
+        [](int first, int last) {
+            long long partial = 0;
+            for (int i = first; i < last; ++i) partial += i;
+            return partial;
+        },
+        std::plus<long long>(), 4096);
+
+    assert(sum == 999999LL * 1000000LL / 2);
+    std::cout << "  ✓ Sum of 0..999999 is correct\n\n";
+}
+
+void test_affinity_partitioner_replay() {
+    std::cout << "Test 7: affinity_partitioner records and replays chunk placement\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 4;
+    runtime::ThreadPool pool(options);
+    runtime::affinity_partitioner ap;
+    std::vector<int> data(10000, 0);
+
+    for (int iteration = 0; iteration < 5; ++iteration) {
+        runtime::parallel_for(pool, size_t(0), data.size(), [&](size_t i) {
+            data[i]++;
+        }, ap, 500);
+    }
+
+    for (int v : data) {
+        assert(v == 5);
+    }
+    assert(ap.chunk_count() == 20);
+    for (size_t chunk = 0; chunk < ap.chunk_count(); ++chunk) {
+        assert(ap.preferred_worker(chunk) < pool.thread_count());
+    }
+    std::cout << "  ✓ Every index visited once per call\n";
+    std::cout << "  ✓ Every chunk maps to a valid worker\n\n";
+}
+
+void test_affinity_partitioner_single_worker_hits() {
+    std::cout << "Test 8: affinity_partitioner hits on a one-worker pool\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 1;
+    runtime::ThreadPool pool(options);
+    runtime::affinity_partitioner ap;
+    std::atomic<int> count{0};
+
+    runtime::parallel_for(pool, 0, 4096, [&](int) { count++; }, ap, 256);
+    runtime::parallel_for(pool, 0, 4096, [&](int) { count++; }, ap, 256);
+
+    assert(count == 8192);
+    assert(ap.last_hits() == ap.chunk_count());
+    std::cout << "  ✓ All " << ap.chunk_count() << " chunks replayed on their recorded worker\n\n";
+}
+
+void test_parallel_for_schedules() {
+    std::cout << "Test 9: parallel_for schedules cover the range exactly once\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 4;
+    runtime::ThreadPool pool(options);
+
+    const std::vector<runtime::Schedule> schedules = {
+        runtime::Schedule::Static(),
+        runtime::Schedule::Dynamic(7),
+        runtime::Schedule::Guided(3),
+        runtime::Schedule::Auto(),
+    };
+
+    for (const auto& schedule : schedules) {
+        std::vector<std::atomic<int>> visits(10007);
+        runtime::parallel_for(pool, 0, 10007, [&](int i) { visits[i]++; }, schedule);
+        for (auto& v : visits) {
+            assert(v == 1);
+        }
+    }
+
+    // Fewer iterations than workers, and a non-zero start
+    std::vector<std::atomic<int>> few(3);
+    runtime::parallel_for(pool, 100, 103, [&](int i) { few[i - 100]++; }, runtime::Schedule::Static());
+    for (auto& v : few) {
+        assert(v == 1);
+    }
+    std::cout << "  ✓ Static, Dynamic, Guided and Auto each visit every index once\n\n";
+}
+
+void test_static_schedule_one_block_per_worker() {
+    std::cout << "Test 10: Static schedule submits one task per worker\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 3;
+    runtime::ThreadPool pool(options);
+    uint64_t before = pool.stats().tasks_submitted.load();
+
+    std::atomic<int> count{0};
+    runtime::parallel_for(pool, 0, 100000, [&](int) { count++; }, runtime::Schedule::Static());
+
+    assert(count == 100000);
+    assert(pool.stats().tasks_submitted.load() - before == 3);
+    std::cout << "  ✓ 3 tasks for 3 workers, 100000 iterations\n\n";
+}
+
+void test_auto_chunk() {
+    std::cout << "Test 11: auto_chunk parallel_for and parallel_reduce\n";
+    runtime::ThreadPool pool;
+    std::vector<std::atomic<int>> visits(200003);
+
+    auto body = [&](int i) { visits[i]++; };
+    for (int round = 0; round < 3; ++round) {
+        runtime::parallel_for(pool, 0, 200003, body, runtime::config::parallel_alg::auto_chunk);
+    }
+    for (auto& v : visits) {
+        assert(v == 3);
+    }
+
+    long long sum = 0;
+    for (int round = 0; round < 3; ++round) {
+        sum = runtime::parallel_reduce(pool, 1, 100001, 0LL,
+            [](int i) { return static_cast<long long>(i); }, std::plus<long long>(),
+            runtime::config::parallel_alg::auto_chunk);
+        assert(sum == 100000LL * 100001LL / 2);
+    }
+    std::cout << "  ✓ Probe, estimate and chunked phases cover every index\n";
+    std::cout << "  ✓ Reduction result matches across repeated calls\n\n";
+}
+
+long long fib(runtime::ThreadPool& pool, int n) {
+    if (n < 2) return n;
+    long long a = 0, b = 0;
+    runtime::fork_join(pool,
+        [&]() { a = fib(pool, n - 1); },
+        [&]() { b = fib(pool, n - 2); });
+    return a + b;
+}
+
+void test_fork_join_recursion() {
+    std::cout << "Test 12: fork_join recursion inside and outside the pool\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 4;
+    runtime::ThreadPool pool(options);
+
+    // From a worker: forks go to that worker's own queue
+    long long inside = pool.submit_task([&]() { return fib(pool, 20); }).get();
+    assert(inside == 6765);
+
+    // From an external thread: both branches run on the caller
+    long long outside = fib(pool, 18);
+    assert(outside == 2584);
+
+    // Even when a full pool would drop anything submitted to it
+    runtime::config::ThreadPoolOptions limited;
+    limited.threads = 1;
+    limited.max_pending_tasks = 1;
+    limited.rejection_handler = [](runtime::Task) {};  // drop
+    runtime::ThreadPool full(limited);
+    std::atomic<bool> release{false};
+    full.submit([&]() {
+        while (!release.load()) std::this_thread::yield();
+    });
+    long long dropped_pool = fib(full, 15);
+    assert(dropped_pool == 610);
+    release = true;
+
+    pool.wait();
+    full.wait();
+    std::cout << "  ✓ fib(20) = " << inside << ", fib(18) = " << outside
+              << ", fib(15) = " << dropped_pool << " beside a full pool\n";
+    std::cout << "  ✓ No deadlock on nested joins\n\n";
+}
+
+void test_parallel_invoke() {
+    std::cout << "Test 13: parallel_invoke runs every function and propagates exceptions\n";
+    runtime::ThreadPool pool;
+    std::atomic<int> mask{0};
+
+    runtime::parallel_invoke(pool,
+        [&]() { mask |= 1; },
+        [&]() { mask |= 2; },
+        [&]() { mask |= 4; },
+        [&]() { mask |= 8; },
+        [&]() { mask |= 16; });
+    assert(mask == 31);
+
+    std::atomic<bool> other_ran{false};
+    bool caught = false;
+    try {
+        runtime::parallel_invoke(pool,
+            [&]() { other_ran = true; },
+            []() { throw std::runtime_error("branch failed"); });
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    assert(caught);
+    assert(other_ran);
+    std::cout << "  ✓ All five functions ran\n";
+    std::cout << "  ✓ Exception rethrown after both branches finished\n\n";
+}
+
+void test_parallel_histogram() {
+    std::cout << "Test 14: parallel_histogram counts keys into privatised bins\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 4;
+    runtime::ThreadPool pool(options);
+
+    const int n = 100000;
+    std::vector<size_t> hist = runtime::parallel_histogram(pool,
+        runtime::blocked_range<int>(0, n, 1000), 10,
+        [](int i) { return i % 12; });  // 10 and 11 fall outside the bins
+
+    size_t total = 0;
+    for (size_t b = 0; b < 10; ++b) {
+        size_t expected = n / 12 + (static_cast<int>(b) < n % 12 ? 1 : 0);
+        assert(hist[b] == expected);
+        total += hist[b];
+    }
+    assert(total < static_cast<size_t>(n));
+
+    // Private rows start on cache lines of their own, whatever the element size
+    const size_t line = runtime::config::parallel_alg::cache_line_size;
+    struct Triple { long long a, b, c; };
+    size_t stride = runtime::detail::padded_stride<Triple>(5);
+    runtime::detail::PrivateRows<Triple> rows(4 * stride);
+    assert(reinterpret_cast<uintptr_t>(rows.data()) % line == 0);
+    assert(stride >= 5 && stride * sizeof(Triple) % line == 0);
+    assert(runtime::detail::padded_stride<size_t>(10) * sizeof(size_t) % line == 0);
+    std::cout << "  ✓ Every bin matches the serial count; out-of-range keys dropped; rows line-aligned\n\n";
+}
+
+void test_parallel_group_aggregate() {
+    std::cout << "Test 15: parallel_group_aggregate folds values per group\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 3;
+    runtime::ThreadPool pool(options);
+
+    const int n = 50000;
+    std::vector<long long> sums = runtime::parallel_group_aggregate(pool,
+        runtime::blocked_range<int>(0, n, 777), 7,
+        [](int i) { return i % 7; },
+        [](int i) { return static_cast<long long>(i); },
+        0LL, std::plus<long long>());
+
+    std::vector<long long> expected(7, 0);
+    for (int i = 0; i < n; ++i) expected[i % 7] += i;
+    assert(sums == expected);
+
+    std::vector<int> maxima = runtime::parallel_group_aggregate(pool,
+        runtime::blocked_range<int>(0, n), 3,
+        [](int i) { return i % 3; },
+        [](int i) { return i; },
+        0, [](int a, int b) { return std::max(a, b); });
+    assert(maxima[0] == 49998 && maxima[1] == 49999 && maxima[2] == 49997);
+    std::cout << "  ✓ Sums and maxima per group match the serial result\n\n";
+}
+
+void test_deterministic_reduce() {
+    std::cout << "Test 16: parallel_deterministic_reduce is bitwise reproducible\n";
+    std::vector<float> values(300001);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<float>((i % 2 ? 1e8 : 1e-3) * ((i % 7) - 3.0));
+    }
+    auto value_at = [&](size_t i) { return values[i]; };
+
+    float reference = 0.0f;
+    for (size_t threads = 1; threads <= 4; ++threads) {
+        runtime::config::ThreadPoolOptions options;
+        options.threads = threads;
+        runtime::ThreadPool pool(options);
+        for (int run = 0; run < 3; ++run) {
+            float result = runtime::parallel_deterministic_reduce(pool, size_t(0), values.size(), 0.0f,
+                                                                  value_at, std::plus<float>(), 1000);
+            if (threads == 1 && run == 0) reference = result;
+            assert(result == reference);
+        }
+    }
+
+    runtime::ThreadPool pool;
+    long long sum = runtime::parallel_deterministic_reduce(pool, 0, 100000, 5LL,
+        [](int i) { return static_cast<long long>(i); }, std::plus<long long>(), 333);
+    assert(sum == 5 + 99999LL * 100000LL / 2);
+    std::cout << "  ✓ Same float result for 1-4 threads over repeated runs\n";
+    std::cout << "  ✓ init is applied exactly once\n\n";
+}
+
+void test_parallel_merge_stable() {
+    std::cout << "Test 17: parallel_merge matches std::merge and is stable\n";
+    runtime::ThreadPool pool;
+    std::mt19937 rng(17);
+
+    // (key, source) pairs compared by key only, so ties expose instability
+    using Item = std::pair<int, int>;
+    auto by_key = [](const Item& a, const Item& b) { return a.first < b.first; };
+    std::vector<Item> a(50000), b(70000);
+    for (auto& item : a) item = {static_cast<int>(rng() % 1000), 0};
+    for (auto& item : b) item = {static_cast<int>(rng() % 1000), 1};
+    std::sort(a.begin(), a.end(), by_key);
+    std::sort(b.begin(), b.end(), by_key);
+
+    std::vector<Item> expected(a.size() + b.size());
+    std::merge(a.begin(), a.end(), b.begin(), b.end(), expected.begin(), by_key);
+    std::vector<Item> merged(a.size() + b.size());
+    auto end = runtime::parallel_merge(pool, a.begin(), a.end(), b.begin(), b.end(), merged.begin(), by_key);
+
+    assert(end == merged.end());
+    assert(merged == expected);
+    std::cout << "  ✓ Output identical to std::merge, ties taken from the first range\n\n";
+}
+
+void test_parallel_stable_sort() {
+    std::cout << "Test 18: parallel_stable_sort\n";
+    runtime::ThreadPool pool;
+    std::mt19937 rng(18);
+
+    std::vector<std::pair<int, int>> items(200001);
+    for (size_t i = 0; i < items.size(); ++i) {
+        items[i] = {static_cast<int>(rng() % 5000), static_cast<int>(i)};
+    }
+    auto expected = items;
+    auto by_key = [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; };
+    std::stable_sort(expected.begin(), expected.end(), by_key);
+    runtime::parallel_stable_sort(pool, items.begin(), items.end(), by_key);
+    assert(items == expected);
+    std::cout << "  ✓ Equal keys keep their original order\n";
+
+    // Non-trivial element type exercises the move-only buffer path
+    std::vector<std::string> words(30000);
+    for (auto& w : words) w = std::to_string(rng() % 100000);
+    auto sorted_words = words;
+    std::sort(sorted_words.begin(), sorted_words.end());
+    runtime::parallel_stable_sort(pool, words.begin(), words.end());
+    assert(words == sorted_words);
+
+    std::vector<int> small = {3, 1, 2};
+    runtime::parallel_stable_sort(pool, small.begin(), small.end(), std::greater<>());
+    assert((small == std::vector<int>{3, 2, 1}));
+    std::cout << "  ✓ Strings and small inputs sort correctly\n\n";
+}
+
+void test_parallel_partition() {
+    std::cout << "Test 19: parallel_partition\n";
+    runtime::ThreadPool pool;
+
+    std::vector<int> values(123457);
+    for (size_t i = 0; i < values.size(); ++i) values[i] = static_cast<int>((i * 7919) % 100003);
+    auto expected = values;
+    auto is_even = [](int v) { return v % 2 == 0; };
+    auto expected_point = std::stable_partition(expected.begin(), expected.end(), is_even);
+
+    std::atomic<size_t> calls{0};
+    auto point = runtime::parallel_partition(pool, values.begin(), values.end(), [&](int v) {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        return is_even(v);
+    });
+
+    assert(point - values.begin() == expected_point - expected.begin());
+    assert(values == expected);
+    assert(calls.load() == values.size());
+    std::cout << "  ✓ Same result as std::stable_partition, pred called once per element\n\n";
+}
+
+void test_parallel_unique() {
+    std::cout << "Test 20: parallel_unique\n";
+    runtime::ThreadPool pool;
+
+    std::vector<int> values;
+    for (int v = 0; v < 40000; ++v) {
+        for (int r = 0; r <= v % 4; ++r) values.push_back(v / 3);
+    }
+    auto expected = values;
+    expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+
+    auto end = runtime::parallel_unique(pool, values.begin(), values.end());
+    values.erase(end, values.end());
+    assert(values == expected);
+    std::cout << "  ✓ Same result as std::unique across block boundaries\n";
+
+    // Nested inside a task: all four building blocks only fork_join
+    std::vector<int> nested(100000);
+    for (size_t i = 0; i < nested.size(); ++i) nested[i] = static_cast<int>(nested.size() - i) / 2;
+    pool.submit_task([&]() {
+        runtime::parallel_stable_sort(pool, nested.begin(), nested.end());
+        nested.erase(runtime::parallel_unique(pool, nested.begin(), nested.end()), nested.end());
+    }).get();
+    assert(nested.size() == 50001);
+    assert(std::is_sorted(nested.begin(), nested.end()));
+    std::cout << "  ✓ Sort + unique compose inside a pool task\n\n";
+}
+
+void test_parallel_for_each_iterators() {
+    std::cout << "Test 21: parallel_for_each over vector and list\n";
+    runtime::ThreadPool pool;
+
+    struct Record {
+        int id;
+        long long total;
+    };
+    std::vector<Record> records(50000);
+    for (size_t i = 0; i < records.size(); ++i) records[i] = {static_cast<int>(i), 0};
+    runtime::parallel_for_each(pool, records.begin(), records.end(), [](Record& r) {
+        r.total = static_cast<long long>(r.id) * 2;
+    }, 1000);
+    for (size_t i = 0; i < records.size(); ++i) assert(records[i].total == static_cast<long long>(i) * 2);
+    std::cout << "  ✓ Random-access range updated in place\n";
+
+    std::list<int> values;
+    for (int i = 0; i < 10007; ++i) values.push_back(i);
+    std::atomic<long long> sum{0};
+    runtime::parallel_for_each(pool, values.begin(), values.end(), [&](int& v) {
+        v += 1;
+        sum.fetch_add(v, std::memory_order_relaxed);
+    }, 100);
+    assert(sum.load() == 10007LL * 10008LL / 2);
+    int expected = 1;
+    for (int v : values) assert(v == expected++);
+    std::cout << "  ✓ std::list visited exactly once per element\n";
+
+    bool thrown = false;
+    try {
+        runtime::parallel_for_each(pool, values.begin(), values.end(), [](int v) {
+            if (v == 5000) throw std::runtime_error("bad element");
+        }, 100);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // Random-access path: the first chunk fails at once, the rest are slow
+    std::atomic<int> finished{0};
+    thrown = false;
+    try {
+        runtime::parallel_for_each(pool, records.begin(), records.begin() + 8, [&](Record& r) {
+            if (r.id == 0) throw std::runtime_error("bad record");
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            finished++;
+        }, 1);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+        assert(finished.load() == 7);  // nothing left running on a dead frame
+    }
+    assert(thrown);
+    std::cout << "  ✓ Exceptions propagate after all chunks finish, on both paths\n\n";
+}
+
+void test_parallel_transform_iterators() {
+    std::cout << "Test 22: parallel_transform over mixed iterator kinds\n";
+    runtime::ThreadPool pool;
+
+    std::vector<int> in(30000);
+    for (size_t i = 0; i < in.size(); ++i) in[i] = static_cast<int>(i);
+    std::vector<long long> out(in.size());
+    auto end = runtime::parallel_transform(pool, in.begin(), in.end(), out.begin(),
+                                           [](int v) { return static_cast<long long>(v) * v; });
+    assert(end == out.end());
+    for (size_t i = 0; i < in.size(); ++i) assert(out[i] == static_cast<long long>(i) * static_cast<long long>(i));
+    std::cout << "  ✓ vector -> vector\n";
+
+    std::list<int> list_in(in.begin(), in.end());
+    std::vector<int> negated(in.size() + 5, 0);
+    auto list_end = runtime::parallel_transform(pool, list_in.begin(), list_in.end(), negated.begin(),
+                                                [](int v) { return -v; }, 256);
+    assert(list_end == negated.begin() + static_cast<std::ptrdiff_t>(in.size()));
+    for (size_t i = 0; i < in.size(); ++i) assert(negated[i] == -static_cast<int>(i));
+    assert(negated.back() == 0);
+
+    std::list<int> list_out(in.size());
+    runtime::parallel_transform(pool, in.begin(), in.end(), list_out.begin(),
+                                [](int v) { return v + 1; }, 256);
+    int expected = 1;
+    for (int v : list_out) assert(v == expected++);
+    std::cout << "  ✓ list -> vector and vector -> list\n\n";
+}
+
+void test_execution_policy_algorithms() {
+    std::cout << "Test 23: par_pool policy overloads match std:: results\n";
+    runtime::ThreadPool pool;
+    auto par = runtime::execution::par_pool(pool, 1000);
+
+    std::vector<long long> values(100003);
+    std::iota(values.begin(), values.end(), 1);
+
+    std::vector<long long> doubled(values.size());
+    runtime::transform(par, values.begin(), values.end(), doubled.begin(), [](long long v) { return v * 2; });
+    runtime::for_each(par, doubled.begin(), doubled.end(), [](long long& v) { v += 1; });
+    for (size_t i = 0; i < values.size(); ++i) assert(doubled[i] == values[i] * 2 + 1);
+
+    std::vector<long long> sums(values.size());
+    runtime::transform(par, values.begin(), values.end(), doubled.begin(), sums.begin(),
+                       [](long long a, long long b) { return a + b; });
+    assert(sums.back() == values.back() * 3 + 1);
+    std::cout << "  ✓ for_each and unary/binary transform\n";
+
+    const long long n = static_cast<long long>(values.size());
+    long long total = runtime::reduce(par, values.begin(), values.end());
+    assert(total == n * (n + 1) / 2);
+    total = runtime::reduce(par, values.begin(), values.end(), 10LL);
+    assert(total == n * (n + 1) / 2 + 10);
+    long long largest = runtime::reduce(par, values.begin(), values.end(), 0LL,
+                                        [](long long a, long long b) { return std::max(a, b); });
+    assert(largest == n);
+    long long odd = runtime::transform_reduce(par, values.begin(), values.end(), 0LL, std::plus<>(),
+                                              [](long long v) { return v % 2; });
+    assert(odd == (n + 1) / 2);
+    long long dot = runtime::transform_reduce(par, values.begin(), values.end(), values.begin(), 0LL);
+    assert(dot == std::inner_product(values.begin(), values.end(), values.begin(), 0LL));
+
+    std::list<int> list(5000, 2);
+    int list_total = runtime::reduce(par.with_chunk_size(64), list.begin(), list.end(), 0);
+    assert(list_total == 10000);
+    std::vector<int> empty;
+    int empty_total = runtime::reduce(par, empty.begin(), empty.end(), 7);
+    assert(empty_total == 7);
+    std::cout << "  ✓ reduce / transform_reduce on vectors, lists and empty ranges\n";
+
+    std::vector<int> shuffled(50000);
+    for (size_t i = 0; i < shuffled.size(); ++i) shuffled[i] = static_cast<int>((i * 7919) % shuffled.size());
+    runtime::sort(par, shuffled.begin(), shuffled.end());
+    assert(std::is_sorted(shuffled.begin(), shuffled.end()));
+    runtime::sort(par, shuffled.begin(), shuffled.end(), std::greater<>());
+    assert(std::is_sorted(shuffled.begin(), shuffled.end(), std::greater<>()));
+    std::cout << "  ✓ sort with default and custom comparator\n\n";
+}
+
+void test_execution_policy_inclusive_scan() {
+    std::cout << "Test 24: inclusive_scan via two-pass blocked scan\n";
+    runtime::ThreadPool pool;
+    auto par = runtime::execution::par_pool(pool, 500);
+
+    std::vector<long long> values(77777);
+    for (size_t i = 0; i < values.size(); ++i) values[i] = static_cast<long long>(i % 13) - 6;
+    std::vector<long long> expected(values.size());
+    std::partial_sum(values.begin(), values.end(), expected.begin());
+
+    std::vector<long long> out(values.size());
+    auto end = runtime::inclusive_scan(par, values.begin(), values.end(), out.begin());
+    assert(end == out.end());
+    assert(out == expected);
+
+    runtime::inclusive_scan(par, values.begin(), values.end(), out.begin(), std::plus<>(), 100LL);
+    for (size_t i = 0; i < out.size(); ++i) assert(out[i] == expected[i] + 100);
+
+    // In place, non-commutative (but associative) operation
+    std::vector<std::string> letters(3000);
+    for (size_t i = 0; i < letters.size(); ++i) letters[i] = std::string(1, static_cast<char>('a' + i % 26));
+    std::vector<std::string> expected_strings(letters.size());
+    std::partial_sum(letters.begin(), letters.end(), expected_strings.begin());
+    runtime::inclusive_scan(runtime::execution::par_pool(pool, 100),
+                            letters.begin(), letters.end(), letters.begin());
+    assert(letters == expected_strings);
+    std::cout << "  ✓ Matches std::partial_sum, with init, and in place for strings\n\n";
+}
+
+void test_fan_out_on_full_pool() {
+    std::cout << "Test 25: Fan-outs from a non-worker ignore backpressure\n";
+    for (bool dropping : {false, true}) {
+        std::atomic<int> dropped{0};
+        runtime::config::ThreadPoolOptions options;
+        options.threads = 2;
+        options.max_pending_tasks = 2;
+        options.submit_timeout = std::chrono::milliseconds(0);
+        if (dropping) {
+            options.rejection_handler = [&dropped](runtime::Task) { dropped++; };
+        }
+        runtime::ThreadPool pool(options);
+
+        // Fill the pool; let it drain only once the fan-outs are queued
+        std::atomic<bool> release{false};
+        for (int i = 0; i < 2; ++i) {
+            pool.submit([&release]() {
+                while (!release.load()) std::this_thread::yield();
+            });
+        }
+        std::thread releaser([&release]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            release = true;
+        });
+
+        std::vector<std::atomic<int>> visits(10000);
+        runtime::parallel_for(pool, 0, 10000, [&visits](int i) { visits[i]++; }, 100);
+        runtime::parallel_for(pool, 0, 10000, [&visits](int i) { visits[i]++; },
+                              runtime::Schedule::Static());
+        long long sum = runtime::parallel_reduce(pool, 0, 10000, 0LL,
+            [](int i) { return static_cast<long long>(i); },
+            [](long long a, long long b) { return a + b; }, 100);
+        releaser.join();
+
+        for (auto& v : visits) assert(v.load() == 2);
+        assert(sum == 9999LL * 10000 / 2);
+        assert(dropped.load() == 0);
+    }
+    std::cout << "  ✓ parallel_for / parallel_reduce on a full pool, with and without a rejection handler\n\n";
+}
+
+int main() {
+    std::cout << "=== Parallel Algorithms Tests ===\n\n";
+
+    test_blocked_range_split();
+    test_blocked_range2d_longest_dimension();
+    test_parallel_for_2d_tiles();
+    test_parallel_for_3d_tiles();
+    test_parallel_for_chunked_alignment();
+    test_parallel_reduce_chunked();
+    test_affinity_partitioner_replay();
+    test_affinity_partitioner_single_worker_hits();
+    test_parallel_for_schedules();
+    test_static_schedule_one_block_per_worker();
+    test_auto_chunk();
+    test_fork_join_recursion();
+    test_parallel_invoke();
+    test_parallel_histogram();
+    test_parallel_group_aggregate();
+    test_deterministic_reduce();
+    test_parallel_merge_stable();
+    test_parallel_stable_sort();
+    test_parallel_partition();
+    test_parallel_unique();
+    test_parallel_for_each_iterators();
+    test_parallel_transform_iterators();
+    test_execution_policy_algorithms();
+    test_execution_policy_inclusive_scan();
+    test_fan_out_on_full_pool();
+
+    std::cout << "All parallel algorithm tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,256 @@
+#include <runtime/thread_pool.h>
+#include <runtime/shared_queue.h>
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <cassert>
+#include <csignal>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+std::string queue_name(const char* test) {
+    return "/runtime_shared_queue_test_" + std::string(test) + "_" + std::to_string(getpid());
+}
+
+// Counters every process sees: anonymous shared memory mapped before fork()
+template<typename T>
+T* shared_array(size_t n) {
+    void* memory = mmap(nullptr, n * sizeof(T), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    assert(memory != MAP_FAILED);
+    T* array = static_cast<T*>(memory);
+    for (size_t i = 0; i < n; ++i) new (&array[i]) T(0);
+    return array;
+}
+
+void test_processes_share_work() {
+    std::cout << "Test 1: Child processes drain one queue, each task runs once\n";
+    const int items = 5000;
+    const int children = 3;
+    runtime::SharedTaskQueue queue(queue_name("share"), runtime::SharedTaskQueue::Mode::Create, 256);
+    auto* runs = shared_array<std::atomic<int>>(items);
+    auto* per_child = shared_array<std::atomic<int>>(children);
+    auto* done = shared_array<std::atomic<int>>(1);
+
+    std::vector<pid_t> pids;
+    for (int c = 0; c < children; ++c) {
+        pid_t child = fork();
+        if (child == 0) {
+            runtime::SharedTaskQueue mine(queue.name(), runtime::SharedTaskQueue::Mode::Open);
+            runtime::SharedTaskRegistry registry;
+            registry.add<int>(1, [&](int i) {
+                runs[i]++;
+                per_child[c]++;
+            });
+            runtime::config::ThreadPoolOptions options;
+            options.threads = 2;
+            runtime::ThreadPool pool(options);
+            runtime::attach_shared_queue(pool, mine, registry);
+            while (done->load() == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            pool.wait();
+            _exit(0);
+        }
+        pids.push_back(child);
+    }
+
+    for (int i = 0; i < items; ++i) {
+        while (!queue.try_push(1, i)) {
+            std::this_thread::yield();  // ring full: let the children catch up
+        }
+    }
+    auto total = [&]() {
+        int sum = 0;
+        for (int c = 0; c < children; ++c) sum += per_child[c].load();
+        return sum;
+    };
+    while (total() < items) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    done->store(1);
+    for (pid_t pid : pids) {
+        int status = 0;
+        waitpid(pid, &status, 0);
+        assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    for (int i = 0; i < items; ++i) assert(runs[i].load() == 1);
+    assert(queue.size_approx() == 0);
+    assert(queue.recovered() == 0);
+    std::cout << "  ✓ " << items << " tasks through a 256-slot ring; per child:";
+    for (int c = 0; c < children; ++c) std::cout << " " << per_child[c].load();
+    std::cout << "\n\n";
+}
+
+// Fork a child that runs body() against the inherited mapping, wait until
+// it signals through a pipe that it is mid-operation, then SIGKILL it
+void kill_mid_operation(const std::function<void(int signal_fd)>& body) {
+    int fds[2];
+    int piped = pipe(fds);
+    assert(piped == 0);
+    pid_t child = fork();
+    if (child == 0) {
+        close(fds[0]);
+        body(fds[1]);
+        _exit(0);  // not reached
+    }
+    close(fds[1]);
+    char byte = 0;
+    ssize_t signalled = read(fds[0], &byte, 1);
+    assert(signalled == 1);
+    close(fds[0]);
+    kill(child, SIGKILL);
+    int status = 0;
+    waitpid(child, &status, 0);  // reaped: kill(pid, 0) now reports it gone
+    assert(WIFSIGNALED(status));
+}
+
+void test_dead_writer() {
+    std::cout << "Test 2: A writer killed mid-push does not stall the ring\n";
+    runtime::SharedTaskQueue queue(queue_name("writer"), runtime::SharedTaskQueue::Mode::Create, 8);
+
+    kill_mid_operation([&](int signal_fd) {
+        queue.try_push_with(1, [&](void*, size_t) -> size_t {
+            (void)!write(signal_fd, "w", 1);
+            pause();
+            return 0;
+        });
+    });
+
+    bool pushed = queue.try_push(1, 42);
+    assert(pushed);
+    int value = 0;
+    bool popped = queue.try_pop_with([&](uint32_t id, const void* payload, size_t size) {
+        assert(id == 1 && size == sizeof(int));
+        std::memcpy(&value, payload, sizeof(int));
+    });
+    assert(popped);
+    assert(value == 42);
+    assert(queue.recovered() == 1);
+    popped = queue.try_pop_with([](uint32_t, const void*, size_t) {});
+    assert(!popped);
+    std::cout << "  ✓ Half-written slot discarded, next task delivered\n\n";
+}
+
+void test_dead_reader() {
+    std::cout << "Test 3: A slot held by a killed reader is reclaimed\n";
+    runtime::SharedTaskQueue queue(queue_name("reader"), runtime::SharedTaskQueue::Mode::Create, 4);
+    bool pushed = queue.try_push(1, 0);
+    assert(pushed);
+
+    kill_mid_operation([&](int signal_fd) {
+        queue.try_pop_with([&](uint32_t, const void*, size_t) {
+            (void)!write(signal_fd, "r", 1);
+            pause();
+        });
+    });
+
+    // All four slots are usable again, including the one the reader held
+    for (int i = 1; i <= 4; ++i) {
+        pushed = queue.try_push(1, i);
+        assert(pushed);
+    }
+    pushed = queue.try_push(1, 5);
+    assert(!pushed);
+    assert(queue.recovered() == 1);
+    for (int i = 1; i <= 4; ++i) {
+        int value = 0;
+        bool popped = queue.try_pop_with([&](uint32_t, const void* payload, size_t) {
+            std::memcpy(&value, payload, sizeof(int));
+        });
+        assert(popped);
+        assert(value == i);
+    }
+    std::cout << "  ✓ Ring refilled to capacity after recovery\n\n";
+}
+
+struct Point {
+    int x;
+    int y;
+};
+
+void test_registry_and_pool() {
+    std::cout << "Test 4: Registry dispatch into an attached pool\n";
+    runtime::SharedTaskQueue queue(queue_name("registry"), runtime::SharedTaskQueue::Mode::Create, 64);
+    runtime::SharedTaskRegistry registry;
+    std::atomic<long long> sum{0};
+    std::atomic<int> ran{0};
+    registry.add<Point>(1, [&](Point p) {
+        sum += p.x * p.y;
+        ran++;
+    });
+    registry.add(2, [&](const void* payload, size_t size) {
+        sum += static_cast<long long>(std::string(static_cast<const char*>(payload), size).size());
+        ran++;
+    });
+
+    bool thrown = false;
+    try {
+        registry.add<int>(0, [](int) {});
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    for (int i = 0; i < 30; ++i) {
+        bool pushed = queue.try_push(1, Point{i, 2});
+        assert(pushed);
+    }
+    bool pushed = queue.try_push(2, "hello", 5);
+    assert(pushed);
+    pushed = queue.try_push(99, Point{0, 0});  // nobody here registered 99
+    assert(pushed);
+
+    // A producer whose serialiser throws leaves a skipped slot behind
+    thrown = false;
+    try {
+        queue.try_push_with(1, [](void*, size_t) -> size_t { throw std::runtime_error("bad"); });
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    {
+        runtime::config::ThreadPoolOptions options;
+        options.threads = 2;
+        runtime::ThreadPool pool(options);
+        runtime::attach_shared_queue(pool, queue, registry);
+        while (ran.load() < 31) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        pool.wait();
+        assert(pool.stats().external_tasks.load() == 31);
+    }
+
+    assert(sum.load() == 2 * (29 * 30 / 2) + 5);
+    // 99 stays at the head, the skipped slot behind it
+    assert(queue.size_approx() == 2);
+    uint32_t left = 0;
+    bool popped = queue.try_pop_with([&](uint32_t id, const void*, size_t) { left = id; });
+    assert(popped);
+    assert(left == 99);
+    popped = queue.try_pop_with([](uint32_t, const void*, size_t) {});
+    assert(!popped);
+    std::cout << "  ✓ 31 tasks ran in the pool; unknown id 99 left in place\n\n";
+}
+
+int main() {
+    std::cout << "=== Shared Queue Tests ===\n\n";
+
+    // These fork: run them while this process has no other threads
+    test_processes_share_work();
+    test_dead_writer();
+    test_dead_reader();
+    test_registry_and_pool();
+
+    std::cout << "All shared queue tests passed!\n";
+    return 0;
+}
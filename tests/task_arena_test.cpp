@@ -0,0 +1,223 @@
+#include <runtime/thread_pool.h>
+#include <runtime/task_arena.h>
+#include <runtime/fiber.h>
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <new>
+#include <cassert>
+
+bool aligned(const void* p, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+}
+
+void test_bump_allocation() {
+    std::cout << "Test 1: Bump allocation, alignment and reset\n";
+    runtime::TaskArena arena(4096);
+
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(8, 8);
+    void* c = arena.allocate(100, 64);
+    assert(aligned(b, 8) && aligned(c, 64));
+    assert(static_cast<char*>(b) >= static_cast<char*>(a) + 3);
+    assert(static_cast<char*>(c) >= static_cast<char*>(b) + 8);
+    assert(arena.used() >= 111 && arena.used() <= 4096);
+
+    // The newest block is given back, older ones stay until reset
+    size_t before = arena.used();
+    void* d = arena.allocate(256);
+    arena.deallocate(d, 256);
+    assert(arena.used() == before);
+    arena.deallocate(a, 3, 1);
+    assert(arena.used() == before);
+
+    arena.reset();
+    assert(arena.used() == 0);
+    void* again = arena.allocate(3, 1);
+    assert(again == a);  // same memory again
+    assert(arena.high_water() >= before + 256);
+    std::cout << "  ✓ Aligned bump allocations; reset reuses the same memory\n\n";
+}
+
+void test_heap_fallback() {
+    std::cout << "Test 2: Exhausted arenas fall back to the heap\n";
+    std::atomic<uint64_t> fallbacks{0};
+    runtime::TaskArena arena(1024, &fallbacks);
+
+    char* inside = arena.allocate_array<char>(1000);
+    std::memset(inside, 1, 1000);
+    char* big = arena.allocate_array<char>(4096);
+    std::memset(big, 2, 4096);
+    auto* wide = static_cast<char*>(arena.allocate(64, 256));
+    assert(aligned(wide, 256));
+    assert(fallbacks.load() == 2);
+    assert(arena.heap_blocks() == 2);
+
+    arena.deallocate(big, 4096);
+    assert(arena.heap_blocks() == 1);
+    arena.reset();  // frees the other one
+    assert(arena.heap_blocks() == 0);
+
+    // Capacity 0: everything is a heap block
+    runtime::TaskArena heap_only(0);
+    std::pmr::vector<int> values(&heap_only);
+    for (int i = 0; i < 1000; ++i) values.push_back(i);
+    assert(values[999] == 999);
+    assert(heap_only.used() == 0 && heap_only.heap_blocks() == 1);
+
+    // Sizes near SIZE_MAX must not wrap into a small bump or heap block
+    runtime::TaskArena small(1024);
+    for (size_t bytes : {SIZE_MAX, SIZE_MAX - 8}) {
+        bool refused = false;
+        try {
+            (void)small.allocate(bytes, 8);
+        } catch (const std::bad_alloc&) {
+            refused = true;
+        }
+        assert(refused);
+    }
+    assert(small.used() == 0 && small.heap_blocks() == 0);
+    std::cout << "  ✓ Oversized and over-capacity requests served by the heap and freed\n";
+    std::cout << "  ✓ Sizes that would overflow are refused with bad_alloc\n\n";
+}
+
+void test_reset_after_each_task() {
+    std::cout << "Test 3: Workers reset their arena after every task\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 2;
+    options.task_arena_size = 64 * 1024;
+    runtime::ThreadPool pool(options);
+
+    const int tasks = 1000;
+    std::atomic<int> started_empty{0};
+    std::atomic<int> correct{0};
+    for (int t = 0; t < tasks; ++t) {
+        pool.submit([&started_empty, &correct, t]() {
+            runtime::TaskArena& arena = runtime::task_arena();
+            if (arena.used() == 0) started_empty++;
+            // 32 KiB per task: without resets the arena would be full after two
+            std::pmr::vector<int> scratch(runtime::task_resource());
+            scratch.reserve(8 * 1024);
+            for (int i = 0; i < 8 * 1024; ++i) scratch.push_back(i + t);
+            std::pmr::string text("task ", runtime::task_resource());
+            text += std::to_string(t);
+            if (scratch[100] == 100 + t && text.compare(("task " + std::to_string(t)).c_str()) == 0) correct++;
+        });
+    }
+    pool.wait();
+    assert(started_empty.load() == tasks);
+    assert(correct.load() == tasks);
+    assert(pool.stats().arena_fallbacks.load() == 0);
+    std::cout << "  ✓ " << tasks << " tasks, each started on an empty arena, no heap fallbacks\n\n";
+}
+
+void test_nested_tasks_keep_outer_memory() {
+    std::cout << "Test 4: Tasks run inside a task do not reset its memory\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 1;
+    runtime::ThreadPool pool(options);
+
+    std::atomic<bool> intact{false};
+    std::atomic<int> inner_ran{0};
+    pool.submit([&pool, &intact, &inner_ran]() {
+        char* mine = runtime::task_arena().allocate_array<char>(512);
+        std::memset(mine, 0x5a, 512);
+        for (int i = 0; i < 8; ++i) {
+            pool.submit_local([&inner_ran]() {
+                char* theirs = runtime::task_arena().allocate_array<char>(512);
+                std::memset(theirs, 0x11, 512);
+                inner_ran++;
+            });
+        }
+        while (pool.run_pending_task()) {
+        }
+        bool ok = true;
+        for (int i = 0; i < 512; ++i) ok = ok && mine[i] == 0x5a;
+        intact = ok;
+    });
+    pool.wait();
+    assert(inner_ran.load() == 8);
+    assert(intact.load());
+    std::cout << "  ✓ Outer task's scratch survives 8 nested tasks\n\n";
+}
+
+void test_fallback_in_pool() {
+    std::cout << "Test 5: Small arenas spill to the heap; non-workers use the heap\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 2;
+    options.task_arena_size = 1024;
+    runtime::ThreadPool pool(options);
+
+    std::atomic<int> correct{0};
+    for (int t = 0; t < 100; ++t) {
+        pool.submit([&correct]() {
+            std::pmr::vector<uint64_t> values(runtime::task_resource());
+            for (uint64_t i = 0; i < 2000; ++i) values.push_back(i * i);
+            if (values[1999] == 1999ull * 1999ull) correct++;
+        });
+    }
+    pool.wait();
+    assert(correct.load() == 100);
+    assert(pool.stats().arena_fallbacks.load() > 0);
+
+    // Not a worker: capacity 0, never reset behind the caller's back
+    runtime::TaskArena& mine = runtime::task_arena();
+    assert(mine.capacity() == 0);
+    void* p = mine.allocate(128);
+    pool.submit([]() {});
+    pool.wait();
+    assert(mine.heap_blocks() == 1);
+    mine.deallocate(p, 128);
+    assert(mine.heap_blocks() == 0);
+    std::cout << "  ✓ " << pool.stats().arena_fallbacks.load() << " heap fallbacks, results correct\n\n";
+}
+
+void test_fiber_memory_survives_suspend() {
+    std::cout << "Test 6: A fiber's scratch survives suspending while the worker runs on\n";
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 1;
+    runtime::ThreadPool pool(options);
+
+    std::atomic<bool> intact{false};
+    std::atomic<int> others_ran{0};
+    runtime::submit_fiber(pool, [&pool, &intact, &others_ran]() {
+        std::pmr::vector<char> mine(4096, 0x5a, runtime::task_resource());
+        for (int round = 0; round < 4; ++round) {
+            // Queued behind us on the only worker, each resetting its arena
+            for (int i = 0; i < 8; ++i) {
+                pool.submit([&others_ran]() {
+                    char* theirs = runtime::task_arena().allocate_array<char>(4096);
+                    std::memset(theirs, 0x11, 4096);
+                    others_ran++;
+                });
+            }
+            runtime::this_fiber::yield();
+        }
+        bool ok = true;
+        for (char c : mine) ok = ok && c == 0x5a;
+        intact = ok;
+    });
+    pool.wait();
+    assert(others_ran.load() == 32);
+    assert(intact.load());
+    std::cout << "  ✓ Buffer intact after 4 suspensions around 32 other tasks\n\n";
+}
+
+int main() {
+    std::cout << "=== Task Arena Tests ===\n\n";
+
+    test_bump_allocation();
+    test_heap_fallback();
+    test_reset_after_each_task();
+    test_nested_tasks_keep_outer_memory();
+    test_fallback_in_pool();
+    test_fiber_memory_survives_suspend();
+
+    std::cout << "All task arena tests passed!\n";
+    return 0;
+}
@@ -7,6 +7,12 @@
 #include <thread>
 #include <cmath>
 #include <cassert>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <set>
+#include <mutex>
 
 using namespace std::literals;
 
@@ -536,9 +542,288 @@ void test_future_wait_patterns() {
     print_success("Future is ready, result: " + std::to_string(future.get()));
 }
 
+// ============================================================================
+// Test 17: try_submit Fails Fast on a Full Pool
+// ============================================================================
+void test_try_submit_backpressure() {
+    print_test("Test 17: try_submit With max_pending_tasks");
+
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 2;
+    options.max_pending_tasks = 4;
+    runtime::ThreadPool pool(options);
+    assert(pool.max_pending_tasks() == 4);
+
+    std::atomic<bool> release{false};
+    std::atomic<int> ran{0};
+    for (int i = 0; i < 4; ++i) {
+        bool queued = pool.try_submit([&]() {
+            while (!release.load()) std::this_thread::yield();
+            ran++;
+        });
+        assert(queued);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    bool accepted = pool.try_submit([&ran]() { ran++; });
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    assert(!accepted);
+    assert(elapsed < 50ms);
+    assert(pool.stats().tasks_rejected.load() == 1);
+
+    release = true;
+    pool.wait();
+    accepted = pool.try_submit([&ran]() { ran++; });
+    assert(accepted);
+    pool.wait();
+    assert(ran.load() == 5);
+    print_success("Full pool refused at once; room again after tasks drained");
+}
+
+// ============================================================================
+// Test 18: submit Blocks the Producer Until Tasks Drain
+// ============================================================================
+void test_blocking_submit() {
+    print_test("Test 18: Blocking submit Bounds Pending Tasks");
+
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 2;
+    options.max_pending_tasks = 8;
+    runtime::ThreadPool pool(options);
+
+    std::atomic<int> finished{0};
+    int max_pending_seen = 0;
+    std::vector<std::thread> producers;
+    std::atomic<int> submitted{0};
+    for (int p = 0; p < 3; ++p) {
+        producers.emplace_back([&]() {
+            for (int i = 0; i < 300; ++i) {
+                pool.submit([&finished]() {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                    finished++;
+                });
+                submitted++;
+            }
+        });
+    }
+    // Submitted-but-unfinished can never exceed the cap
+    while (submitted.load() < 900) {
+        int pending = submitted.load() - finished.load();
+        max_pending_seen = std::max(max_pending_seen, pending);
+        std::this_thread::yield();
+    }
+    for (auto& t : producers) t.join();
+    pool.wait();
+
+    assert(finished.load() == 900);
+    assert(max_pending_seen <= 8);
+    assert(pool.stats().producer_waits.load() > 0);
+    assert(pool.stats().tasks_rejected.load() == 0);
+    print_success("900 tasks from 3 producers, at most " + std::to_string(max_pending_seen) +
+                  " pending (cap 8), " + std::to_string(pool.stats().producer_waits.load()) +
+                  " producer waits");
+}
+
+// ============================================================================
+// Test 19: Timeouts and the Rejection Handler
+// ============================================================================
+void test_rejection_policy() {
+    print_test("Test 19: Submit Timeout and Rejection Handler");
+
+    std::atomic<bool> release{false};
+    auto blocker = [&release]() {
+        while (!release.load()) std::this_thread::yield();
+    };
+
+    // Caller-runs policy via the handler
+    std::atomic<int> ran_by_caller{0};
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 1;
+    options.max_pending_tasks = 1;
+    options.submit_timeout = 20ms;
+    options.rejection_handler = [&ran_by_caller](runtime::Task task) {
+        task();
+        ran_by_caller++;
+    };
+    {
+        runtime::ThreadPool pool(options);
+        pool.submit(blocker);
+        auto start = std::chrono::steady_clock::now();
+        bool ran_here = false;
+        pool.submit([&ran_here]() { ran_here = true; });
+        assert(std::chrono::steady_clock::now() - start >= 20ms);
+        assert(ran_here);
+        assert(ran_by_caller.load() == 1);
+
+        // submit_for: explicit timeout, no handler involved
+        bool queued = pool.submit_for([]() {}, 10ms);
+        assert(!queued);
+        assert(ran_by_caller.load() == 1);
+        release = true;
+        queued = pool.submit_for([]() {}, runtime::config::backpressure::wait_forever);
+        assert(queued);
+        pool.wait();
+    }
+
+    // Without a handler the producer gets TaskRejectedError
+    release = false;
+    options.rejection_handler = nullptr;
+    runtime::ThreadPool pool(options);
+    pool.submit(blocker);
+    bool thrown = false;
+    try {
+        pool.submit([]() {});
+    } catch (const runtime::TaskRejectedError&) {
+        thrown = true;
+    }
+    assert(thrown);
+    release = true;
+    pool.wait();
+    print_success("Timed-out submits reach the handler, or throw TaskRejectedError");
+}
+
+// ============================================================================
+// Test 20: Workers Bypass the Cap; Shutdown Releases Parked Producers
+// ============================================================================
+void test_backpressure_nesting_and_shutdown() {
+    print_test("Test 20: Nested Submits and Shutdown Under Backpressure");
+
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 1;
+    options.max_pending_tasks = 1;
+    std::atomic<int> ran{0};
+    {
+        runtime::ThreadPool pool(options);
+        // The only worker fills the pool and then submits more from inside
+        pool.submit([&]() {
+            for (int i = 0; i < 10; ++i) {
+                pool.submit([&ran]() { ran++; });
+            }
+        });
+        pool.wait();
+        assert(ran.load() == 10);
+    }
+    print_success("Tasks submitted by a worker are never held back (no deadlock)");
+
+    std::atomic<bool> release{false};
+    std::atomic<bool> producer_threw{false};
+    auto pool = std::make_unique<runtime::ThreadPool>(options);
+    pool->submit([&release]() {
+        while (!release.load()) std::this_thread::yield();
+    });
+    std::thread producer([&]() {
+        try {
+            pool->submit([]() {});  // parks: the pool is full
+        } catch (const std::runtime_error&) {
+            producer_threw = true;
+        }
+    });
+    std::this_thread::sleep_for(20ms);
+    std::thread stopper([&]() { pool->shutdown(); });
+    std::this_thread::sleep_for(20ms);
+    release = true;
+    producer.join();
+    stopper.join();
+    assert(producer_threw.load());
+    print_success("shutdown() wakes a parked producer, which gets an exception");
+}
+
+// ============================================================================
+// Test 21: Every Idle Strategy Runs Work and Shuts Down
+// ============================================================================
+void test_idle_strategies() {
+    print_test("Test 21: Idle Strategies");
+
+    using runtime::config::IdleStrategy;
+    const std::pair<IdleStrategy, const char*> strategies[] = {
+        {IdleStrategy::BusySpin, "BusySpin"},
+        {IdleStrategy::SpinThenYield, "SpinThenYield"},
+        {IdleStrategy::SpinThenPark, "SpinThenPark"},
+        {IdleStrategy::ParkImmediately, "ParkImmediately"},
+    };
+    for (const auto& [strategy, name] : strategies) {
+        runtime::config::ThreadPoolOptions options;
+        options.threads = 2;
+        options.idle_strategy = strategy;
+        options.idle_spins = 16;
+        runtime::ThreadPool pool(options);
+        assert(pool.idle_strategy() == strategy);
+
+        std::atomic<int> ran{0};
+        // Bursts separated by gaps, so workers go idle in between
+        for (int burst = 0; burst < 5; ++burst) {
+            for (int i = 0; i < 200; ++i) {
+                pool.submit([&ran]() { ran++; });
+            }
+            pool.wait();
+            std::this_thread::sleep_for(5ms);
+        }
+        assert(ran.load() == 1000);
+
+        uint64_t parks = pool.stats().worker_parks.load();
+        if (strategy == IdleStrategy::BusySpin || strategy == IdleStrategy::SpinThenYield) {
+            assert(parks == 0);
+        } else {
+            assert(parks > 0);
+        }
+        print_success(std::string(name) + ": 1000 tasks, " + std::to_string(parks) + " parks, " +
+                      std::to_string(pool.stats().spin_hits.load()) + " spin hits");
+    }
+}
+
 // ============================================================================
 // Main Test Runner
 // ============================================================================
+void test_targeted_wakeup() {
+    print_test("Test 22: Targeted Wakeup");
+
+    runtime::config::ThreadPoolOptions options;
+    options.threads = 4;
+    options.idle_strategy = runtime::config::IdleStrategy::ParkImmediately;
+    options.idle_sleep = 200ms;  // long enough that only submitters wake workers
+    runtime::ThreadPool pool(options);
+    std::this_thread::sleep_for(20ms);
+
+    // One task into a sleeping pool wakes at most one worker
+    std::atomic<int> ran{0};
+    for (int i = 0; i < 50; ++i) {
+        pool.submit([&ran]() { ran++; });
+        pool.wait();
+        std::this_thread::sleep_for(1ms);
+    }
+    assert(ran.load() == 50);
+    uint64_t single = pool.stats().worker_wakeups.load();
+    assert(single > 0 && single <= 50);
+    print_success("50 single tasks: " + std::to_string(single) + " wakeups");
+
+    // A pinned task wakes its own worker, not whoever sleeps on top
+    std::this_thread::sleep_for(20ms);
+    auto start = std::chrono::steady_clock::now();
+    size_t where = pool.thread_count();
+    pool.submit_pinned(pool.thread_count() - 1, [&]() { where = pool.current_worker(); });
+    pool.wait();
+    assert(where == pool.thread_count() - 1);
+    assert(std::chrono::steady_clock::now() - start < 100ms);
+    print_success("Pinned task woke its worker");
+
+    // A batch into a sleeping pool brings every worker in
+    std::this_thread::sleep_for(20ms);
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::vector<runtime::Task> batch;
+    for (int i = 0; i < 64; ++i) {
+        batch.emplace_back([&]() {
+            std::this_thread::sleep_for(1ms);
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.insert(std::this_thread::get_id());
+        });
+    }
+    pool.submit_batch(batch);
+    pool.wait();
+    assert(threads.size() == pool.thread_count());
+    print_success("Batch of 64 ran on all " + std::to_string(threads.size()) + " workers");
+}
+
 int main() {
     std::cout << "\n";
     std::cout << "╔════════════════════════════════════════════════════════════╗\n";
@@ -564,6 +849,12 @@ int main() {
         test_future_exceptions();
         test_complex_return_types();
         test_future_wait_patterns();
+        test_try_submit_backpressure();
+        test_blocking_submit();
+        test_rejection_policy();
+        test_backpressure_nesting_and_shutdown();
+        test_idle_strategies();
+        test_targeted_wakeup();
         
         std::cout << "\n";
         std::cout << GREEN << "╔════════════════════════════════════════════════════════════╗\n";
@@ -0,0 +1,208 @@
+#include <runtime/thread_pool.h>
+#include <runtime/timer_wheel.h>
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <mutex>
+#include <random>
+#include <cassert>
+
+using Clock = std::chrono::steady_clock;
+using namespace std::chrono_literals;
+
+// Poll until pred holds or the timeout passes
+template<typename Pred>
+bool eventually(Pred&& pred, std::chrono::milliseconds timeout = 5000ms) {
+    auto deadline = Clock::now() + timeout;
+    while (!pred()) {
+        if (Clock::now() > deadline) return false;
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+void test_schedule_after_never_early() {
+    std::cout << "Test 1: schedule_after / schedule_at never fire early\n";
+    runtime::ThreadPool pool;
+    std::mutex mutex;
+    std::vector<std::pair<Clock::time_point, Clock::time_point>> fired;  // (deadline, ran at)
+
+    for (int delay_ms : {0, 1, 5, 20, 50, 300, 700}) {
+        auto deadline = Clock::now() + std::chrono::milliseconds(delay_ms);
+        pool.schedule_at(deadline, [&mutex, &fired, deadline]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            fired.emplace_back(deadline, Clock::now());
+        });
+    }
+    auto start = Clock::now();
+    pool.schedule_after(30ms, [&mutex, &fired, start]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        fired.emplace_back(start + 30ms, Clock::now());
+    });
+
+    bool all_fired = eventually([&]() { std::lock_guard<std::mutex> lock(mutex); return fired.size() == 8; });
+    assert(all_fired);
+    for (const auto& f : fired) {
+        assert(f.second >= f.first);
+    }
+    assert(pool.pending_timers() == 0);
+    std::cout << "  ✓ 8 timers (incl. past level 0 of the wheel) ran at or after their deadline\n\n";
+}
+
+void test_cancel() {
+    std::cout << "Test 2: cancel before and after firing\n";
+    runtime::ThreadPool pool;
+    std::atomic<int> ran{0};
+
+    auto cancelled = pool.schedule_after(100ms, [&ran]() { ran += 100; });
+    auto far = pool.schedule_after(std::chrono::hours(2), [&ran]() { ran += 1000; });
+    auto fires = pool.schedule_after(5ms, [&ran]() { ran += 1; });
+    assert(pool.pending_timers() == 3);
+
+    bool cancelled_now = pool.cancel_timer(cancelled);
+    assert(cancelled_now);
+    cancelled_now = pool.cancel_timer(cancelled);
+    assert(!cancelled_now);
+    cancelled_now = pool.cancel_timer(far);
+    assert(cancelled_now);
+
+    bool fired = eventually([&]() { return ran.load() == 1; });
+    assert(fired);
+    cancelled_now = pool.cancel_timer(fires);
+    assert(!cancelled_now);
+    cancelled_now = pool.cancel_timer(runtime::TimerHandle{});
+    assert(!cancelled_now);
+
+    std::this_thread::sleep_for(150ms);
+    assert(ran.load() == 1);
+    assert(pool.pending_timers() == 0);
+    std::cout << "  ✓ Cancelled timers never run; stale handles are rejected\n\n";
+}
+
+void test_schedule_every() {
+    std::cout << "Test 3: schedule_every fires periodically until cancelled\n";
+    runtime::ThreadPool pool;
+    std::atomic<int> ticks{0};
+
+    auto start = Clock::now();
+    auto handle = pool.schedule_every(10ms, [&ticks]() { ticks++; });
+    bool ticked = eventually([&]() { return ticks.load() >= 5; });
+    assert(ticked);
+    assert(Clock::now() - start >= 50ms);
+
+    bool cancelled = pool.cancel_timer(handle);
+    assert(cancelled);
+    pool.wait();
+    int after_cancel = ticks.load();
+    std::this_thread::sleep_for(50ms);
+    assert(ticks.load() == after_cancel);
+    assert(pool.pending_timers() == 0);
+    std::cout << "  ✓ Fired " << after_cancel << " times, then stopped after cancel\n\n";
+}
+
+void test_many_timers() {
+    std::cout << "Test 4: 100k timers with random deadlines, half cancelled\n";
+    runtime::ThreadPool pool;
+    std::atomic<int> ran{0};
+    std::atomic<int> early{0};
+    std::mt19937 rng(64);
+
+    const int n = 100000;
+    std::vector<runtime::TimerHandle> handles;
+    handles.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        auto deadline = Clock::now() + std::chrono::milliseconds(rng() % 400);
+        handles.push_back(pool.schedule_at(deadline, [&ran, &early, deadline]() {
+            if (Clock::now() < deadline) early++;
+            ran++;
+        }));
+    }
+
+    int cancelled = 0;
+    for (int i = 0; i < n; i += 2) {
+        if (pool.cancel_timer(handles[i])) cancelled++;
+    }
+
+    bool drained = eventually([&]() { return pool.pending_timers() == 0; });
+    assert(drained);
+    pool.wait();
+    assert(ran.load() + cancelled == n);
+    assert(early.load() == 0);
+    assert(pool.stats().timers_fired.load() == static_cast<uint64_t>(ran.load()));
+    std::cout << "  ✓ " << ran.load() << " ran, " << cancelled << " cancelled, none early\n\n";
+}
+
+void test_wheel_batches_and_stop() {
+    std::cout << "Test 5: TimerWheel delivers same-tick timers as one batch\n";
+    std::mutex mutex;
+    std::vector<size_t> batch_sizes;
+    runtime::TimerWheel wheel([&](std::vector<runtime::Task>& batch) {
+        for (auto& task : batch) task();
+        std::lock_guard<std::mutex> lock(mutex);
+        batch_sizes.push_back(batch.size());
+    });
+
+    std::atomic<int> ran{0};
+    auto deadline = Clock::now() + 20ms;
+    for (int i = 0; i < 1000; ++i) {
+        wheel.schedule_at(deadline, [&ran]() { ran++; });
+    }
+    bool all_ran = eventually([&]() { return ran.load() == 1000; });
+    assert(all_ran);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        assert(batch_sizes.size() == 1 && batch_sizes[0] == 1000);
+    }
+    std::cout << "  ✓ 1000 timers on one tick -> one dispatch\n";
+
+    wheel.schedule_at(Clock::now() + 10s, []() {});
+    assert(wheel.pending() == 1);
+    wheel.stop();
+    assert(wheel.pending() == 0);
+    bool thrown = false;
+    try {
+        wheel.schedule_at(Clock::now(), []() {});
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "  ✓ stop() drops pending timers and rejects new ones\n\n";
+}
+
+void test_shutdown_with_pending_timers() {
+    std::cout << "Test 6: shutdown discards pending timers\n";
+    std::atomic<int> ran{0};
+    {
+        runtime::ThreadPool pool;
+        pool.schedule_after(200ms, [&ran]() { ran++; });
+        pool.schedule_every(1ms, [&ran]() { ran += 0; });
+        pool.shutdown();
+
+        bool thrown = false;
+        try {
+            pool.schedule_after(1ms, []() {});
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    std::this_thread::sleep_for(250ms);
+    assert(ran.load() == 0);
+    std::cout << "  ✓ No timer ran after shutdown; scheduling afterwards throws\n\n";
+}
+
+int main() {
+    std::cout << "=== Timer Tests ===\n\n";
+
+    test_schedule_after_never_early();
+    test_cancel();
+    test_schedule_every();
+    test_many_timers();
+    test_wheel_batches_and_stop();
+    test_shutdown_with_pending_timers();
+
+    std::cout << "All timer tests passed!\n";
+    return 0;
+}